@@ -40,6 +40,11 @@ bool ECSModule::IsRequired() const {
     return true;
 }
 
+ModuleAccess ECSModule::GetAccess() const {
+    // Owns the registry; systems iterate it, the module itself does no per-frame work
+    return {};
+}
+
 ECSWorld *ECSModule::GetECS() {
     return ecsWorld.get();
 }
\ No newline at end of file
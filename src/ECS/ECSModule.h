@@ -23,6 +23,8 @@ public:
 
     bool IsRequired() const override;
 
+    ModuleAccess GetAccess() const override;
+
     /// @}
 
     ECSWorld *GetECS();
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <entt/entt.hpp>
+
+#include "core/JobSystem.h"
+
+/**
+ * @brief Runs @p func(entity, Owned&...) over an owning group, split into ParallelFor slices
+ *
+ * Owned pools differ in size (the transform pool also holds cameras and lights), so each
+ * one is addressed from its own end, the same way EnTT's group iterator does it.
+ */
+template<typename... Owned, typename Group, typename Func>
+void ParallelOwnedEach(JobSystem &jobs, const Group &group, Func &&func, size_t grain) {
+    const auto length = static_cast<std::ptrdiff_t>(group.size());
+    auto entities = group.begin();
+
+    auto run = [&](auto... components) {
+        jobs.ParallelFor(group.size(), grain, [&](size_t begin, size_t end) {
+            for (auto i = static_cast<std::ptrdiff_t>(begin); i < static_cast<std::ptrdiff_t>(end); i++)
+                func(entities[i], components[i]...);
+        });
+    };
+
+    run((group.template storage<Owned>()->end() - length)...);
+}
\ No newline at end of file
@@ -1,17 +1,26 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <type_traits>
 #include <unordered_set>
+#include <vector>
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
 
+#include "core/JobSystem.h"
+#include "ECS/ParallelGroup.h"
+
 
 class ECSWorld {
 private:
     entt::registry registry;
     uint64_t nextID = 1;
 
+    /// Entities whose WorldTransformComponent was flagged since the last TransformSystem update
+    std::vector<entt::entity> dirtyTransforms;
+    uint64_t transformFrame = 0;
+
 public:
     ECSWorld();
 
@@ -57,6 +66,50 @@ public:
         registry.view<Components...>().each(std::forward<Func>(func));
     }
 
+    /**
+     * @brief Each() spread across the job system, @p grain entities per job at minimum
+     *
+     * @p func gets (entity, Components&...) and may run concurrently for different
+     * entities: it must not create/destroy entities or add/remove components.
+     */
+    template<typename... Components, typename Func>
+    void ParallelEach(Func &&func, size_t grain = 64) {
+        auto view = registry.view<Components...>();
+
+        std::vector<entt::entity> entities;
+        for (auto entity: view)
+            entities.push_back(entity);
+
+        GetJobSystem().ParallelFor(entities.size(), grain, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+                func(entities[i], view.template get<Components>(entities[i])...);
+        });
+    }
+
+    /**
+     * @brief The owning group over @p Owned, one of those the constructor sets up
+     *
+     * EnTT keeps a group's entities packed at the front of every owned pool in the
+     * same order, so iterating walks parallel arrays instead of probing each pool per
+     * entity. A pool can belong to one owning group only, and owned components must not
+     * be added or removed while the group is being iterated.
+     */
+    template<typename... Owned>
+    auto Group() {
+        return registry.group<Owned...>();
+    }
+
+    template<typename... Owned, typename Func>
+    void GroupEach(Func &&func) {
+        registry.group<Owned...>().each(std::forward<Func>(func));
+    }
+
+    /// ParallelEach() over an owning group; workers take contiguous slices of the packed pools
+    template<typename... Owned, typename Func>
+    void ParallelGroupEach(Func &&func, size_t grain = 64) {
+        ParallelOwnedEach<Owned...>(GetJobSystem(), registry.group<Owned...>(), std::forward<Func>(func), grain);
+    }
+
     void Clear();
 
     void SetParent(entt::entity child, entt::entity parent);
@@ -69,8 +122,23 @@ public:
 
     entt::entity FindGameCamera();
 
+    /// Current even between TransformSystem updates: falls back to the local chain while anything above is dirty
     glm::mat4 GetGlobalTransform(entt::entity entity, int depth = 0);
 
+    /**
+     * @brief Queue the entity and its subtree for TransformSystem's next rebuild
+     *
+     * registry.patch()/replace() on TransformComponent call this through on_update;
+     * code that writes a TransformComponent in place must call it itself.
+     */
+    void MarkTransformDirty(entt::entity entity);
+
+    /// Hands the dirty list to TransformSystem and starts a new transform frame
+    uint64_t TakeDirtyTransforms(std::vector<entt::entity> &out);
+
+    /// Number of TransformSystem updates so far; WorldTransformComponent::changedFrame is relative to it
+    uint64_t GetTransformFrame() const;
+
     entt::entity GetParent(entt::entity entity);
 
     std::unordered_set<entt::entity> GetChildren(entt::entity entity);
@@ -81,4 +149,20 @@ public:
     size_t GetEntityCount() const;
 
     bool IsValid(entt::entity entity) const;
-};
\ No newline at end of file
+
+private:
+    bool IsTransformCurrent(entt::entity entity);
+
+    void OnTransformConstruct(entt::registry &reg, entt::entity entity);
+
+    void OnTransformChanged(entt::registry &reg, entt::entity entity);
+
+    void OnRigidBodyConstruct(entt::registry &reg, entt::entity entity);
+};
+
+/**
+ * @brief Log the time to walk 100k mesh entities through a view and through the owning mesh group
+ *
+ * Registered as the "ECS_Benchmark" command.
+ */
+void BenchmarkEcsIteration();
\ No newline at end of file
@@ -27,3 +27,15 @@ struct RigidBodyComponent {
     glm::vec3 force_accum;
     glm::vec3 torque_accum;
 };
+
+/**
+ * @brief Body positions at the last two fixed steps, blended for rendering
+ *
+ * `presented` is the value written to TransformComponent after blending; a
+ * transform that no longer matches it was moved outside physics.
+ */
+struct PhysicsInterpolationComponent {
+    glm::vec3 previous;
+    glm::vec3 current;
+    glm::vec3 presented;
+};
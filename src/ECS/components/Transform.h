@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <entt/entt.hpp>
 
 struct TransformComponent {
     glm::vec3 position{0.0f};
@@ -31,4 +33,20 @@ struct TransformComponent {
     glm::vec3 GetEulerDegrees() const {
         return glm::degrees(glm::eulerAngles(rotation));
     }
+};
+
+/// Cached world-space matrix kept up to date by TransformSystem.
+/// Only entities on ECSWorld's dirty list are rebuilt, so in-place edits of
+/// TransformComponent need ECSWorld::MarkTransformDirty() (patch() does it).
+struct WorldTransformComponent {
+    glm::mat4 matrix{1.0f};
+
+    bool dirty = true;
+    /// ECSWorld::GetTransformFrame() of the last rebuild
+    uint64_t changedFrame = 0;
+
+    /// TransformSystem updates since the matrix last changed
+    uint64_t GetStableFrames(uint64_t transformFrame) const {
+        return transformFrame - changedFrame;
+    }
 };
\ No newline at end of file
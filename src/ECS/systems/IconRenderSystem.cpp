@@ -42,6 +42,8 @@ void IconRenderSystem::Update(ECSWorld &world, ShaderManager &shaderManager,
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glDisable(GL_DEPTH_TEST);
 
+    const Frustum frustum(projection * view);
+
     world.Each<TransformComponent, IconComponent, VisibilityComponent>(
         [&](entt::entity entity,
             TransformComponent &transform,
@@ -49,6 +51,9 @@ void IconRenderSystem::Update(ECSWorld &world, ShaderManager &shaderManager,
             VisibilityComponent &vis) {
             if (!vis.isActive || !vis.visible) return;
 
+            // Unit quad scaled by icon.scale: its half-diagonal bounds any billboard orientation
+            if (!frustum.IntersectsSphere(transform.position, icon.scale * 0.7072f)) return;
+
             if (icon.textureID == 0 && !icon.iconTexturePath.empty()) {
                 icon.textureID = textureManager->LoadTexture(icon.iconTexturePath);
                 if (icon.textureID == 0) {
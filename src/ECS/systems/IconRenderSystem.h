@@ -13,6 +13,7 @@
 #include "resource/texture/TextureManager.h"
 #include "rendering/core/VertexArray.h"
 #include "rendering/core/VertexBuffer.h"
+#include "rendering/Frustum.h"
 
 class IconRenderSystem {
 private:
@@ -10,7 +10,11 @@ void InputControllerSystem::Update(ECSWorld &world, Input &input, float deltaTim
             TransformComponent &transform, CameraOrientationComponent &orientation) {
             if (!camera.isMainCamera || !camera.isActive) return;
 
+            const glm::vec3 position = transform.position;
             ProcessKeyboard(input, transform, orientation, camera.movementSpeed, deltaTime);
+            if (transform.position != position)
+                world.MarkTransformDirty(entity);
+
             ProcessMouse(input, transform, orientation, camera.mouseSensitivity);
             ProcessScroll(input, camera);
         });
@@ -1,66 +1,63 @@
 #include "LightSystem.h"
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
+#include <algorithm>
 
-void LightSystem::Update(ECSWorld &world, ShaderManager &shaderManager, const std::string &shaderName,
-                         const std::vector<int> *shadowMapIndices, const std::vector<int> *pointShadowIndices) {
-    shaderManager.Bind(shaderName);
-
+uint32_t LightSystem::Update(ECSWorld &world, std::vector<LightBlock> &lights,
+                             const std::vector<int> *shadowMapIndices, const std::vector<int> *pointShadowIndices) {
+    lights.clear();
     int lightIndex = 0;
-    const int maxLights = 8;
 
     world.Each<LightComponent, TransformComponent>(
         [&](entt::entity entity, LightComponent &light, TransformComponent &transform) {
-            if (!light.isActive || lightIndex >= maxLights)
+            if (!light.isActive)
                 return;
 
             light.SyncWithTransform(transform);
 
-            std::string base = "lights[" + std::to_string(lightIndex) + "]";
-
-            // Set shadow map index
-            int shadowIndex = -1;
-            if (shadowMapIndices && lightIndex < shadowMapIndices->size())
-                shadowIndex = (*shadowMapIndices)[lightIndex];
+            LightBlock &block = lights.emplace_back();
 
-            shaderManager.SetInt(shaderName, base + ".type", static_cast<int>(light.type));
-            shaderManager.SetInt(shaderName, base + ".shadowIndex", shadowIndex);
+            block.type = static_cast<int>(light.type);
 
-            shaderManager.SetVec3(shaderName, base + ".position", light.position);
-            shaderManager.SetVec3(shaderName, base + ".direction", light.direction);
+            block.position = light.position;
+            block.direction = light.direction;
 
-            shaderManager.SetVec3(shaderName, base + ".ambient", light.ambient * light.intensity);
-            shaderManager.SetVec3(shaderName, base + ".diffuse", light.diffuse * light.intensity);
-            shaderManager.SetVec3(shaderName, base + ".specular", light.specular);
+            block.ambient = light.ambient * light.intensity;
+            block.diffuse = light.diffuse * light.intensity;
+            block.specular = light.specular;
 
-            shaderManager.SetFloat(shaderName, base + ".farPlane", std::max(light.radius, 100.0f));
+            block.farPlane = std::max(light.radius, 100.0f);
+            block.range = light.radius;
 
             if (light.type == LightType::POINT || light.type == LightType::SPOT) {
-                shaderManager.SetFloat(shaderName, base + ".constant", light.constant);
-                shaderManager.SetFloat(shaderName, base + ".linear", light.linear);
-                shaderManager.SetFloat(shaderName, base + ".quadratic", light.quadratic);
+                block.constant = light.constant;
+                block.linear = light.linear;
+                block.quadratic = light.quadratic;
             }
 
             if (light.type == LightType::SPOT) {
-                shaderManager.SetFloat(shaderName, base + ".innerCutoff",
-                                       glm::cos(glm::radians(light.innerCutoff)));
-                shaderManager.SetFloat(shaderName, base + ".outerCutoff",
-                                       glm::cos(glm::radians(light.outerCutoff)));
+                block.innerCutoff = glm::cos(glm::radians(light.innerCutoff));
+                block.outerCutoff = glm::cos(glm::radians(light.outerCutoff));
             }
 
+            // Set shadow map index
+            int shadowIndex = -1;
+            if (shadowMapIndices && lightIndex < shadowMapIndices->size())
+                shadowIndex = (*shadowMapIndices)[lightIndex];
+
             if (light.type == LightType::POINT) {
                 if (pointShadowIndices && lightIndex < pointShadowIndices->size())
                     shadowIndex = (*pointShadowIndices)[lightIndex];
-            } else {
-                if (shadowMapIndices && lightIndex < shadowMapIndices->size())
-                    shadowIndex = (*shadowMapIndices)[lightIndex];
             }
-            shaderManager.SetInt(shaderName, base + ".shadowIndex", shadowIndex);
+            block.shadowIndex = shadowIndex;
 
             lightIndex++;
         });
 
-    shaderManager.SetInt(shaderName, "numLights", lightIndex);
+    // Shadow indices were looked up above, so reordering no longer matters
+    auto firstLocal = std::stable_partition(lights.begin(), lights.end(), [](const LightBlock &block) {
+        return block.type == static_cast<int>(LightType::DIRECTIONAL);
+    });
 
-    shaderManager.Unbind();
+    return static_cast<uint32_t>(firstLocal - lights.begin());
 }
\ No newline at end of file
@@ -1,16 +1,23 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 #include "ECS/components/Components.h"
 #include "ECS/World.h"
 #include "core/logging/Logger.h"
-#include "resource/shader/ShaderManager.h"
+#include "rendering/ShaderBlocks.h"
 #include "scene/Light.h"
 
 class LightSystem {
 public:
-    void Update(ECSWorld &world, ShaderManager &shaderManager, const std::string &shaderName,
-                const std::vector<int> *shadowMapIndices = nullptr, const std::vector<int> *pointShadowIndices = nullptr);
+    /**
+     * @brief Collect the active lights for the frame, directional ones first
+     * @param lights Refilled; point and spot lights follow the directional ones for cluster culling
+     * @return Number of leading directional lights
+     */
+    uint32_t Update(ECSWorld &world, std::vector<LightBlock> &lights,
+                    const std::vector<int> *shadowMapIndices = nullptr,
+                    const std::vector<int> *pointShadowIndices = nullptr);
 };
\ No newline at end of file
@@ -1,88 +1,86 @@
 #include "PhysicsSystem.h"
 #include <algorithm>
+#include <cmath>
 #include "core/logging/Logger.h"
-#include "core/CommandManager.h"
+#include "core/EventBus.h"
 
 void PhysicsSystem::Update(ECSWorld &world, float dt) {
-    entities.clear();
+    bodies.clear();
+    broadphase.BeginUpdate();
 
-    world.Each<TransformComponent, RigidBodyComponent, ColliderComponent>(
-        [&](entt::entity entity,
+    world.ParallelGroupEach<TransformComponent, RigidBodyComponent, ColliderComponent>(
+        [&](entt::entity,
             TransformComponent &t,
             RigidBodyComponent &r,
-            ColliderComponent &c) {
+            ColliderComponent &) {
             if (r.inv_mass != 0) {
                 r.velocity += gravity * dt;
                 t.position += r.velocity * dt;
             }
+        }, 256);
 
-            entities.push_back(entity);
+    world.GroupEach<TransformComponent, RigidBodyComponent, ColliderComponent>(
+        [&](entt::entity entity,
+            TransformComponent &t,
+            RigidBodyComponent &r,
+            ColliderComponent &c) {
+            broadphase.UpdateProxy(entity, ComputeWorldBounds(c, t.position),
+                                   static_cast<uint32_t>(bodies.size()));
+            bodies.push_back({entity, &t, &r, &c});
         });
 
+    broadphase.FindPairs(candidatePairs);
+
     std::set<std::pair<entt::entity, entt::entity> > currentTriggers;
 
-    for (int i = 0; i < entities.size(); i++)
-        for (int j = i + 1; j < entities.size(); j++) {
-            auto &col_a = world.GetComponent<ColliderComponent>(entities[i]);
-            auto &col_b = world.GetComponent<ColliderComponent>(entities[j]);
-            auto &rb_a = world.GetComponent<RigidBodyComponent>(entities[i]);
-            auto &rb_b = world.GetComponent<RigidBodyComponent>(entities[j]);
-            auto &t_a = world.GetComponent<TransformComponent>(entities[i]);
-            auto &t_b = world.GetComponent<TransformComponent>(entities[j]);
-
-            if (!std::holds_alternative<AABB>(col_a.shape) &&
-                !std::holds_alternative<AABB>(col_b.shape))
-                continue;
-
-            AABB &aabb_a = std::get<AABB>(col_a.shape);
-            AABB &aabb_b = std::get<AABB>(col_b.shape);
-
-            ContactInfo contact{};
-            contact.a = entities[i];
-            contact.b = entities[j];
-
-            AABB world_a = {
-                aabb_a.min + t_a.position,
-                aabb_a.max + t_a.position
-            };
-            AABB world_b = {
-                aabb_b.min + t_b.position,
-                aabb_b.max + t_b.position
-            };
-
-            if (!TestAABB(world_a, world_b, contact))
-                continue;
-
-            if (col_a.isTrigger || col_b.isTrigger) {
-                auto pair = std::make_pair(entities[i], entities[j]);
-                currentTriggers.insert(pair);
-            } else {
-                float total = rb_a.inv_mass + rb_b.inv_mass;
-                if (total == 0.0f) continue;
-
-                float vRel = glm::dot(rb_a.velocity - rb_b.velocity, contact.normal);
-                if (vRel > 0.0f) {
-                    rb_a.velocity -= contact.normal * vRel * (rb_a.inv_mass / total);
-                    rb_b.velocity += contact.normal * vRel * (rb_b.inv_mass / total);
-                }
-
-                float ratio_a = rb_a.inv_mass / total;
-                float ratio_b = rb_b.inv_mass / total;
-                t_a.position -= contact.normal * contact.depth * ratio_a;
-                t_b.position += contact.normal * contact.depth * ratio_b;
+    for (const auto &candidate: candidatePairs) {
+        // Keep a stable a/b order so trigger pairs match between steps whatever the sweep order
+        const Body *a = &bodies[candidate.a];
+        const Body *b = &bodies[candidate.b];
+        if (b->entity < a->entity)
+            std::swap(a, b);
+
+        ContactInfo contact{};
+        contact.a = a->entity;
+        contact.b = b->entity;
+
+        if (!Collide(*a, *b, contact))
+            continue;
+
+        if (a->collider->isTrigger || b->collider->isTrigger) {
+            currentTriggers.insert(std::make_pair(a->entity, b->entity));
+        } else {
+            auto &rb_a = *a->rigidBody;
+            auto &rb_b = *b->rigidBody;
+            auto &t_a = *a->transform;
+            auto &t_b = *b->transform;
+
+            float total = rb_a.inv_mass + rb_b.inv_mass;
+            if (total == 0.0f) continue;
+
+            float vRel = glm::dot(rb_a.velocity - rb_b.velocity, contact.normal);
+            if (vRel > 0.0f) {
+                rb_a.velocity -= contact.normal * vRel * (rb_a.inv_mass / total);
+                rb_b.velocity += contact.normal * vRel * (rb_b.inv_mass / total);
             }
+
+            float ratio_a = rb_a.inv_mass / total;
+            float ratio_b = rb_b.inv_mass / total;
+            t_a.position -= contact.normal * contact.depth * ratio_a;
+            t_b.position += contact.normal * contact.depth * ratio_b;
         }
+    }
 
     for (auto &p: currentTriggers)
         if (!m_activeTriggers.count(p)) {
-            CommandManager::ExecuteCommand("OnTriggerEnter", {p.first, p.second});
-            Logger::Log(LogLevel::INFO, "Enter trigger");
+            GetEventBus().Enqueue(TriggerEnterEvent{p.first, p.second});
+            LOG_DEBUG(ECS_SYSTEM, "Enter trigger: {} / {}", entt::to_integral(p.first), entt::to_integral(p.second));
         }
 
     for (auto &p: m_activeTriggers)
         if (!currentTriggers.count(p)) {
-            CommandManager::ExecuteCommand("OnTriggerExit", {p.first, p.second});
-            Logger::Log(LogLevel::INFO, "Exit trigger");
+            GetEventBus().Enqueue(TriggerExitEvent{p.first, p.second});
+            LOG_DEBUG(ECS_SYSTEM, "Exit trigger: {} / {}", entt::to_integral(p.first), entt::to_integral(p.second));
         }
 
     m_activeTriggers = currentTriggers;
@@ -96,6 +94,95 @@ void PhysicsSystem::SetGravity(glm::vec3 newGravity) {
     gravity = newGravity;
 }
 
+void PhysicsSystem::BeginFixedUpdate(ECSWorld &world) {
+    // ECSWorld gives every rigid body its interpolation state on construction
+    world.Each<TransformComponent, RigidBodyComponent, PhysicsInterpolationComponent>(
+        [](entt::entity,
+           TransformComponent &t,
+           RigidBodyComponent &,
+           PhysicsInterpolationComponent &interp) {
+            if (t.position != interp.presented) {
+                interp.previous = t.position;
+                interp.current = t.position;
+            } else {
+                t.position = interp.current;
+            }
+        });
+}
+
+void PhysicsSystem::Step(ECSWorld &world, float dt) {
+    world.Each<TransformComponent, PhysicsInterpolationComponent>(
+        [](entt::entity, TransformComponent &t, PhysicsInterpolationComponent &interp) {
+            interp.previous = t.position;
+        });
+
+    Update(world, dt);
+
+    world.Each<TransformComponent, PhysicsInterpolationComponent>(
+        [](entt::entity, TransformComponent &t, PhysicsInterpolationComponent &interp) {
+            interp.current = t.position;
+        });
+}
+
+void PhysicsSystem::Interpolate(ECSWorld &world, float alpha) {
+    world.Each<TransformComponent, RigidBodyComponent, PhysicsInterpolationComponent>(
+        [&world, alpha](entt::entity entity,
+                        TransformComponent &t,
+                        RigidBodyComponent &,
+                        PhysicsInterpolationComponent &interp) {
+            t.position = glm::mix(interp.previous, interp.current, alpha);
+            // Steps move t.position freely; only what is presented reaches the world matrix
+            if (t.position != interp.presented) {
+                interp.presented = t.position;
+                world.MarkTransformDirty(entity);
+            }
+        });
+}
+
+size_t PhysicsSystem::GetCandidatePairCount() const {
+    return candidatePairs.size();
+}
+
+AABB PhysicsSystem::ComputeWorldBounds(const ColliderComponent &collider, const glm::vec3 &position) {
+    if (const auto *box = std::get_if<AABB>(&collider.shape))
+        return {box->min + position, box->max + position};
+
+    const auto &sphere = std::get<Sphere>(collider.shape);
+    const glm::vec3 centre = sphere.centre + position;
+    return {centre - glm::vec3(sphere.radius), centre + glm::vec3(sphere.radius)};
+}
+
+bool PhysicsSystem::Collide(const Body &a, const Body &b, ContactInfo &contact) {
+    const auto &shape_a = a.collider->shape;
+    const auto &shape_b = b.collider->shape;
+    const glm::vec3 &pos_a = a.transform->position;
+    const glm::vec3 &pos_b = b.transform->position;
+
+    const auto *box_a = std::get_if<AABB>(&shape_a);
+    const auto *box_b = std::get_if<AABB>(&shape_b);
+    const auto *sphere_a = std::get_if<Sphere>(&shape_a);
+    const auto *sphere_b = std::get_if<Sphere>(&shape_b);
+
+    if (box_a && box_b)
+        return TestAABB({box_a->min + pos_a, box_a->max + pos_a},
+                        {box_b->min + pos_b, box_b->max + pos_b}, contact);
+
+    if (sphere_a && sphere_b)
+        return TestSphere({sphere_a->centre + pos_a, sphere_a->radius},
+                          {sphere_b->centre + pos_b, sphere_b->radius}, contact);
+
+    if (box_a && sphere_b)
+        return TestAABBSphere({box_a->min + pos_a, box_a->max + pos_a},
+                              {sphere_b->centre + pos_b, sphere_b->radius}, contact);
+
+    if (!TestAABBSphere({box_b->min + pos_b, box_b->max + pos_b},
+                        {sphere_a->centre + pos_a, sphere_a->radius}, contact))
+        return false;
+
+    contact.normal = -contact.normal;
+    return true;
+}
+
 bool PhysicsSystem::TestAABB(const AABB &a, const AABB &b, ContactInfo &contact) {
     float ox = std::min(a.max.x, b.max.x) - std::max(a.min.x, b.min.x);
     float oy = std::min(a.max.y, b.max.y) - std::max(a.min.y, b.min.y);
@@ -120,3 +207,36 @@ bool PhysicsSystem::TestAABB(const AABB &a, const AABB &b, ContactInfo &contact)
 
     return true;
 }
+
+
+bool PhysicsSystem::TestSphere(const Sphere &a, const Sphere &b, ContactInfo &contact) {
+    glm::vec3 dir = b.centre - a.centre;
+    float distSq = glm::dot(dir, dir);
+    float radii = a.radius + b.radius;
+
+    if (distSq >= radii * radii) return false;
+
+    float dist = std::sqrt(distSq);
+    contact.depth = radii - dist;
+    contact.normal = dist > 0.0f ? dir / dist : glm::vec3(0, 1, 0);
+    return true;
+}
+
+bool PhysicsSystem::TestAABBSphere(const AABB &box, const Sphere &sphere, ContactInfo &contact) {
+    glm::vec3 closest = glm::clamp(sphere.centre, box.min, box.max);
+    glm::vec3 dir = sphere.centre - closest;
+    float distSq = glm::dot(dir, dir);
+
+    if (distSq >= sphere.radius * sphere.radius) return false;
+
+    if (distSq > 0.0f) {
+        float dist = std::sqrt(distSq);
+        contact.depth = sphere.radius - dist;
+        contact.normal = dir / dist;
+        return true;
+    }
+
+    // Centre inside the box: push out along the axis of least penetration
+    AABB sphereBox = {sphere.centre - glm::vec3(sphere.radius), sphere.centre + glm::vec3(sphere.radius)};
+    return TestAABB(box, sphereBox, contact);
+}
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include "ECS/components/Components.h"
 #include "ECS/World.h"
+#include "physics/Broadphase.h"
 
 struct ContactInfo {
     entt::entity a;
@@ -18,19 +19,66 @@ struct ContactInfo {
     float depth;
 };
 
+/// Queued on the EventBus when a trigger pair starts or stops overlapping; scripting forwards them to the scripts
+struct TriggerEnterEvent {
+    entt::entity a;
+    entt::entity b;
+};
+
+struct TriggerExitEvent {
+    entt::entity a;
+    entt::entity b;
+};
+
 class PhysicsSystem {
+    /// Components of one body, gathered once per step so narrowphase does no registry lookups
+    struct Body {
+        entt::entity entity;
+        TransformComponent *transform;
+        RigidBodyComponent *rigidBody;
+        ColliderComponent *collider;
+    };
+
     glm::vec3 gravity = {0, -9.8, 0};
-    std::vector<entt::entity> entities;
+    std::vector<Body> bodies;
+
+    SweepAndPrune broadphase;
+    std::vector<BroadphasePair> candidatePairs;
 
     std::set<std::pair<entt::entity, entt::entity> > m_activeTriggers;
 
 public:
+    /// One integration + collision step of @p dt seconds
     void Update(ECSWorld &world, float dt);
 
+    /**
+     * @brief Put bodies back at their simulated positions before a frame's fixed steps
+     * Bodies moved by scripts or the editor since the last Interpolate() keep the new position.
+     */
+    void BeginFixedUpdate(ECSWorld &world);
+
+    /// Update() that also records the previous/current positions used by Interpolate()
+    void Step(ECSWorld &world, float dt);
+
+    /// Write positions blended between the last two steps; @p alpha in [0, 1)
+    void Interpolate(ECSWorld &world, float alpha);
+
     glm::vec3 GetGravity();
 
     void SetGravity(glm::vec3 newGravity);
 
+    /// Pairs the broadphase handed to narrowphase in the last step
+    size_t GetCandidatePairCount() const;
+
 private:
+    static AABB ComputeWorldBounds(const ColliderComponent &collider, const glm::vec3 &position);
+
+    bool Collide(const Body &a, const Body &b, ContactInfo &contact);
+
     bool TestAABB(const AABB &a, const AABB &b, ContactInfo &contact);
+
+    bool TestSphere(const Sphere &a, const Sphere &b, ContactInfo &contact);
+
+    /// Normal points from the box towards the sphere
+    bool TestAABBSphere(const AABB &box, const Sphere &sphere, ContactInfo &contact);
 };
@@ -2,37 +2,83 @@
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
 
-void RenderSystem::Update(ECSWorld &world, ShaderManager &shaderManager, const std::string &name) {
-    shaderManager.Bind(name);
+void RenderSystem::Update(ECSWorld &world, ShaderManager &shaderManager, GLContext &context,
+                          MaterialBuffer &materialBuffer, const std::string &name, const glm::mat4 &view, const glm::mat4 &projection,
+                          float farPlane) {
+    ShaderObj *shader = shaderManager.GetShader(name);
+    if (!shader || !shader->IsValid())
+        return;
 
-    world.Each<TransformComponent, MeshComponent, MaterialComponent, VisibilityComponent>(
+    queue.Clear();
+    frustum.Update(projection * view);
+    culledCount = 0;
+
+    candidates.clear();
+    auto &registry = world.GetRegistry();
+    world.GroupEach<WorldTransformComponent, MeshComponent, VisibilityComponent>(
         [&](entt::entity entity,
-            TransformComponent &transform,
+            WorldTransformComponent &worldTransform,
             MeshComponent &meshComp,
-            MaterialComponent &matComp,
             VisibilityComponent &vis) {
-            if (!vis.isActive || !vis.visible) return;
-
-            const glm::mat4 modelMatrix = world.GetGlobalTransform(entity);
-            shaderManager.SetMat4(name, "model", modelMatrix);
-
-            if (matComp.material) {
-                if (meshComp.mesh) {
-                    shaderManager.SetVec2(name, "tiling", world.GetComponent<MaterialComponent>(entity).tiling);
-                    meshComp.mesh->Draw(shaderManager, name, matComp.material);
-                }
-            } else if (world.HasComponent<ColorComponent>(entity)) {
-                const auto &color = world.GetComponent<ColorComponent>(entity);
-                if (meshComp.mesh)
-                    meshComp.mesh->SetColor(color.color);
-
-                if (meshComp.mesh)
-                    meshComp.mesh->Draw(shaderManager, name);
-            } else {
-                if (meshComp.mesh)
-                    meshComp.mesh->Draw(shaderManager, name);
-            }
+            if (!vis.isActive || !vis.visible || !meshComp.mesh) return;
+            // The mesh group is shared with the shadow casters, so material is the one sparse lookup left
+            auto *matComp = registry.try_get<MaterialComponent>(entity);
+            if (!matComp) return;
+            candidates.push_back({entity, &worldTransform, &meshComp, matComp, false});
         });
 
+    // Bounds transform + plane tests are independent per mesh, so they fan out across workers
+    GetJobSystem().ParallelFor(candidates.size(), 128, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            auto &c = candidates[i];
+            c.inFrustum = frustum.Intersects(c.mesh->mesh->GetBounds().Transform(c.transform->matrix));
+        }
+    });
+
+    for (const auto &c: candidates) {
+        if (!c.inFrustum) {
+            culledCount++;
+            continue;
+        }
+
+        const glm::mat4 &matrix = c.transform->matrix;
+
+        DrawItem item;
+        item.shader = shader;
+        item.mesh = c.mesh->mesh.get();
+        item.model = &matrix;
+
+        if (c.material->material) {
+            item.material = c.material->material.get();
+            item.tiling = c.material->tiling;
+        } else {
+            item.material = c.mesh->mesh->GetMaterial().get();
+            if (auto *color = registry.try_get<ColorComponent>(c.entity))
+                item.color = &color->color;
+        }
+
+        float depth = -(view * matrix[3]).z;
+        item.key = RenderQueue::MakeKey(RenderPassType::OPAQUE, shader->ID,
+                                        item.material ? item.material->GetID() : 0,
+                                        item.mesh->GetID(), depth / farPlane);
+
+        queue.Push(item);
+    }
+
+    queue.Sort();
+    queue.Submit(context, materialBuffer);
+
     shaderManager.Unbind();
+}
+
+void RenderSystem::SetInstancingEnabled(bool enable) {
+    queue.SetInstancingEnabled(enable);
+}
+
+const RenderQueue &RenderSystem::GetQueue() const {
+    return queue;
+}
+
+int RenderSystem::GetCulledCount() const {
+    return culledCount;
 }
\ No newline at end of file
@@ -2,13 +2,48 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
 
 #include "ECS/components/Components.h"
 #include "ECS/World.h"
 #include "core/logging/Logger.h"
+#include "rendering/Frustum.h"
+#include "rendering/RenderQueue.h"
+#include "rendering/core/GLContext.h"
 #include "resource/shader/ShaderManager.h"
 
 class RenderSystem {
+    struct Candidate {
+        entt::entity entity;
+        WorldTransformComponent *transform;
+        MeshComponent *mesh;
+        MaterialComponent *material;
+        bool inFrustum;
+    };
+
+    RenderQueue queue;
+    Frustum frustum;
+    std::vector<Candidate> candidates;
+
+    int culledCount = 0;
+
 public:
-    static void Update(ECSWorld &world, ShaderManager &shaderManager, const std::string &name);
+    /**
+     * @brief Gather meshes inside the camera frustum into the render queue, sort and submit them
+     * @param view Camera view matrix, used for the depth part of the sort key
+     * @param projection Camera projection, combined with view for frustum culling
+     * @param farPlane Distance mapped to the far end of the depth key range
+     */
+    void Update(ECSWorld &world, ShaderManager &shaderManager, GLContext &context, MaterialBuffer &materialBuffer,
+                const std::string &name, const glm::mat4 &view, const glm::mat4 &projection,
+                float farPlane = 1000.0f);
+
+    void SetInstancingEnabled(bool enable);
+
+    const RenderQueue &GetQueue() const;
+
+    /// Meshes rejected by the frustum test during the last Update()
+    int GetCulledCount() const;
 };
\ No newline at end of file
@@ -8,4 +8,5 @@
 #include "ECS/systems/ScriptSystem.h"
 #include "ECS/systems/AudioSystem.h"
 #include "ECS/systems/PhysicsDebugRenderSystem.h"
-#include "ECS/systems/PhysicsSystem.h"
\ No newline at end of file
+#include "ECS/systems/PhysicsSystem.h"
+#include "ECS/systems/TransformSystem.h"
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "TransformSystem.h"
+
+void TransformSystem::Update(ECSWorld &world) {
+    auto &registry = world.GetRegistry();
+    auto view = registry.view<TransformComponent, WorldTransformComponent>();
+
+    const uint64_t frame = world.TakeDirtyTransforms(dirty);
+    lastRebuildCount = 0;
+
+    for (auto entity: dirty) {
+        // Gone, or already rebuilt under a dirty ancestor
+        if (!view.contains(entity) || !view.get<WorldTransformComponent>(entity).dirty)
+            continue;
+
+        // Start from the highest dirty ancestor so each subtree is rebuilt once, parents first
+        entt::entity start = entity;
+        entt::entity up = ParentOf(registry, entity);
+        for (int depth = 0; up != entt::null && depth < 64; depth++) {
+            if (view.get<WorldTransformComponent>(up).dirty)
+                start = up;
+            up = ParentOf(registry, up);
+        }
+
+        stack.clear();
+        stack.push_back(start);
+
+        while (!stack.empty()) {
+            entt::entity current = stack.back();
+            stack.pop_back();
+
+            auto &cached = view.get<WorldTransformComponent>(current);
+            // Also stops a hierarchy cycle from looping forever
+            if (cached.changedFrame == frame)
+                continue;
+
+            glm::mat4 local = view.get<TransformComponent>(current).GetModelMatrix();
+            entt::entity parent = ParentOf(registry, current);
+
+            if (parent != entt::null)
+                cached.matrix = view.get<WorldTransformComponent>(parent).matrix * local;
+            else
+                cached.matrix = local;
+
+            cached.dirty = false;
+            cached.changedFrame = frame;
+            lastRebuildCount++;
+
+            auto *hierarchy = registry.try_get<HierarchyComponent>(current);
+            if (!hierarchy)
+                continue;
+
+            for (auto child: hierarchy->children)
+                if (view.contains(child) && ParentOf(registry, child) == current)
+                    stack.push_back(child);
+        }
+    }
+}
+
+size_t TransformSystem::GetLastRebuildCount() const {
+    return lastRebuildCount;
+}
+
+entt::entity TransformSystem::ParentOf(entt::registry &registry, entt::entity entity) {
+    auto *hierarchy = registry.try_get<HierarchyComponent>(entity);
+    if (!hierarchy || !hierarchy->HasParent() || !registry.valid(hierarchy->parent) ||
+        !registry.all_of<TransformComponent, WorldTransformComponent>(hierarchy->parent))
+        return entt::null;
+
+    return hierarchy->parent;
+}
\ No newline at end of file
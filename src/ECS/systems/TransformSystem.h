@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include "ECS/components/Components.h"
+#include "ECS/World.h"
+
+/**
+ * @class TransformSystem
+ * @brief Keeps WorldTransformComponent in sync with the entity hierarchy
+ *
+ * Runs once per frame over ECSWorld's dirty list only: every dirty subtree is
+ * rebuilt parent-before-child, and nothing else is visited.
+ */
+class TransformSystem {
+    std::vector<entt::entity> dirty;
+    std::vector<entt::entity> stack;
+
+    size_t lastRebuildCount = 0;
+
+public:
+    void Update(ECSWorld &world);
+
+    size_t GetLastRebuildCount() const;
+
+private:
+    /// entt::null when the parent is missing or has no transform
+    static entt::entity ParentOf(entt::registry &registry, entt::entity entity);
+};
\ No newline at end of file
@@ -1,11 +1,18 @@
 #include "DebugOverlay.h"
 
+#include <algorithm>
+#include <functional>
+#include <map>
+
 #include <glm/glm.hpp>
 
+#include "core/Profiler.h"
 #include "core/logging/Logger.h"
 
 void DebugOverlay::Render(ECSWorld *ecs, entt::entity cameraEntity,
-                          MaterialManager *materialManager) {
+                          MaterialManager *materialManager,
+                          const RenderStats *renderStats,
+                          const ModuleManager *moduleManager) {
     if (!visible || !ecs) return;
 
     ImGui::SetNextWindowPos({10.f, 10.f}, ImGuiCond_FirstUseEver);
@@ -35,6 +42,19 @@ void DebugOverlay::Render(ECSWorld *ecs, entt::entity cameraEntity,
             RenderCreateEntityTab();
             ImGui::EndTabItem();
         }
+        if ((renderStats || moduleManager) && ImGui::BeginTabItem("Stats")) {
+            if (renderStats)
+                RenderStatsTab(*renderStats);
+            if (moduleManager)
+                RenderModuleTimings(*moduleManager);
+            if (materialManager && materialManager->GetTextureManager())
+                RenderTextureStats(*materialManager->GetTextureManager());
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Profiler")) {
+            RenderProfilerTab();
+            ImGui::EndTabItem();
+        }
         ImGui::EndTabBar();
     }
 
@@ -76,6 +96,220 @@ void DebugOverlay::RenderSceneTab(ECSWorld *ecs) {
                         : "Command NOT registered!");
         Execute("onDebugPauseToggle");
     }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Benchmark broadphase"))
+        Execute("Physics_BenchmarkBroadphase");
+
+    if (ImGui::Button("Benchmark jobs"))
+        Execute("Jobs_Benchmark");
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Benchmark logging"))
+        Execute("Log_Benchmark");
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Benchmark commands"))
+        Execute("Commands_Benchmark");
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Benchmark events"))
+        Execute("Events_Benchmark");
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Benchmark ECS"))
+        Execute("ECS_Benchmark");
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Cook models"))
+        Execute("Models_Cook");
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Benchmark textures"))
+        Execute("Textures_Benchmark");
+
+    if (ImGui::Button("Light stress scene"))
+        Execute("onCreateLightStressScene");
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Benchmark lights"))
+        Execute("Renderer_BenchmarkLights");
+
+    ImGui::Separator();
+    ImGui::Text("Shadow cascades");
+    ImGui::SliderInt("Cascades", &m_shadowCascades, 1, 4);
+    ImGui::SliderFloat("Split lambda", &m_cascadeLambda, 0.0f, 1.0f);
+    ImGui::DragFloat("Shadow distance", &m_shadowDistance, 1.0f, 5.0f, 1000.0f);
+
+    if (ImGui::Button("Apply cascades"))
+        Execute("Renderer_SetShadowCascades", {m_shadowCascades, m_cascadeLambda, m_shadowDistance});
+}
+
+void DebugOverlay::RenderStatsTab(const RenderStats &stats) {
+    ImGui::Spacing();
+    ImGui::Text("FPS: %.0f (%.2f ms)", stats.fps, stats.frameTime);
+    ImGui::Text("Draw calls: %d", stats.drawCalls);
+    ImGui::Text("Triangles: %d", stats.triangleCount);
+    ImGui::Text("State changes: %d", stats.stateChanges);
+
+    ImGui::Separator();
+    ImGui::Text("Culling");
+    ImGui::Text("Objects: %d submitted, %d culled", stats.submittedObjects, stats.culledObjects);
+    ImGui::Text("Shadow casters: %d drawn, %d culled", stats.shadowCasters, stats.shadowCastersCulled);
+    ImGui::Text("Shadow layers: %d drawn, %d skipped", stats.shadowLayersUpdated, stats.shadowLayersSkipped);
+    ImGui::Text("Static shadow refreshes: %d (%d deferred)", stats.shadowStaticRefreshes,
+                stats.shadowRefreshesDeferred);
+
+    ImGui::Separator();
+    ImGui::Text("Instancing");
+    ImGui::Text("Batches: %d (%d items)", stats.instancedBatches, stats.instancedItems);
+    ImGui::Text("Single draws: %d", stats.singletonDraws);
+    ImGui::Text("Material blocks uploaded: %d", stats.materialUploads);
+
+    ImGui::Separator();
+    ImGui::Text("Lights");
+    ImGui::Text("%d lights, %d cluster entries (max %d per cluster)", stats.lights, stats.lightIndices,
+                stats.maxClusterLights);
+    ImGui::Text("Culling: %.3f ms", stats.lightCullMs);
+}
+
+void DebugOverlay::RenderModuleTimings(const ModuleManager &moduleManager) {
+    ImGui::Separator();
+    ImGui::Text("Modules: %.3f ms", moduleManager.GetLastUpdateMs());
+
+    for (const auto &timing: moduleManager.GetTimings())
+        ImGui::Text("  %-10s %.3f ms%s", timing.name.c_str(), timing.updateMs,
+                    timing.mainThread ? "" : " (worker)");
+}
+
+void DebugOverlay::RenderTextureStats(const TextureManager &textureManager) {
+    ImGui::Separator();
+    ImGui::Text("Textures: %zu resident, %.1f MB", textureManager.GetResidentCount(),
+                static_cast<double>(textureManager.GetResidentBytes()) / (1024.0 * 1024.0));
+}
+
+void DebugOverlay::RenderProfilerTab() {
+    Profiler &profiler = Profiler::Get();
+    const ProfileFrame &frame = profiler.GetLastFrame();
+
+    ImGui::Spacing();
+    bool enabled = profiler.IsEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled))
+        profiler.SetEnabled(enabled);
+    ImGui::SameLine();
+    bool paused = profiler.IsPaused();
+    if (ImGui::Checkbox("Paused", &paused))
+        profiler.SetPaused(paused);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(-1.f);
+    ImGui::SliderFloat("##zoom", &m_profileZoom, 1.0f, 32.0f, "Zoom %.1fx", ImGuiSliderFlags_Logarithmic);
+
+    const uint64_t frameNs = std::max<uint64_t>(frame.endNs - frame.startNs, 1);
+    ImGui::Text("Frame %llu: %.3f ms", static_cast<unsigned long long>(frame.index), frameNs / 1e6);
+
+    // Flame graph: one band per thread, one row per nesting depth, x is time within the frame
+    const float rowHeight = ImGui::GetTextLineHeight() + 2.0f;
+    const float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f) * m_profileZoom;
+    const double pixelsPerNs = width / static_cast<double>(frameNs);
+
+    auto barColor = [](const char *name) {
+        const size_t hash = std::hash<std::string>{}(name);
+        return ImColor::HSV(static_cast<float>(hash % 360) / 360.0f, 0.55f, 0.8f);
+    };
+
+    auto drawBar = [&](ImDrawList *draw, ImVec2 origin, uint64_t startNs, uint64_t durationNs, int row,
+                       const char *name) {
+        const float x0 = origin.x + static_cast<float>((static_cast<double>(startNs) -
+                                                        static_cast<double>(frame.startNs)) * pixelsPerNs);
+        const float x1 = std::max(x0 + 1.0f, x0 + static_cast<float>(durationNs * pixelsPerNs));
+        const ImVec2 min(x0, origin.y + row * rowHeight);
+        const ImVec2 max(x1, min.y + rowHeight - 1.0f);
+
+        draw->AddRectFilled(min, max, barColor(name));
+        if (ImGui::CalcTextSize(name).x < x1 - x0 - 4.0f)
+            draw->AddText(ImVec2(min.x + 2.0f, min.y + 1.0f), IM_COL32(0, 0, 0, 255), name);
+
+        if (ImGui::IsMouseHoveringRect(min, max))
+            ImGui::SetTooltip("%s\n%.3f ms", name, durationNs / 1e6);
+    };
+
+    ImGui::BeginChild("##timeline", ImVec2(0.0f, 260.0f), true, ImGuiWindowFlags_HorizontalScrollbar);
+    ImDrawList *draw = ImGui::GetWindowDrawList();
+
+    for (const ProfileThreadEvents &thread: frame.threads) {
+        ImGui::TextUnformatted(thread.threadName.c_str());
+
+        uint32_t rows = 1;
+        for (const ProfileEvent &event: thread.events)
+            rows = std::max(rows, event.depth + 1);
+
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        for (const ProfileEvent &event: thread.events)
+            drawBar(draw, origin, event.startNs, event.endNs - event.startNs, static_cast<int>(event.depth),
+                    event.name);
+        ImGui::Dummy(ImVec2(width, rows * rowHeight));
+    }
+
+    if (!frame.gpu.empty()) {
+        ImGui::TextUnformatted("GPU (a few frames behind)");
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        for (const GpuProfileEvent &event: frame.gpu)
+            drawBar(draw, origin, std::max(event.cpuStartNs, frame.startNs), event.durationNs, 0, event.name);
+        ImGui::Dummy(ImVec2(width, rowHeight));
+    }
+    ImGui::EndChild();
+
+    // Totals per scope name, summed over all threads
+    std::map<std::string, std::pair<double, int> > totals;
+    for (const ProfileThreadEvents &thread: frame.threads)
+        for (const ProfileEvent &event: thread.events) {
+            auto &total = totals[event.name];
+            total.first += (event.endNs - event.startNs) / 1e6;
+            total.second++;
+        }
+
+    if (ImGui::BeginTable("##profile_totals", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+        ImGui::TableSetupColumn("Scope");
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableHeadersRow();
+        for (const auto &[name, total]: totals) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", total.first);
+            ImGui::TableNextColumn();
+            ImGui::Text("%d", total.second);
+        }
+        for (const GpuProfileEvent &event: frame.gpu) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%s (GPU)", event.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", event.durationNs / 1e6);
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted("1");
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::Separator();
+    ImGui::Text("Chrome trace export");
+    ImGui::InputInt("Frames", &m_profileFrames);
+    ImGui::InputText("File", m_profilePathBuf, sizeof(m_profilePathBuf));
+    ImGui::BeginDisabled(profiler.IsCapturing());
+    if (ImGui::Button(profiler.IsCapturing() ? "Capturing..." : "Capture", {-1.f, 0}))
+        Execute("Profiler_Capture", {std::max(m_profileFrames, 1), std::string(m_profilePathBuf)});
+    ImGui::EndDisabled();
 }
 
 void DebugOverlay::RenderHierarchyTab(ECSWorld *ecs) {
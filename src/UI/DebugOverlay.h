@@ -8,6 +8,8 @@
 #include "ECS/components/Components.h"
 #include "resource/material/MaterialManager.h"
 #include "core/CommandManager.h"
+#include "core/ModuleManager.h"
+#include "rendering/RenderingTypes.h"
 
 #include "UI/panels/TagPanel.h"
 #include "UI/panels/TransformPanel.h"
@@ -26,7 +28,9 @@ public:
     AudioPanel audioPanel;
 
     void Render(ECSWorld *ecs, entt::entity cameraEntity,
-                MaterialManager *materialManager);
+                MaterialManager *materialManager,
+                const RenderStats *renderStats = nullptr,
+                const ModuleManager *moduleManager = nullptr);
 
 private:
     entt::entity m_selected = entt::null;
@@ -37,8 +41,17 @@ private:
 
     char m_modelPath[512]{};
 
+    int m_shadowCascades = 4;
+    float m_cascadeLambda = 0.75f;
+    float m_shadowDistance = 100.0f;
+
     bool m_showOpenModelDialog = false;
 
+    int m_profileFrames = 120;
+    char m_profilePathBuf[256] = "profile.json";
+    /// Timeline zoom: 1 fits the whole frame
+    float m_profileZoom = 1.0f;
+
     TagPanel tagPanel;
     TransformPanel transformPanel;
     MaterialPanel materialPanel;
@@ -59,6 +72,14 @@ private:
 
     void RenderCreateEntityTab();
 
+    void RenderStatsTab(const RenderStats &stats);
+
+    void RenderModuleTimings(const ModuleManager &moduleManager);
+
+    void RenderTextureStats(const TextureManager &textureManager);
+
+    void RenderProfilerTab();
+
     void RenderOpenModelDialog();
 
     inline void Execute(const char *name, const CommandArgs &args) {
@@ -71,6 +71,11 @@ bool UIModule::IsRequired() const {
     return true;
 }
 
+ModuleAccess UIModule::GetAccess() const {
+    // ImGui frames are built in Engine::OnRender
+    return {};
+}
+
 ImGuiManager *UIModule::GetImGuiManager() {
     return imGuiManager.get();
 }
\ No newline at end of file
@@ -41,6 +41,8 @@ public:
 
     bool IsRequired() const override;
 
+    ModuleAccess GetAccess() const override;
+
     /// }@
 
     //EditorLayout* GetEditorLayout() { return editorLayout.get(); }
@@ -8,17 +8,24 @@ void TransformPanel::Render(ECSWorld *ecs, entt::entity entity) {
 
     auto &transform = ecs->GetComponent<TransformComponent>(entity);
 
+    bool changed = false;
+
     ImGui::Text("Position");
-    ImGui::DragFloat3("##Pos", &transform.position[0], 0.1f);
+    changed |= ImGui::DragFloat3("##Pos", &transform.position[0], 0.1f);
 
     ImGui::Spacing();
     ImGui::Separator();
     ImGui::Text("Rotation");
-    if (ImGui::DragFloat3("##Rot", &transform.eulerHint[0], 1.0f))
+    if (ImGui::DragFloat3("##Rot", &transform.eulerHint[0], 1.0f)) {
         transform.rotation = glm::quat(glm::radians(transform.eulerHint));
+        changed = true;
+    }
 
     ImGui::Spacing();
     ImGui::Separator();
     ImGui::Text("Scale");
-    ImGui::DragFloat3("##Scale", &transform.scale[0], 0.1f);
+    changed |= ImGui::DragFloat3("##Scale", &transform.scale[0], 0.1f);
+
+    if (changed)
+        ecs->MarkTransformDirty(entity);
 }
\ No newline at end of file
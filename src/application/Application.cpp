@@ -1,4 +1,5 @@
 #include "Application.h"
+#include "core/Profiler.h"
 #include "core/logging/Logger.h"
 
 void Application::Update() {
@@ -7,10 +8,13 @@ void Application::Update() {
     OnUpdate(deltaTime);
 }
 
-Application::Application(int width, int height, const std::string &title)
+Application::Application(int width, int height, const std::string &title, bool headless)
     : window(nullptr), input(nullptr), time(nullptr),
       isRunning(false) {
-    window = std::make_unique<Window>(width, height, title);
+    window = std::make_unique<Window>(width, height, title, headless);
+
+    // Registers this thread first, so it is thread 0 in every profile
+    Profiler::Get().SetThreadName("Main");
 
     Logger::Log(LogLevel::INFO, "Application created");
 }
@@ -35,6 +39,7 @@ bool Application::Initialize() {
 
     Logger::AddSink(&console);
     // Logger::AddSink(&file);
+    Logger::StartAsync();
 
     OnInitialize();
 
@@ -46,14 +51,27 @@ bool Application::Initialize() {
 void Application::Run() {
     isRunning = true;
 
+    Profiler &profiler = Profiler::Get();
+
     while (isRunning && !window->ShouldClose()) {
+        profiler.BeginFrame();
         time->Update();
 
-        Update();
-        OnRender();
-
-        window->SwapBuffers();
-        window->PollEvents();
+        {
+            PROFILE_SCOPE("Update");
+            Update();
+        }
+        {
+            PROFILE_SCOPE("Render");
+            OnRender();
+        }
+        {
+            PROFILE_SCOPE("SwapBuffers");
+            window->SwapBuffers();
+            window->PollEvents();
+        }
+
+        profiler.EndFrame();
     }
 }
 
@@ -64,6 +82,7 @@ void Application::Shutdown() {
     // Logger::RemoveSink(&file);
 
     Logger::Log(LogLevel::INFO, "Application shutdown complete");
+    Logger::Shutdown();
 }
 
 void Application::Stop() {
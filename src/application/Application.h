@@ -48,8 +48,9 @@ protected:
      * @param title Window title
      * @param width Window width in pixels
      * @param height Window height in pixels
+     * @param headless Create an invisible window and render offscreen
      */
-    Application(int width, int height, const std::string &title);
+    Application(int width, int height, const std::string &title, bool headless = false);
 
     virtual void OnInitialize() {
     }
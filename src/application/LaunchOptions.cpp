@@ -0,0 +1,60 @@
+#include "LaunchOptions.h"
+#include <algorithm>
+#include "core/logging/Logger.h"
+
+namespace {
+    bool ReadInt(const std::string &flag, const char *value, int &out) {
+        try {
+            out = std::stoi(value);
+            return true;
+        } catch (...) {
+            Logger::Log(LogLevel::WARNING, "Invalid value for " + flag + ": " + value);
+            return false;
+        }
+    }
+}
+
+LaunchOptions LaunchOptions::Parse(int argc, char **argv) {
+    LaunchOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string flag = argv[i];
+
+        if (flag == "--headless") {
+            options.headless = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            Logger::Log(LogLevel::WARNING, "Ignoring argument: " + flag);
+            continue;
+        }
+
+        const char *value = argv[i + 1];
+        if (flag == "--scene")
+            options.scene = value;
+        else if (flag == "--output")
+            options.outputDir = value;
+        else if (flag == "--width")
+            ReadInt(flag, value, options.width);
+        else if (flag == "--height")
+            ReadInt(flag, value, options.height);
+        else if (flag == "--frames")
+            ReadInt(flag, value, options.frames);
+        else if (flag == "--dump-every")
+            ReadInt(flag, value, options.dumpEvery);
+        else if (flag == "--run")
+            options.commands.push_back(value);
+        else {
+            Logger::Log(LogLevel::WARNING, "Ignoring argument: " + flag);
+            continue;
+        }
+        i++;
+    }
+
+    options.width = std::max(options.width, 1);
+    options.height = std::max(options.height, 1);
+    options.frames = std::max(options.frames, 1);
+    options.dumpEvery = std::max(options.dumpEvery, 1);
+    return options;
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// @file LaunchOptions.h
+/// @brief Command-line options read before the window exists
+
+/**
+ * @struct LaunchOptions
+ * @brief What main() was asked to do
+ *
+ * Recognised flags:
+ * - `--headless`            render offscreen without a visible window
+ * - `--scene <name>`        scene to load after startup (same names as onLoadScene)
+ * - `--width <px>`, `--height <px>`
+ * - `--frames <n>`          frames to render before a headless run exits
+ * - `--output <dir>`        write rendered frames there as PPM images
+ * - `--dump-every <n>`      only write every n-th frame
+ * - `--run "<command> [args]"` run a registered command once the scene is loaded; repeatable
+ */
+struct LaunchOptions {
+    bool headless = false;
+    int width = 1020;
+    int height = 800;
+    int frames = 60;
+    int dumpEvery = 1;
+    std::string scene;
+    std::string outputDir;
+    /// In order; arguments are split on spaces and read as int, float or string
+    std::vector<std::string> commands;
+
+    /// Unknown or malformed flags are logged and skipped
+    static LaunchOptions Parse(int argc, char **argv);
+};
\ No newline at end of file
@@ -17,6 +17,7 @@ std::variant<
     float,
     std::string,
     glm::vec3,
+    glm::vec4,
     glm::mat4,
     std::vector<glm::mat4>,
     std::vector<int>,
@@ -27,13 +28,67 @@ std::variant<
 using CommandArgs = std::vector<CommandArg>;
 using CommandFn = std::function<void(const CommandArgs &)>;
 
+/// Target of a typed command: a tag type with a nested `Args` struct and a `NAME` for diagnostics
+template<typename Command>
+using CommandDelegate = entt::delegate<void(const typename Command::Args &)>;
+
+/**
+ * @class CommandManager
+ * @brief Name-keyed commands for the editor, console and scripts, plus typed commands for engine hot paths
+ *
+ * A typed command is identified by its tag type at compile time and has exactly one
+ * target. Execute<T>() calls it through a delegate with a caller-built Args, so nothing
+ * is hashed, copied into variants or allocated.
+ */
 class CommandManager {
     static std::unordered_map<std::string, CommandFn> commands;
 
+    template<typename Command>
+    inline static CommandDelegate<Command> typedCommands{};
+
+    static void ReportMissing(const char *name);
+
 public:
     static void RegisterCommand(const std::string &name, CommandFn fn);
 
     static void ExecuteCommand(const std::string &name, const CommandArgs &args);
 
     static bool HasCommand(const std::string &name);
-};
\ No newline at end of file
+
+    /**
+     * @brief Bind @p Candidate to @p instance as the target of @p Command
+     *
+     * @p Candidate is a member function of @p instance, or a free function taking it as
+     * its first parameter. Binding again replaces the previous target, so a recreated
+     * owner never leaves the command pointing at a destroyed one.
+     */
+    template<typename Command, auto Candidate, typename Type>
+    static void Register(Type &instance) {
+        typedCommands<Command>.template connect<Candidate>(instance);
+    }
+
+    template<typename Command>
+    static void Unregister() {
+        typedCommands<Command>.reset();
+    }
+
+    template<typename Command>
+    static bool Has() {
+        return static_cast<bool>(typedCommands<Command>);
+    }
+
+    template<typename Command>
+    static void Execute(const typename Command::Args &args) {
+        if (const CommandDelegate<Command> &target = typedCommands<Command>)
+            target(args);
+        else
+            ReportMissing(Command::NAME);
+    }
+};
+
+/**
+ * @brief Log the per-call cost of a string-keyed command against a typed one carrying the same geometry-pass payload
+ *
+ * Registered as the "Commands_Benchmark" command.
+ */
+void BenchmarkCommandDispatch();
\ No newline at end of file
@@ -1,21 +1,142 @@
 #pragma once
 
-#include <string>
-#include <unordered_map>
-#include <vector>
-#include <any>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "core/MPSCQueue.h"
 
+/// Dense per-type index, interned the first time an event type is used
+using EventId = uint32_t;
+
+/**
+ * @class EventBus
+ * @brief Typed publish/subscribe: the event struct's type is its key
+ *
+ * Subscribe() and Publish() belong to the thread that owns the bus and call handlers
+ * immediately. Enqueue() may be called from any thread: it copies the event into a
+ * lock-free queue that DispatchQueued() delivers, in order, wherever the frame drains it.
+ */
 class EventBus {
-    using Callback = std::function<void(const std::any &)>;
-    std::unordered_map<std::string, std::vector<Callback> > m_Subscribers;
+public:
+    static constexpr size_t MAX_QUEUED_EVENT_SIZE = 48;
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 16384;
+
+private:
+    struct ChannelBase {
+        virtual ~ChannelBase() = default;
+
+        virtual void DispatchRaw(const void *payload) = 0;
+    };
+
+    template<typename T>
+    struct Channel : ChannelBase {
+        /// A deque never relocates handlers, so a running handler survives another Subscribe()
+        std::deque<std::function<void(const T &)> > handlers;
+
+        void Dispatch(const T &event) {
+            // Handlers subscribed during dispatch start with the next event
+            const size_t count = handlers.size();
+            for (size_t i = 0; i < count; i++)
+                handlers[i](event);
+        }
+
+        void DispatchRaw(const void *payload) override {
+            Dispatch(*std::launder(static_cast<const T *>(payload)));
+        }
+    };
+
+    struct QueuedEvent {
+        EventId id = 0;
+        alignas(std::max_align_t) std::byte payload[MAX_QUEUED_EVENT_SIZE];
+    };
+
+    std::vector<std::unique_ptr<ChannelBase> > m_Channels;
+    MPSCQueue<QueuedEvent> m_Queue;
+    std::atomic<std::thread::id> m_DispatchThread{};
+
+    static EventId NextEventId();
+
+    template<typename T>
+    Channel<T> *FindChannel() {
+        const EventId id = GetEventId<T>();
+        return id < m_Channels.size() ? static_cast<Channel<T> *>(m_Channels[id].get()) : nullptr;
+    }
 
 public:
-    void RegisterEvent(const std::string &name);
+    explicit EventBus(size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
+
+    template<typename T>
+    static EventId GetEventId() {
+        static const EventId id = NextEventId();
+        return id;
+    }
+
+    template<typename T>
+    void Subscribe(std::function<void(const T &)> handler) {
+        const EventId id = GetEventId<T>();
+        if (id >= m_Channels.size())
+            m_Channels.resize(id + 1);
+        if (!m_Channels[id])
+            m_Channels[id] = std::make_unique<Channel<T> >();
 
-    void Subscribe(const std::string &name, Callback callback);
+        static_cast<Channel<T> *>(m_Channels[id].get())->handlers.push_back(std::move(handler));
+    }
 
-    void Publish(const std::string &name, const std::any &payload = {});
+    /// Calls every handler now, on the calling thread
+    template<typename T>
+    void Publish(const T &event) {
+        if (Channel<T> *channel = FindChannel<T>())
+            channel->Dispatch(event);
+    }
+
+    /**
+     * @brief Queue @p event for the next DispatchQueued(); safe from any thread
+     *
+     * Waits while the queue is full. The draining thread cannot wait for itself, so
+     * there a full queue delivers the event immediately instead.
+     */
+    template<typename T>
+    void Enqueue(const T &event) {
+        static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= MAX_QUEUED_EVENT_SIZE &&
+                      alignof(T) <= alignof(std::max_align_t),
+                      "Queued events are copied as bytes: keep them small and trivially copyable");
+
+        QueuedEvent queued;
+        queued.id = GetEventId<T>();
+        std::memcpy(queued.payload, &event, sizeof(T));
+
+        while (!m_Queue.TryPush(queued)) {
+            if (std::this_thread::get_id() == m_DispatchThread.load(std::memory_order_relaxed)) {
+                Publish(event);
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Deliver everything queued before the call, on the calling thread
+     *
+     * Events that handlers queue meanwhile wait for the next call.
+     * @return Events delivered
+     */
+    size_t DispatchQueued();
 };
 
 EventBus &GetEventBus();
+
+/**
+ * @brief Log events per second for direct publishing and for four threads feeding the queue
+ *
+ * Registered as the "Events_Benchmark" command.
+ */
+void BenchmarkEventBus();
\ No newline at end of file
@@ -1,5 +1,62 @@
 #pragma once
 
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+/**
+ * @brief What a module's Update() touches, so ModuleManager can order and overlap updates
+ *
+ * Modules that declare nothing are treated as exclusive: they are ordered against
+ * every other module and run on the main thread.
+ */
+struct ModuleAccess {
+    struct Component {
+        entt::id_type id;
+        std::string_view name;
+    };
+
+    std::vector<Component> reads;
+    std::vector<Component> writes;
+
+    /// Modules (by GetName()) whose Update() must finish before this one starts
+    std::vector<std::string> after;
+
+    bool exclusive = false;
+    bool mainThread = true;
+
+    template<typename... T>
+    ModuleAccess &Read() {
+        (reads.push_back({entt::type_hash<T>::value(), entt::type_name<T>::value()}), ...);
+        return *this;
+    }
+
+    template<typename... T>
+    ModuleAccess &Write() {
+        (writes.push_back({entt::type_hash<T>::value(), entt::type_name<T>::value()}), ...);
+        return *this;
+    }
+
+    ModuleAccess &After(const std::string &module) {
+        after.push_back(module);
+        return *this;
+    }
+
+    /// Update() may run on a worker thread
+    ModuleAccess &AnyThread() {
+        mainThread = false;
+        return *this;
+    }
+
+    static ModuleAccess Exclusive() {
+        ModuleAccess access;
+        access.exclusive = true;
+        return access;
+    }
+};
+
 class IModule {
 protected:
     bool isInitialized = false;
@@ -19,5 +76,7 @@ public:
 
     virtual bool IsRequired() const = 0;
 
+    virtual ModuleAccess GetAccess() const { return ModuleAccess::Exclusive(); }
+
     bool IsInitialized() const { return isInitialized; };
-};
+};
\ No newline at end of file
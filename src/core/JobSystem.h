@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobCounter;
+
+struct Job {
+    std::function<void()> task;
+    JobCounter *counter = nullptr;
+};
+
+/**
+ * @class JobCounter
+ * @brief Counts unfinished jobs; reaches zero once every job scheduled against it has run
+ *
+ * Jobs scheduled with this counter as their dependency are held back until then.
+ * A counter must outlive JobSystem::Wait() on it.
+ */
+class JobCounter {
+    friend class JobSystem;
+
+    std::atomic<int> pending{0};
+    std::mutex mutex;
+    std::vector<Job> continuations;
+
+public:
+    bool IsDone() const {
+        return pending.load(std::memory_order_acquire) == 0;
+    }
+};
+
+/**
+ * @class JobSystem
+ * @brief Fixed pool of worker threads, each with its own job deque
+ *
+ * A worker pops its own deque LIFO (cache-warm) and steals FIFO from the others
+ * when it runs dry. Jobs scheduled from non-worker threads go to a shared deque.
+ * A thread blocked in Wait() keeps running jobs instead of sleeping.
+ *
+ * Long blocking work (file IO, model imports) goes through ScheduleBackground() to a
+ * thread of its own that Wait() and RunPendingJob() never drain, so it cannot land
+ * on the main thread mid-frame or hold a worker that frame jobs are waiting for.
+ *
+ * Before Initialize() (or after Shutdown()) jobs run inline on the calling thread.
+ */
+class JobSystem {
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    /// Slot 0 is the shared queue for external threads; worker i owns slot i + 1
+    std::vector<std::unique_ptr<WorkQueue> > queues;
+    std::vector<std::thread> workers;
+
+    std::atomic<bool> running{false};
+    std::atomic<int> queuedJobs{0};
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    std::thread background;
+    std::mutex backgroundMutex;
+    std::condition_variable backgroundWake;
+    std::deque<std::function<void()> > backgroundJobs;
+    bool backgroundStopping = false;
+
+    void Push(Job job);
+
+    void Execute(Job &job);
+
+    void WorkerLoop(size_t queueIndex);
+
+    void BackgroundLoop();
+
+public:
+    ~JobSystem();
+
+    /// @param workerCount 0 picks hardware_concurrency() - 1
+    void Initialize(size_t workerCount = 0);
+
+    void Shutdown();
+
+    /**
+     * @param counter Incremented now, decremented when the job finishes
+     * @param dependency Job is not started before this counter reaches zero
+     */
+    void Schedule(std::function<void()> task, JobCounter *counter = nullptr,
+                  JobCounter *dependency = nullptr);
+
+    /// Run @p task on the background thread, in submission order; never picked up by Wait() helpers
+    void ScheduleBackground(std::function<void()> task);
+
+    /// Blocks until @p counter reaches zero, running queued jobs meanwhile
+    void Wait(JobCounter &counter);
+
+    /// Run one queued job on the calling thread, if any; for callers with their own wait loop
+    bool RunPendingJob();
+
+    /**
+     * @brief Split [0, count) into chunks of at least @p grain and run them across workers
+     * @param func Called as func(begin, end); must be safe to run concurrently on disjoint ranges
+     */
+    template<typename Func>
+    void ParallelFor(size_t count, size_t grain, Func &&func) {
+        if (count == 0)
+            return;
+
+        grain = std::max<size_t>(grain, 1);
+
+        if (!running || count <= grain) {
+            func(size_t{0}, count);
+            return;
+        }
+
+        // No point splitting finer than the number of threads that can take a chunk
+        const size_t threads = workers.size() + 1;
+        const size_t chunk = std::max(grain, (count + threads * 4 - 1) / (threads * 4));
+
+        JobCounter counter;
+        size_t begin = 0;
+        for (; begin + chunk < count; begin += chunk) {
+            const size_t end = begin + chunk;
+            Schedule([&func, begin, end] { func(begin, end); }, &counter);
+        }
+
+        func(begin, count);
+        Wait(counter);
+    }
+
+    size_t GetWorkerCount() const;
+
+    bool IsRunning() const;
+};
+
+JobSystem &GetJobSystem();
+
+/**
+ * @brief Log per-job scheduling overhead and ParallelFor speedup against a serial loop
+ *
+ * Registered as the "Jobs_Benchmark" command.
+ */
+void BenchmarkJobSystem();
\ No newline at end of file
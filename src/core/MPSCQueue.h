@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @class MPSCQueue
+ * @brief Bounded multi-producer, single-consumer ring that never locks
+ *
+ * Each slot's sequence number says whose turn it is, so producers only race on a
+ * compare-exchange of the write position. Pops must come from one thread at a time.
+ */
+template<typename T>
+class MPSCQueue {
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        T data;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask = 0;
+    std::atomic<uint64_t> enqueuePos{0};
+    uint64_t dequeuePos = 0;
+
+public:
+    /// @param capacity rounded up to a power of two
+    explicit MPSCQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+
+        slots = std::make_unique<Slot[]>(size);
+        mask = size - 1;
+        for (size_t i = 0; i < size; i++)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /// Moves from @p data only on success
+    bool TryPush(T &data) {
+        uint64_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+
+        for (;;) {
+            slot = &slots[pos & mask];
+            const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<int64_t>(sequence - pos);
+
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->data = std::move(data);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side only
+    bool TryPop(T &out) {
+        Slot &slot = slots[dequeuePos & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+            return false;
+
+        out = std::move(slot.data);
+        slot.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+        dequeuePos++;
+        return true;
+    }
+
+    /// Slots claimed so far, including ones a producer is still filling
+    uint64_t GetEnqueued() const {
+        return enqueuePos.load(std::memory_order_acquire);
+    }
+
+    /// Consumer side only
+    uint64_t GetDequeued() const {
+        return dequeuePos;
+    }
+};
\ No newline at end of file
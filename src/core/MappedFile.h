@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The contents stay valid until the object is destroyed or Close() is called.
+ */
+class MappedFile {
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+
+#if defined(_WIN32)
+    void *fileHandle = nullptr;
+    void *mappingHandle = nullptr;
+#endif
+
+public:
+    MappedFile() = default;
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /// @return false if the file is missing, empty or cannot be mapped
+    bool Open(const std::string &path);
+
+    void Close();
+
+    bool IsOpen() const;
+
+    const uint8_t *GetData() const;
+
+    size_t GetSize() const;
+};
\ No newline at end of file
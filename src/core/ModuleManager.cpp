@@ -1,10 +1,21 @@
 #include "ModuleManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
 #include "core/logging/Logger.h"
 
 void ModuleManager::InitializeAll() {
     std::sort(modules.begin(), modules.end(), [](auto &a, auto &b) {
         return a->GetPriority() < b->GetPriority();
     });
+    graphDirty = true;
 
     for (auto &module: modules) {
         Logger::Log(LogLevel::INFO, std::string("Initializing ") + module->GetName() + "...");
@@ -23,8 +34,76 @@ void ModuleManager::InitializeAll() {
 }
 
 void ModuleManager::UpdateAll(float deltaTime) {
-    for (auto &module: modules)
-        module->Update(deltaTime);
+    using Clock = std::chrono::high_resolution_clock;
+
+    if (graphDirty)
+        BuildGraph();
+
+    const size_t count = nodes.size();
+    if (count == 0)
+        return;
+
+    const auto frameStart = Clock::now();
+
+    JobSystem &jobs = GetJobSystem();
+    JobCounter workerJobs;
+    std::atomic<size_t> finished{0};
+
+    std::mutex mainMutex;
+    std::deque<size_t> mainReady;
+
+    for (size_t i = 0; i < count; i++)
+        remaining[i].store(nodes[i].dependencies, std::memory_order_relaxed);
+
+    std::function<void(size_t)> dispatch;
+
+    auto run = [&](size_t i) {
+        const auto start = Clock::now();
+        {
+            PROFILE_SCOPE(modules[nodes[i].module]->GetName());
+            modules[nodes[i].module]->Update(deltaTime);
+        }
+        timings[i].updateMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+        for (size_t next: nodes[i].successors)
+            if (remaining[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                dispatch(next);
+
+        finished.fetch_add(1, std::memory_order_release);
+    };
+
+    dispatch = [&](size_t i) {
+        if (nodes[i].access.mainThread || !jobs.IsRunning()) {
+            std::lock_guard<std::mutex> lock(mainMutex);
+            mainReady.push_back(i);
+        } else {
+            jobs.Schedule([&run, i] { run(i); }, &workerJobs);
+        }
+    };
+
+    for (size_t i = 0; i < count; i++)
+        if (nodes[i].dependencies == 0)
+            dispatch(i);
+
+    while (finished.load(std::memory_order_acquire) < count) {
+        size_t next = count;
+        {
+            std::lock_guard<std::mutex> lock(mainMutex);
+            if (!mainReady.empty()) {
+                next = mainReady.front();
+                mainReady.pop_front();
+            }
+        }
+
+        if (next != count)
+            run(next);
+        else if (!jobs.RunPendingJob())
+            std::this_thread::yield();
+    }
+
+    jobs.Wait(workerJobs);
+
+    lastUpdateMs = std::chrono::duration<float, std::milli>(Clock::now() - frameStart).count();
 }
 
 void ModuleManager::ShutdownAll() {
@@ -32,7 +111,128 @@ void ModuleManager::ShutdownAll() {
         module->Shutdown();
 }
 
+void ModuleManager::CheckConflicts(const IModule &module) const {
+    const ModuleAccess access = module.GetAccess();
+
+    for (const auto &existing: modules) {
+        const ModuleAccess other = existing->GetAccess();
+
+        const bool ordered =
+                std::find(access.after.begin(), access.after.end(), existing->GetName()) != access.after.end() ||
+                std::find(other.after.begin(), other.after.end(), module.GetName()) != other.after.end();
+        if (ordered)
+            continue;
+
+        for (const auto &write: access.writes)
+            for (const auto &otherWrite: other.writes)
+                if (write.id == otherWrite.id)
+                    Logger::Log(LogLevel::WARNING,
+                                std::string("ModuleManager: ") + module.GetName() + " and " +
+                                existing->GetName() + " both write " + std::string(write.name) +
+                                " with no After() between them; falling back to priority order");
+    }
+}
+
+void ModuleManager::BuildGraph() {
+    std::vector<size_t> order(modules.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return modules[a]->GetPriority() < modules[b]->GetPriority();
+    });
+
+    nodes.clear();
+    timings.clear();
+    for (size_t index: order) {
+        nodes.push_back({index, modules[index]->GetAccess(), {}, 0});
+        timings.push_back({modules[index]->GetName(), 0.0f, nodes.back().access.mainThread});
+    }
+
+    auto touches = [](const std::vector<ModuleAccess::Component> &list, entt::id_type id) {
+        return std::any_of(list.begin(), list.end(), [id](const auto &c) { return c.id == id; });
+    };
+
+    auto conflicts = [&](const ModuleAccess &a, const ModuleAccess &b) {
+        if (a.exclusive || b.exclusive)
+            return true;
+        for (const auto &w: a.writes)
+            if (touches(b.writes, w.id) || touches(b.reads, w.id))
+                return true;
+        for (const auto &w: b.writes)
+            if (touches(a.reads, w.id))
+                return true;
+        return false;
+    };
+
+    auto runsAfter = [](const ModuleAccess &access, const char *name) {
+        return std::find(access.after.begin(), access.after.end(), name) != access.after.end();
+    };
+
+    std::vector<std::vector<bool> > edge(nodes.size(), std::vector<bool>(nodes.size(), false));
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        for (size_t j = i + 1; j < nodes.size(); j++) {
+            const char *nameI = modules[nodes[i].module]->GetName();
+            const char *nameJ = modules[nodes[j].module]->GetName();
+
+            // Explicit ordering wins over priority; conflicts otherwise keep priority order
+            if (runsAfter(nodes[i].access, nameJ))
+                edge[j][i] = true;
+            else if (runsAfter(nodes[j].access, nameI) || conflicts(nodes[i].access, nodes[j].access))
+                edge[i][j] = true;
+        }
+    }
+
+    for (size_t i = 0; i < nodes.size(); i++)
+        for (size_t j = 0; j < nodes.size(); j++)
+            if (edge[i][j]) {
+                nodes[i].successors.push_back(j);
+                nodes[j].dependencies++;
+            }
+
+    // Kahn's algorithm, only to reject cycles built from After() declarations
+    std::vector<int> indegree(nodes.size());
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        indegree[i] = nodes[i].dependencies;
+        if (indegree[i] == 0)
+            ready.push_back(i);
+    }
+
+    size_t visited = 0;
+    while (!ready.empty()) {
+        size_t i = ready.back();
+        ready.pop_back();
+        visited++;
+        for (size_t next: nodes[i].successors)
+            if (--indegree[next] == 0)
+                ready.push_back(next);
+    }
+
+    if (visited != nodes.size()) {
+        Logger::Log(LogLevel::ERROR, "ModuleManager: module dependencies form a cycle; updating serially");
+        for (size_t i = 0; i < nodes.size(); i++) {
+            nodes[i].successors.clear();
+            nodes[i].dependencies = i == 0 ? 0 : 1;
+            if (i + 1 < nodes.size())
+                nodes[i].successors.push_back(i + 1);
+        }
+    }
+
+    remaining = std::make_unique<std::atomic<int>[]>(nodes.size());
+    graphDirty = false;
+}
+
 bool ModuleManager::IsModuleActive(const std::string &name) const {
     auto it = moduleMap.find(name);
     return it != moduleMap.end();
+}
+
+const std::vector<ModuleTiming> &ModuleManager::GetTimings() const {
+    return timings;
+}
+
+float ModuleManager::GetLastUpdateMs() const {
+    return lastUpdateMs;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <map>
 #include <memory>
@@ -8,17 +9,51 @@
 #include "core/IModule.h"
 #include "core/Time.h"
 
+struct ModuleTiming {
+    std::string name;
+    float updateMs = 0.0f;
+    bool mainThread = true;
+};
+
+/**
+ * @class ModuleManager
+ * @brief Owns the engine modules and updates them as a dependency graph
+ *
+ * Edges come from ModuleAccess: explicit After() names, plus priority order
+ * between modules whose component access conflicts. Modules with no path
+ * between them update concurrently on the job system; main-thread modules
+ * always run on the caller of UpdateAll().
+ */
 class ModuleManager {
+    struct Node {
+        size_t module;
+        ModuleAccess access;
+        std::vector<size_t> successors;
+        int dependencies = 0;
+    };
+
     std::vector<std::unique_ptr<IModule> > modules;
     std::map<std::string, IModule *> moduleMap;
 
+    std::vector<Node> nodes;
+    std::unique_ptr<std::atomic<int>[]> remaining;
+    std::vector<ModuleTiming> timings;
+    float lastUpdateMs = 0.0f;
+    bool graphDirty = true;
+
+    void CheckConflicts(const IModule &module) const;
+
+    void BuildGraph();
+
 public:
     template<typename T, typename... Args>
     T *RegisterModule(Args &&... args) {
         auto module = std::make_unique<T>(std::forward<Args>(args)...);
         T *ptr = module.get();
+        CheckConflicts(*ptr);
         moduleMap[module->GetName()] = ptr;
         modules.push_back(std::move(module));
+        graphDirty = true;
         return ptr;
     }
 
@@ -37,4 +72,10 @@ public:
     }
 
     bool IsModuleActive(const std::string &name) const;
+
+    /// Per-module Update() time of the last UpdateAll(), in graph order
+    const std::vector<ModuleTiming> &GetTimings() const;
+
+    /// Wall time of the last UpdateAll()
+    float GetLastUpdateMs() const;
 };
\ No newline at end of file
@@ -0,0 +1,226 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include "core/logging/Logger.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const Clock::time_point g_Epoch = Clock::now();
+
+    thread_local uint32_t t_Depth = 0;
+}
+
+Profiler &Profiler::Get() {
+    static Profiler profiler;
+    return profiler;
+}
+
+uint64_t Profiler::Now() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - g_Epoch).count());
+}
+
+void Profiler::SetEnabled(bool enable) {
+    enabled.store(enable, std::memory_order_relaxed);
+    Logger::Log(LogLevel::INFO, std::string("Profiler ") + (enable ? "enabled" : "disabled"));
+}
+
+void Profiler::SetPaused(bool pause) {
+    paused = pause;
+}
+
+bool Profiler::IsPaused() const {
+    return paused;
+}
+
+Profiler::ThreadBuffer &Profiler::GetThreadBuffer() {
+    // Buffers are never freed, so the cached pointer stays valid even after the thread is gone
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (buffer)
+        return *buffer;
+
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    auto owned = std::make_unique<ThreadBuffer>();
+    owned->id = static_cast<uint32_t>(threads.size());
+    owned->name = owned->id == 0 ? "Main" : "Thread " + std::to_string(owned->id);
+    buffer = owned.get();
+    threads.push_back(std::move(owned));
+    return *buffer;
+}
+
+void Profiler::SetThreadName(const std::string &name) {
+    ThreadBuffer &buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    buffer.name = name;
+}
+
+const char *Profiler::Intern(const std::string &name) {
+    std::lock_guard<std::mutex> lock(internMutex);
+    return interned.insert(name).first->c_str();
+}
+
+void Profiler::Record(const char *name, uint64_t startNs, uint64_t endNs, uint32_t depth) {
+    ThreadBuffer &buffer = GetThreadBuffer();
+
+    const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    if (head - buffer.tail.load(std::memory_order_acquire) >= RING_CAPACITY) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[head % RING_CAPACITY] = {name, startNs, endNs, depth};
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::RecordGpu(const char *name, uint64_t cpuStartNs, uint64_t durationNs) {
+    std::lock_guard<std::mutex> lock(gpuMutex);
+    pendingGpu.push_back({name, cpuStartNs, durationNs});
+}
+
+void Profiler::BeginFrame() {
+    frameStartNs = Now();
+}
+
+void Profiler::EndFrame() {
+    ProfileFrame frame;
+    frame.index = frameIndex++;
+    frame.startNs = frameStartNs;
+    frame.endNs = Now();
+
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        for (auto &buffer: threads) {
+            const uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+            const uint64_t head = buffer->head.load(std::memory_order_acquire);
+            frame.dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+            if (head == tail)
+                continue;
+
+            ProfileThreadEvents thread{buffer->id, buffer->name, {}};
+            thread.events.reserve(head - tail);
+            for (uint64_t i = tail; i < head; i++)
+                thread.events.push_back(buffer->events[i % RING_CAPACITY]);
+            buffer->tail.store(head, std::memory_order_release);
+
+            frame.threads.push_back(std::move(thread));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(gpuMutex);
+        frame.gpu.swap(pendingGpu);
+    }
+
+    if (frame.dropped > 0)
+        Logger::Log(LogLevel::WARNING, "Profiler: dropped " + std::to_string(frame.dropped) + " events");
+
+    if (captureRemaining > 0) {
+        capture.push_back(frame);
+        if (--captureRemaining == 0) {
+            if (ExportChromeTrace(capture, capturePath))
+                Logger::Log(LogLevel::INFO, "Profiler: wrote " + std::to_string(capture.size()) +
+                                            " frames to " + capturePath);
+            capture.clear();
+        }
+    }
+
+    if (!paused)
+        lastFrame = std::move(frame);
+}
+
+const ProfileFrame &Profiler::GetLastFrame() const {
+    return lastFrame;
+}
+
+void Profiler::StartCapture(int frames, const std::string &path) {
+    if (frames <= 0 || path.empty())
+        return;
+
+    if (!IsEnabled())
+        SetEnabled(true);
+
+    capture.clear();
+    capture.reserve(frames);
+    captureRemaining = frames;
+    capturePath = path;
+    Logger::Log(LogLevel::INFO, "Profiler: capturing " + std::to_string(frames) + " frames");
+}
+
+bool Profiler::IsCapturing() const {
+    return captureRemaining > 0;
+}
+
+bool Profiler::ExportChromeTrace(const std::vector<ProfileFrame> &frames, const std::string &path) {
+    using json = nlohmann::json;
+
+    // Chrome's trace viewer wants microseconds; the GPU gets a track of its own
+    constexpr uint32_t GPU_TID = 1000;
+    auto micros = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+
+    json events = json::array();
+    std::unordered_set<uint32_t> named;
+
+    auto nameThread = [&](uint32_t tid, const std::string &name) {
+        if (!named.insert(tid).second)
+            return;
+        events.push_back({
+            {"ph", "M"}, {"name", "thread_name"}, {"pid", 1}, {"tid", tid}, {"args", {{"name", name}}}
+        });
+    };
+
+    for (const ProfileFrame &frame: frames) {
+        nameThread(0, "Main");
+        events.push_back({
+            {"ph", "X"}, {"name", "Frame " + std::to_string(frame.index)}, {"cat", "frame"},
+            {"pid", 1}, {"tid", 0}, {"ts", micros(frame.startNs)}, {"dur", micros(frame.endNs - frame.startNs)}
+        });
+
+        for (const ProfileThreadEvents &thread: frame.threads) {
+            nameThread(thread.threadId, thread.threadName);
+            for (const ProfileEvent &event: thread.events)
+                events.push_back({
+                    {"ph", "X"}, {"name", event.name}, {"cat", "cpu"}, {"pid", 1}, {"tid", thread.threadId},
+                    {"ts", micros(event.startNs)}, {"dur", micros(event.endNs - event.startNs)}
+                });
+        }
+
+        if (!frame.gpu.empty())
+            nameThread(GPU_TID, "GPU");
+        for (const GpuProfileEvent &event: frame.gpu)
+            events.push_back({
+                {"ph", "X"}, {"name", event.name}, {"cat", "gpu"}, {"pid", 1}, {"tid", GPU_TID},
+                {"ts", micros(event.cpuStartNs)}, {"dur", micros(event.durationNs)}
+            });
+    }
+
+    std::ofstream out(path);
+    if (!out) {
+        Logger::Log(LogLevel::ERROR, "Profiler: cannot write " + path);
+        return false;
+    }
+
+    out << json{{"traceEvents", events}, {"displayTimeUnit", "ms"}}.dump();
+    return static_cast<bool>(out);
+}
+
+ProfileScope::ProfileScope(const char *name)
+    : name(name)
+      , active(Profiler::Get().IsEnabled()) {
+    if (!active)
+        return;
+
+    depth = t_Depth++;
+    startNs = Profiler::Now();
+}
+
+ProfileScope::~ProfileScope() {
+    if (!active)
+        return;
+
+    const uint64_t endNs = Profiler::Now();
+    t_Depth--;
+    Profiler::Get().Record(name, startNs, endNs, depth);
+}
\ No newline at end of file
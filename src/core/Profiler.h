@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/// A finished CPU scope; names must outlive the profiler (literals or Profiler::Intern)
+struct ProfileEvent {
+    const char *name;
+    uint64_t startNs;
+    uint64_t endNs;
+    uint32_t depth;
+};
+
+/// GL_TIME_ELAPSED has no start time, so GPU work is placed where the CPU issued it
+struct GpuProfileEvent {
+    const char *name;
+    uint64_t cpuStartNs;
+    uint64_t durationNs;
+};
+
+struct ProfileThreadEvents {
+    uint32_t threadId;
+    std::string threadName;
+    std::vector<ProfileEvent> events;
+};
+
+struct ProfileFrame {
+    uint64_t index = 0;
+    uint64_t startNs = 0;
+    uint64_t endNs = 0;
+    std::vector<ProfileThreadEvents> threads;
+    std::vector<GpuProfileEvent> gpu;
+    uint32_t dropped = 0;
+};
+
+/**
+ * @class Profiler
+ * @brief Collects nested CPU scopes from every thread and GPU pass timings, one frame at a time
+ *
+ * Each thread records into its own fixed ring that only it writes and only
+ * EndFrame() reads, so recording a scope takes no lock. Events that do not fit
+ * before the next EndFrame() are dropped and counted.
+ */
+class Profiler {
+    static constexpr size_t RING_CAPACITY = 8192;
+
+    struct ThreadBuffer {
+        std::array<ProfileEvent, RING_CAPACITY> events;
+        std::atomic<uint64_t> head{0};
+        std::atomic<uint64_t> tail{0};
+        std::atomic<uint32_t> dropped{0};
+        uint32_t id = 0;
+        std::string name;
+    };
+
+    std::atomic<bool> enabled{true};
+    bool paused = false;
+
+    std::mutex threadsMutex;
+    std::vector<std::unique_ptr<ThreadBuffer> > threads;
+
+    std::mutex gpuMutex;
+    std::vector<GpuProfileEvent> pendingGpu;
+
+    std::mutex internMutex;
+    std::unordered_set<std::string> interned;
+
+    uint64_t frameIndex = 0;
+    uint64_t frameStartNs = 0;
+    ProfileFrame lastFrame;
+
+    std::vector<ProfileFrame> capture;
+    int captureRemaining = 0;
+    std::string capturePath;
+
+    ThreadBuffer &GetThreadBuffer();
+
+public:
+    static Profiler &Get();
+
+    /// Nanoseconds since the profiler was created
+    static uint64_t Now();
+
+    void SetEnabled(bool enable);
+
+    bool IsEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Keeps showing the last frame while still draining the rings
+    void SetPaused(bool pause);
+
+    bool IsPaused() const;
+
+    /// Label for the calling thread in the overlay and in traces
+    void SetThreadName(const std::string &name);
+
+    /// Returns a pointer that stays valid for the profiler's lifetime
+    const char *Intern(const std::string &name);
+
+    void Record(const char *name, uint64_t startNs, uint64_t endNs, uint32_t depth);
+
+    void RecordGpu(const char *name, uint64_t cpuStartNs, uint64_t durationNs);
+
+    void BeginFrame();
+
+    /// Main thread only: moves every ring into the frame snapshot and feeds an active capture
+    void EndFrame();
+
+    const ProfileFrame &GetLastFrame() const;
+
+    /// Records the next @p frames frames and writes them to @p path as Chrome trace JSON
+    void StartCapture(int frames, const std::string &path);
+
+    bool IsCapturing() const;
+
+    static bool ExportChromeTrace(const std::vector<ProfileFrame> &frames, const std::string &path);
+};
+
+/**
+ * @class ProfileScope
+ * @brief Times its own lifetime on the calling thread
+ */
+class ProfileScope {
+    const char *name;
+    uint64_t startNs = 0;
+    uint32_t depth = 0;
+    bool active;
+
+public:
+    explicit ProfileScope(const char *name);
+
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope &) = delete;
+
+    ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+/// @param name string literal, or a pointer from Profiler::Intern
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
\ No newline at end of file
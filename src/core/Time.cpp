@@ -1,10 +1,17 @@
 #include "Time.h"
 
 Time::Time()
-    : currentFrame(0.0f), lastFrame(0.0f), deltaTime(0.0f), timeScale(1.0f) {
+    : currentFrame(0.0f), lastFrame(0.0f), deltaTime(0.0f), timeScale(1.0f), fixedDelta(0.0f) {
 }
 
 void Time::Update() {
+    if (fixedDelta > 0.0f) {
+        deltaTime = fixedDelta;
+        lastFrame = currentFrame;
+        currentFrame += fixedDelta;
+        return;
+    }
+
     currentFrame = glfwGetTime();
     deltaTime = currentFrame - lastFrame;
     lastFrame = currentFrame;
@@ -26,6 +33,16 @@ void Time::SetTimeScale(float scale) {
     timeScale = scale;
 }
 
+void Time::SetFixedDelta(float delta) {
+    fixedDelta = delta > 0.0f ? delta : 0.0f;
+
+    // Back on wall time: resync so the first frame does not see the gap between simulated and real time
+    if (fixedDelta == 0.0f) {
+        currentFrame = glfwGetTime();
+        lastFrame = currentFrame;
+    }
+}
+
 float Time::GetFPS() const {
     return 1.0f / deltaTime;
 }
\ No newline at end of file
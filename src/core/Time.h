@@ -13,6 +13,7 @@ private:
     float lastFrame;
     float deltaTime;
     float timeScale;
+    float fixedDelta;
 
 public:
     Time();
@@ -29,6 +30,9 @@ public:
 
     void SetTimeScale(float scale);
 
+    /// Steps every frame by exactly this much, e.g. for reproducible headless captures; 0 goes back to wall time
+    void SetFixedDelta(float delta);
+
 
     float GetFPS() const;
 };
\ No newline at end of file
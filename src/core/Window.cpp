@@ -1,8 +1,9 @@
 #include "Window.h"
+#include <cstdlib>
 #include "core/logging/Logger.h"
 
-Window::Window(int width, int height, const std::string &title)
-    : window(nullptr), width(width), height(height), title(title) {
+Window::Window(int width, int height, const std::string &title, bool headless)
+    : window(nullptr), width(width), height(height), title(title), headless(headless) {
 }
 
 Window::~Window() {
@@ -11,7 +12,11 @@ Window::~Window() {
 
 bool Window::Initialize() {
 #if defined(__linux__)
-    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
+    // Build machines have no X server; the null platform still hands out EGL and OSMesa contexts
+    if (headless && !std::getenv("DISPLAY"))
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    else
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
 #endif
 
     if (!glfwInit()) {
@@ -24,8 +29,17 @@ bool Window::Initialize() {
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
     glfwWindowHint(GLFW_SAMPLES, 4);
+    if (headless)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
     window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+    if (!window && headless) {
+        // No GPU driver to talk to: fall back to Mesa's software rasterizer
+        Logger::Log(LogLevel::WARNING, "Native context unavailable, retrying with OSMesa");
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+        window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+    }
+
     if (!window) {
         Logger::Log(LogLevel::ERROR, "Failed to create GLFW window");
         glfwTerminate();
@@ -33,8 +47,8 @@ bool Window::Initialize() {
     }
 
     Logger::Log(LogLevel::INFO,
-                "GLFW window created: " + title + " (" + std::to_string(width) + "x" + std::to_string(height) +
-                ")");
+                std::string(headless ? "Headless GLFW window created: " : "GLFW window created: ") + title +
+                " (" + std::to_string(width) + "x" + std::to_string(height) + ")");
 
     glfwMakeContextCurrent(window);
 
@@ -111,4 +125,8 @@ int Window::GetHeight() const {
 
 float Window::GetAspectRatio() const {
     return static_cast<float>(width) / static_cast<float>(height);
+}
+
+bool Window::IsHeadless() const {
+    return headless;
 }
\ No newline at end of file
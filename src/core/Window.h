@@ -15,9 +15,11 @@ private:
     int width;
     int height;
     std::string title;
+    bool headless;
 
 public:
-    Window(int width, int height, const std::string &title);
+    /// @param headless create an invisible window; without a display the context comes from EGL or OSMesa
+    Window(int width, int height, const std::string &title, bool headless = false);
 
     ~Window();
 
@@ -58,4 +60,6 @@ public:
     int GetHeight() const;
 
     float GetAspectRatio() const;
+
+    bool IsHeadless() const;
 };
\ No newline at end of file
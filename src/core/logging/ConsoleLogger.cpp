@@ -1,29 +1,39 @@
 #include "ConsoleLogger.h"
 
+#include <cstdio>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
-#include <print>
+#include <format>
+#include <iterator>
 
 void ConsoleLogger::write(const LogData &data) {
     const char *lvl = levelToString(data.lvl);
     const char *cat = categoryToString(data.cat);
-    std::string timeStr = formatTime(data.timestamp);
+    char timeStr[16];
+    formatTime(data.timestamp, timeStr, sizeof(timeStr));
 
     if (data.showOrigin)
-        std::println("[{}] [{}] [{}] {} ({}:{})",
-                     timeStr.c_str(),
-                     lvl,
-                     cat,
-                     data.m.c_str(),
-                     data.f.c_str(),
-                     data.line);
+        std::format_to(std::back_inserter(buffer), "[{}] [{}] [{}] {} ({}:{})\n",
+                       timeStr,
+                       lvl,
+                       cat,
+                       data.m,
+                       data.f,
+                       data.line);
     else
-        std::println("[{}] [{}] [{}] {}",
-                     timeStr.c_str(),
-                     lvl,
-                     cat,
-                     data.m.c_str());
+        std::format_to(std::back_inserter(buffer), "[{}] [{}] [{}] {}\n",
+                       timeStr,
+                       lvl,
+                       cat,
+                       data.m);
+}
+
+void ConsoleLogger::flush() {
+    if (buffer.empty())
+        return;
+
+    std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+    std::fflush(stdout);
+    buffer.clear();
 }
 
 const char *ConsoleLogger::levelToString(LogLevel lvl) {
@@ -47,16 +57,10 @@ const char *ConsoleLogger::levelToString(LogLevel lvl) {
 
 
 const char *ConsoleLogger::categoryToString(LogCategory cat) {
-    switch (cat) {
-        case LogCategory::CORE: return "CORE";
-        case LogCategory::RENDERING: return "RENDERING";
-        case LogCategory::UI: return "UI";
-        case LogCategory::OTHER: return "OTHER";
-        default: return "UNKNOWN";
-    }
+    return LogCategoryName(cat);
 }
 
-std::string ConsoleLogger::formatTime(const std::chrono::system_clock::time_point &tp) {
+void ConsoleLogger::formatTime(const std::chrono::system_clock::time_point &tp, char *out, size_t size) {
     auto time = std::chrono::system_clock::to_time_t(tp);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                   tp.time_since_epoch()
@@ -66,9 +70,6 @@ std::string ConsoleLogger::formatTime(const std::chrono::system_clock::time_poin
 
     localtime_r(&time, &tm_snapshot); // only for unix-like systems
 
-    std::ostringstream oss;
-    oss << std::put_time(&tm_snapshot, "%H:%M:%S");
-    oss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-
-    return oss.str();
+    std::snprintf(out, size, "%02d:%02d:%02d.%03d",
+                  tm_snapshot.tm_hour, tm_snapshot.tm_min, tm_snapshot.tm_sec, static_cast<int>(ms.count()));
 }
\ No newline at end of file
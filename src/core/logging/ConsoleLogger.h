@@ -6,13 +6,18 @@
 #include "Logger.h"
 
 class ConsoleLogger : public ILogSink {
+    /// One batch of formatted lines, written to stdout in a single call
+    std::string buffer;
+
 public:
     void write(const LogData &data) override;
 
+    void flush() override;
+
 private:
     const char *levelToString(LogLevel lvl);
 
     const char *categoryToString(LogCategory cat);
 
-    std::string formatTime(const std::chrono::system_clock::time_point &tp);
+    void formatTime(const std::chrono::system_clock::time_point &tp, char *out, size_t size);
 };
\ No newline at end of file
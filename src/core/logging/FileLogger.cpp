@@ -1,8 +1,8 @@
 #include "FileLogger.h"
 
+#include <cstdio>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
+#include <format>
 #include <filesystem>
 
 namespace fs = std::filesystem;
@@ -33,29 +33,34 @@ void FileLogger::write(const LogData &data) {
 
     const char *lvl = LevelToString(data.lvl);
     const char *cat = CategoryToString(data.cat);
+    const std::string timeStr = FormatTime(data.timestamp);
 
     if (file.is_open()) {
         if (data.showOrigin)
-            file << std::format("[{}] [{}] [{}] {} ({}:{})",
+            file << std::format("[{}] [{}] [{}] {} ({}:{})\n",
                                 timeStr,
                                 lvl,
                                 cat,
                                 data.m,
                                 data.f,
-                                data.line) << std::endl;
+                                data.line);
         else
-            file << std::format("[{}] [{}] [{}] {}",
+            file << std::format("[{}] [{}] [{}] {}\n",
                                 timeStr,
                                 lvl,
                                 cat,
-                                data.m) << std::endl;
+                                data.m);
+    }
+}
 
+void FileLogger::flush() {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (file.is_open())
         file.flush();
-    }
 }
 
 void FileLogger::OpenLogFile(const LogData &data) {
-    timeStr = FormatTime(data.timestamp);
+    const std::string timeStr = FormatTime(data.timestamp);
     std::string dateStr = FormatDate(data.timestamp);
 
     logPath = folderName + "/" + std::format("log-{}-{}.txt", dateStr, timeStr);
@@ -63,26 +68,12 @@ void FileLogger::OpenLogFile(const LogData &data) {
 }
 
 const char *FileLogger::LevelToString(LogLevel lvl) {
-    switch (lvl) {
-        case LogLevel::INFO: return "INFO";
-        case LogLevel::WARNING: return "WARNING";
-        case LogLevel::ERROR: return "ERROR";
-        case LogLevel::DEBUG: return "DEBUG";
-        case LogLevel::INPUT: return "INPUT";
-        case LogLevel::CRITICAL: return "CRITICAL";
-        default: return "UNKNOWN";
-    }
+    return LogLevelName(lvl);
 }
 
 
 const char *FileLogger::CategoryToString(LogCategory cat) {
-    switch (cat) {
-        case LogCategory::CORE: return "CORE";
-        case LogCategory::RENDERING: return "RENDERING";
-        case LogCategory::UI: return "UI";
-        case LogCategory::OTHER: return "OTHER";
-        default: return "UNKNOWN";
-    }
+    return LogCategoryName(cat);
 }
 
 std::string FileLogger::FormatTime(const std::chrono::system_clock::time_point &tp) {
@@ -95,11 +86,10 @@ std::string FileLogger::FormatTime(const std::chrono::system_clock::time_point &
 
     localtime_r(&time, &tm_snapshot); // only for unix-like systems
 
-    std::ostringstream oss;
-    oss << std::put_time(&tm_snapshot, "%H:%M:%S");
-    oss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-
-    return oss.str();
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d.%03d",
+                  tm_snapshot.tm_hour, tm_snapshot.tm_min, tm_snapshot.tm_sec, static_cast<int>(ms.count()));
+    return buffer;
 }
 
 std::string FileLogger::FormatDate(const std::chrono::system_clock::time_point &tp) {
@@ -108,7 +98,7 @@ std::string FileLogger::FormatDate(const std::chrono::system_clock::time_point &
 
     localtime_r(&time, &tm_snapshot);
 
-    std::ostringstream oss;
-    oss << std::put_time(&tm_snapshot, "%Y-%m-%d");
-    return oss.str();
+    char buffer[16];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d", &tm_snapshot);
+    return buffer;
 }
\ No newline at end of file
@@ -10,7 +10,6 @@
 
 class FileLogger : public ILogSink {
     std::string folderName;
-    std::string timeStr;
     std::string logPath;
     std::ofstream file;
 
@@ -24,6 +23,8 @@ public:
 
     void write(const LogData &data) override;
 
+    void flush() override;
+
 private:
     void OpenLogFile(const LogData &data);
 
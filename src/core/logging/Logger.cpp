@@ -1,28 +1,242 @@
 #include "Logger.h"
 
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
 #include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
 
-void Logger::Logger::AddSink(ILogSink *sink) {
-    std::lock_guard<std::mutex> lock(logMutex());
+#include "core/MPSCQueue.h"
 
-    sinks().push_back(sink);
+namespace {
+    struct AsyncState {
+        /// Popped only by whoever holds drainMutex
+        std::unique_ptr<MPSCQueue<LogData> > queue;
+        std::thread writer;
+        std::atomic<bool> running{false};
+        std::atomic<bool> stopping{false};
+
+        /// Bumped after every push; the writer sleeps on it
+        std::atomic<uint64_t> pushed{0};
+        /// Queued messages handed to the sinks; Flush() waits on it
+        std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> dropped{0};
+        uint64_t droppedReported = 0;
+
+        std::atomic<LogOverflowPolicy> policy{LogOverflowPolicy::BLOCK};
+
+        /// Held by whoever touches the sinks: the writer, a synchronous Log(), the crash handler, Add/RemoveSink
+        std::mutex drainMutex;
+        std::vector<ILogSink *> sinks;
+        std::thread::id writerId;
+    };
+
+    AsyncState &State() {
+        static AsyncState state;
+        return state;
+    }
+
+    void WriteToSinks(const std::vector<ILogSink *> &sinks, const LogData &data) {
+        for (auto *sink: sinks)
+            if (sink)
+                sink->write(data);
+    }
+
+    void FlushSinks(const std::vector<ILogSink *> &sinks) {
+        for (auto *sink: sinks)
+            if (sink)
+                sink->flush();
+    }
+
+    /// Caller holds drainMutex
+    void DrainQueue(AsyncState &state) {
+        const std::vector<ILogSink *> &sinks = state.sinks;
+        LogData data;
+        bool wrote = false;
+
+        while (state.queue->TryPop(data)) {
+            WriteToSinks(sinks, data);
+            wrote = true;
+        }
+
+        const uint64_t dropped = state.dropped.load(std::memory_order_relaxed);
+        if (dropped != state.droppedReported) {
+            WriteToSinks(sinks, {
+                             LogLevel::WARNING, LogCategory::CORE,
+                             "Logger: queue full, dropped " + std::to_string(dropped - state.droppedReported) +
+                             " messages",
+                             "", 0, false, std::chrono::system_clock::now()
+                         });
+            state.droppedReported = dropped;
+            wrote = true;
+        }
+
+        if (wrote)
+            FlushSinks(sinks);
+
+        state.processed.store(state.queue->GetDequeued(), std::memory_order_release);
+        state.processed.notify_all();
+    }
+
+    std::terminate_handler g_PreviousTerminate = nullptr;
+
+    void FlushOnCrash() {
+        AsyncState &state = State();
+
+        // The writer itself crashed mid-batch; its lock will never be released
+        if (state.running && std::this_thread::get_id() != state.writerId) {
+            for (int attempt = 0; attempt < 100; attempt++) {
+                if (state.drainMutex.try_lock()) {
+                    DrainQueue(state);
+                    state.drainMutex.unlock();
+                    return;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+
+        FlushSinks(state.sinks);
+    }
+
+    void OnFatalSignal(int signal) {
+        FlushOnCrash();
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+    }
+
+    void OnTerminate() {
+        FlushOnCrash();
+        if (g_PreviousTerminate)
+            g_PreviousTerminate();
+        std::abort();
+    }
+}
+
+void Logger::StartAsync(size_t capacity) {
+    AsyncState &state = State();
+    if (state.running)
+        return;
+
+    state.queue = std::make_unique<MPSCQueue<LogData> >(capacity);
+    state.stopping = false;
+    state.running = true;
+
+    state.writer = std::thread([&state] {
+        for (;;) {
+            // Read before draining: a push that lands after the drain changes it and wait() returns at once
+            const uint64_t seen = state.pushed.load(std::memory_order_acquire);
+            {
+                std::lock_guard<std::mutex> lock(state.drainMutex);
+                DrainQueue(state);
+            }
+
+            if (state.stopping.load(std::memory_order_acquire) &&
+                state.queue->GetEnqueued() == state.queue->GetDequeued())
+                break;
+
+            state.pushed.wait(seen, std::memory_order_acquire);
+        }
+    });
+    state.writerId = state.writer.get_id();
+
+    static bool handlersInstalled = false;
+    if (!handlersInstalled) {
+        handlersInstalled = true;
+        std::atexit(Shutdown);
+        g_PreviousTerminate = std::set_terminate(OnTerminate);
+        for (int signal: {SIGSEGV, SIGABRT, SIGFPE, SIGILL})
+            std::signal(signal, OnFatalSignal);
+    }
+}
+
+void Logger::Shutdown() {
+    AsyncState &state = State();
+    if (!state.running)
+        return;
+
+    state.stopping.store(true, std::memory_order_release);
+    state.pushed.fetch_add(1, std::memory_order_release);
+    state.pushed.notify_one();
+    state.writer.join();
+
+    state.running = false;
+}
+
+void Logger::Flush() {
+    AsyncState &state = State();
+    if (!state.running)
+        return;
+
+    const uint64_t target = state.queue->GetEnqueued();
+    state.pushed.fetch_add(1, std::memory_order_release);
+    state.pushed.notify_one();
+
+    for (uint64_t done = state.processed.load(std::memory_order_acquire);
+         done < target;
+         done = state.processed.load(std::memory_order_acquire))
+        state.processed.wait(done, std::memory_order_acquire);
+}
+
+void Logger::SetOverflowPolicy(LogOverflowPolicy policy) {
+    State().policy.store(policy, std::memory_order_relaxed);
+}
+
+uint64_t Logger::GetDroppedCount() {
+    return State().dropped.load(std::memory_order_relaxed);
+}
+
+void Logger::AddSink(ILogSink *sink) {
+    std::lock_guard<std::mutex> lock(State().drainMutex);
+
+    State().sinks.push_back(sink);
 }
 
 void Logger::RemoveSink(ILogSink *sink) {
-    std::lock_guard<std::mutex> lock(logMutex());
-    auto &s = sinks();
+    // Messages logged before the removal still belong to this sink
+    Flush();
+
+    std::lock_guard<std::mutex> lock(State().drainMutex);
+    auto &s = State().sinks;
     s.erase(std::remove(s.begin(), s.end(), sink), s.end());
 }
 
 void Logger::ClearSinks() {
-    std::lock_guard<std::mutex> lock(logMutex());
-    sinks().clear();
+    Flush();
+
+    std::lock_guard<std::mutex> lock(State().drainMutex);
+    State().sinks.clear();
 }
 
-void Logger::Log(LogLevel level, const std::string &message) {
-    std::lock_guard<std::mutex> lock(logMutex());
+void Logger::SwapSinks(std::vector<ILogSink *> &sinks) {
+    Flush();
+
+    std::lock_guard<std::mutex> lock(State().drainMutex);
+    State().sinks.swap(sinks);
+}
+
+void Logger::SetLevel(LogLevel level) {
+    for (auto &severity: minSeverity)
+        severity.store(LogSeverity(level), std::memory_order_relaxed);
+}
+
+void Logger::SetLevel(LogCategory cat, LogLevel level) {
+    minSeverity[static_cast<size_t>(cat)].store(LogSeverity(level), std::memory_order_relaxed);
+}
 
-    LogData data{
+LogLevel Logger::GetLevel(LogCategory cat) {
+    const int severity = minSeverity[static_cast<size_t>(cat)].load(std::memory_order_relaxed);
+    for (LogLevel level: {LogLevel::DEBUG, LogLevel::INPUT, LogLevel::INFO, LogLevel::WARNING, LogLevel::ERROR})
+        if (LogSeverity(level) == severity)
+            return level;
+    return LogLevel::CRITICAL;
+}
+
+void Logger::Log(LogLevel level, const std::string &message) {
+    Submit({
         level,
         LogCategory::OTHER,
         message,
@@ -30,18 +244,12 @@ void Logger::Log(LogLevel level, const std::string &message) {
         0,
         false,
         std::chrono::system_clock::now()
-    };
-
-    for (auto *sink: sinks())
-        if (sink)
-            sink->write(data);
+    });
 }
 
 
 void Logger::Log(LogLevel level, const std::string &message, bool showOrigin, const std::source_location &loc) {
-    std::lock_guard<std::mutex> lock(logMutex());
-
-    LogData data{
+    Submit({
         level,
         LogCategory::OTHER,
         message,
@@ -49,17 +257,11 @@ void Logger::Log(LogLevel level, const std::string &message, bool showOrigin, co
         showOrigin ? int(loc.line()) : 0,
         showOrigin,
         std::chrono::system_clock::now()
-    };
-
-    for (auto *sink: sinks())
-        if (sink)
-            sink->write(data);
+    });
 }
 
 void Logger::Log(LogLevel level, LogCategory cat, const std::string &message, bool showOrigin) {
-    std::lock_guard<std::mutex> lock(logMutex());
-
-    LogData data{
+    Submit({
         level,
         cat,
         message,
@@ -67,25 +269,42 @@ void Logger::Log(LogLevel level, LogCategory cat, const std::string &message, bo
         showOrigin ? __LINE__ : 0,
         showOrigin,
         std::chrono::system_clock::now()
-    };
+    });
+}
+
+void Logger::Submit(LogData &&data) {
+    if (!ShouldLog(data.lvl, data.cat))
+        return;
+
+    AsyncState &state = State();
 
-    for (auto *sink: sinks())
-        if (sink)
-            sink->write(data);
+    if (!state.running) {
+        std::lock_guard<std::mutex> lock(state.drainMutex);
+        WriteToSinks(state.sinks, data);
+        FlushSinks(state.sinks);
+        return;
+    }
+
+    const bool mayDrop = state.policy.load(std::memory_order_relaxed) == LogOverflowPolicy::DROP &&
+                         data.lvl != LogLevel::ERROR && data.lvl != LogLevel::CRITICAL;
+
+    while (!state.queue->TryPush(data)) {
+        if (mayDrop) {
+            state.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        state.pushed.fetch_add(1, std::memory_order_release);
+        state.pushed.notify_one();
+        std::this_thread::yield();
+    }
+
+    state.pushed.fetch_add(1, std::memory_order_release);
+    state.pushed.notify_one();
 }
 
 const char *Logger::stripProjectRoot(const char *file) {
     constexpr const char *ROOT = "WFE/";
     const char *pos = std::strstr(file, ROOT);
     return pos ? pos : file;
-}
-
-std::vector<ILogSink *> &Logger::sinks() {
-    static std::vector<ILogSink *> instance;
-    return instance;
-}
-
-std::mutex &Logger::logMutex() {
-    static std::mutex instance;
-    return instance;
 }
\ No newline at end of file
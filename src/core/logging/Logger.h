@@ -1,9 +1,12 @@
 #pragma once
 
 #include <string>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
 #include <vector>
-#include <mutex>
 #include <source_location>
 
 enum class LogLevel {
@@ -21,9 +24,52 @@ enum class LogCategory {
     RENDERING,
     UI,
     ECS_SYSTEM,
+    RESOURCE,
     OTHER
 };
 
+/// Ordering used by the level thresholds; LogLevel's declaration order is not by severity
+constexpr int LogSeverity(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG: return 0;
+        case LogLevel::INPUT: return 1;
+        case LogLevel::INFO: return 2;
+        case LogLevel::WARNING: return 3;
+        case LogLevel::ERROR: return 4;
+        case LogLevel::CRITICAL: return 5;
+    }
+    return 5;
+}
+
+constexpr const char *LogLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::WARNING: return "WARNING";
+        case LogLevel::ERROR: return "ERROR";
+        case LogLevel::DEBUG: return "DEBUG";
+        case LogLevel::INPUT: return "INPUT";
+        case LogLevel::CRITICAL: return "CRITICAL";
+    }
+    return "UNKNOWN";
+}
+
+constexpr const char *LogCategoryName(LogCategory cat) {
+    switch (cat) {
+        case LogCategory::CORE: return "CORE";
+        case LogCategory::RENDERING: return "RENDERING";
+        case LogCategory::UI: return "UI";
+        case LogCategory::ECS_SYSTEM: return "ECS";
+        case LogCategory::RESOURCE: return "RESOURCE";
+        case LogCategory::OTHER: return "OTHER";
+    }
+    return "UNKNOWN";
+}
+
+#ifndef LOG_COMPILE_MIN_LEVEL
+/// LOG_* statements below this level are compiled out; CMake sets it from the LOG_COMPILE_MIN_LEVEL cache variable
+#define LOG_COMPILE_MIN_LEVEL LogLevel::DEBUG
+#endif
+
 struct LogData {
     LogLevel lvl;
     LogCategory cat;
@@ -41,10 +87,42 @@ public:
     virtual ~ILogSink() = default;
 
     virtual void write(const LogData &data) = 0;
+
+    /// Called once after each batch of write() calls; buffered sinks push their output here
+    virtual void flush() {
+    }
+};
+
+/// What Log() does when the async queue is full
+enum class LogOverflowPolicy {
+    BLOCK, ///< wait for the writer thread to make room
+    DROP ///< discard the message and report the count later; errors still block
 };
 
+/**
+ * @class Logger
+ * @brief Fans log messages out to the registered sinks
+ *
+ * Until StartAsync() every Log() writes to the sinks on the calling thread.
+ * Afterwards Log() only pushes into a bounded lock-free queue and a writer
+ * thread formats and writes them in batches. Shutdown(), normal exit and
+ * fatal signals drain whatever is still queued.
+ */
 class Logger {
 public:
+    /// @param capacity queue slots, rounded up to a power of two
+    static void StartAsync(size_t capacity = 8192);
+
+    /// Drains the queue and stops the writer thread; logging continues synchronously
+    static void Shutdown();
+
+    /// Blocks until every message logged before the call has reached the sinks
+    static void Flush();
+
+    static void SetOverflowPolicy(LogOverflowPolicy policy);
+
+    static uint64_t GetDroppedCount();
+
     static void AddSink(ILogSink *sink);
 
     static void RemoveSink(ILogSink *sink);
@@ -58,10 +136,67 @@ public:
 
     static void Log(LogLevel level, LogCategory cat, const std::string &message, bool showOrigin = false);
 
+    /// Formats only when @p level passes the category's threshold; prefer the LOG_* macros
+    template<typename... Args>
+    static void LogFormat(LogLevel level, LogCategory cat, std::format_string<Args...> fmt, Args &&... args) {
+        if (!ShouldLog(level, cat))
+            return;
+
+        Submit({
+            level,
+            cat,
+            std::format(fmt, std::forward<Args>(args)...),
+            "",
+            0,
+            false,
+            std::chrono::system_clock::now()
+        });
+    }
+
+    /// Runtime threshold for every category
+    static void SetLevel(LogLevel level);
+
+    static void SetLevel(LogCategory cat, LogLevel level);
+
+    static LogLevel GetLevel(LogCategory cat);
+
+    static bool ShouldLog(LogLevel level, LogCategory cat) {
+        return LogSeverity(level) >= minSeverity[static_cast<size_t>(cat)].load(std::memory_order_relaxed);
+    }
+
+    static constexpr bool IsCompiledIn(LogLevel level) {
+        return LogSeverity(level) >= LogSeverity(LOG_COMPILE_MIN_LEVEL);
+    }
+
+    /// Exchanges the registered sinks with @p sinks once everything queued has been written
+    static void SwapSinks(std::vector<ILogSink *> &sinks);
+
 private:
-    static const char *stripProjectRoot(const char *file);
+    static constexpr size_t CATEGORY_COUNT = static_cast<size_t>(LogCategory::OTHER) + 1;
+
+    /// LogSeverity() of the quietest level still written, per category
+    inline static std::atomic<int> minSeverity[CATEGORY_COUNT]{};
+
+    static void Submit(LogData &&data);
 
-    static std::vector<ILogSink *> &sinks();
+    static const char *stripProjectRoot(const char *file);
+};
 
-    static std::mutex &logMutex();
-};
\ No newline at end of file
+#define LOG_AT(level, cat, ...)                                                                                        \
+    do {                                                                                                               \
+        if constexpr (Logger::IsCompiledIn(level)) {                                                                   \
+            if (Logger::ShouldLog(level, cat))                                                                         \
+                Logger::LogFormat(level, cat, __VA_ARGS__);                                                            \
+        }                                                                                                              \
+    } while (0)
+
+/**
+ * LOG_INFO(RESOURCE, "Imported {} meshes", count): the arguments are only evaluated and
+ * formatted when the level passes the category's runtime threshold, and the whole
+ * statement disappears when the level is below LOG_COMPILE_MIN_LEVEL.
+ */
+#define LOG_DEBUG(cat, ...) LOG_AT(LogLevel::DEBUG, LogCategory::cat, __VA_ARGS__)
+#define LOG_INFO(cat, ...) LOG_AT(LogLevel::INFO, LogCategory::cat, __VA_ARGS__)
+#define LOG_WARNING(cat, ...) LOG_AT(LogLevel::WARNING, LogCategory::cat, __VA_ARGS__)
+#define LOG_ERROR(cat, ...) LOG_AT(LogLevel::ERROR, LogCategory::cat, __VA_ARGS__)
+#define LOG_CRITICAL(cat, ...) LOG_AT(LogLevel::CRITICAL, LogCategory::cat, __VA_ARGS__)
\ No newline at end of file
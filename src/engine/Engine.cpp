@@ -1,9 +1,17 @@
 #include "Engine.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
 #include <ImGuizmo.h>
 #include <glm/glm.hpp>
 #include "core/Input.h"
 #include "core/CommandManager.h"
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
 #include "core/logging/Logger.h"
+#include "ECS/World.h"
+#include "engine/LoggingBenchmark.h"
 
 void Engine::FramebufferSizeCallback(GLFWwindow *window, int width, int height) {
     glViewport(0, 0, width, height);
@@ -65,6 +73,79 @@ void Engine::OnInitialize() {
     GetWindow()->SetScrollCallback(Input::ScrollCallback);
     GetWindow()->SetMouseButtonCallback(MouseButtonCallback);
 
+    GetJobSystem().Initialize();
+
+    if (!CommandManager::HasCommand("Jobs_Benchmark"))
+        CommandManager::RegisterCommand("Jobs_Benchmark", [](const CommandArgs &) {
+            BenchmarkJobSystem();
+        });
+
+    if (!CommandManager::HasCommand("Commands_Benchmark"))
+        CommandManager::RegisterCommand("Commands_Benchmark", [](const CommandArgs &) {
+            BenchmarkCommandDispatch();
+        });
+
+    if (!CommandManager::HasCommand("Events_Benchmark"))
+        CommandManager::RegisterCommand("Events_Benchmark", [](const CommandArgs &) {
+            BenchmarkEventBus();
+        });
+
+    if (!CommandManager::HasCommand("ECS_Benchmark"))
+        CommandManager::RegisterCommand("ECS_Benchmark", [](const CommandArgs &) {
+            BenchmarkEcsIteration();
+        });
+
+    if (!CommandManager::HasCommand("Profiler_Capture"))
+        CommandManager::RegisterCommand("Profiler_Capture", [](const CommandArgs &args) {
+            int frames = 60;
+            std::string path = "profile.json";
+            if (!args.empty() && std::holds_alternative<int>(args[0]))
+                frames = std::max(std::get<int>(args[0]), 1);
+            if (args.size() > 1 && std::holds_alternative<std::string>(args[1]))
+                path = std::get<std::string>(args[1]);
+            Profiler::Get().StartCapture(frames, path);
+        });
+
+    if (!CommandManager::HasCommand("Profiler_Toggle"))
+        CommandManager::RegisterCommand("Profiler_Toggle", [](const CommandArgs &) {
+            Profiler::Get().SetEnabled(!Profiler::Get().IsEnabled());
+        });
+
+    if (!CommandManager::HasCommand("Log_Level"))
+        CommandManager::RegisterCommand("Log_Level", [](const CommandArgs &args) {
+            if (args.empty() || !std::holds_alternative<std::string>(args[0]))
+                return;
+
+            const std::string &levelName = std::get<std::string>(args[0]);
+            for (LogLevel level: {LogLevel::DEBUG, LogLevel::INPUT, LogLevel::INFO, LogLevel::WARNING,
+                                  LogLevel::ERROR, LogLevel::CRITICAL}) {
+                if (levelName != LogLevelName(level))
+                    continue;
+
+                if (args.size() < 2 || !std::holds_alternative<std::string>(args[1])) {
+                    Logger::SetLevel(level);
+                    return;
+                }
+
+                const std::string &categoryName = std::get<std::string>(args[1]);
+                for (LogCategory cat: {LogCategory::CORE, LogCategory::RENDERING, LogCategory::UI,
+                                       LogCategory::ECS_SYSTEM, LogCategory::RESOURCE, LogCategory::OTHER})
+                    if (categoryName == LogCategoryName(cat)) {
+                        Logger::SetLevel(cat, level);
+                        return;
+                    }
+            }
+
+            Logger::Log(LogLevel::WARNING, "Log_Level: expected <level> [category]");
+        });
+
+    if (!CommandManager::HasCommand("Log_Benchmark"))
+        CommandManager::RegisterCommand("Log_Benchmark", [](const CommandArgs &args) {
+            BenchmarkLogging(!args.empty() && std::holds_alternative<std::string>(args[0])
+                                 ? std::get<std::string>(args[0])
+                                 : "assets/objects/shapes/sphere/sphere.obj");
+        });
+
     mm = GetModuleManager();
 
     mm->RegisterModule<ECSModule>();
@@ -128,6 +209,7 @@ void Engine::OnInitialize() {
     inputControllerSystem = std::make_unique<InputControllerSystem>();
     physicsDebugSystem = std::make_unique<PhysicsDebugRenderSystem>();
     audioSystem = std::make_unique<AudioSystem>();
+    transformSystem = std::make_unique<TransformSystem>();
     if (!audioSystem->Init()) {
         Logger::Log(LogLevel::WARNING, "AudioSystem failed to initialize");
     }
@@ -146,12 +228,28 @@ void Engine::OnInitialize() {
 
     renderingModule->GetRenderer()->SetEnableShadows(true);
 
+    showUI = !m_options.headless;
+    if (m_options.headless)
+        InitializeHeadless();
+    else if (!m_options.scene.empty())
+        CommandManager::ExecuteCommand("onLoadScene", {m_options.scene});
+
+    RunLaunchCommands();
+
     Logger::Log(LogLevel::INFO, "==================================");
     Logger::Log(LogLevel::INFO, "Engine initialized successfully");
 }
 
 void Engine::OnUpdate(float deltaTime) {
-    mm->UpdateAll(deltaTime);
+    {
+        PROFILE_SCOPE("Events");
+        GetEventBus().DispatchQueued();
+    }
+
+    {
+        PROFILE_SCOPE("Modules");
+        mm->UpdateAll(deltaTime);
+    }
 
     ProcessInput();
 
@@ -165,9 +263,17 @@ void Engine::OnUpdate(float deltaTime) {
 
     UpdateMainCamera();
 
-    scriptSystem->Update(*ecsModule->GetECS(), GetInput(), deltaTime);
-    if (audioSystem)
+    {
+        PROFILE_SCOPE("Scripts");
+        scriptSystem->Update(*ecsModule->GetECS(), GetInput(), deltaTime);
+    }
+    if (audioSystem) {
+        PROFILE_SCOPE("Audio");
         audioSystem->Update(ecsModule->GetECS());
+    }
+
+    PROFILE_SCOPE("Transforms");
+    transformSystem->Update(*ecsModule->GetECS());
 }
 
 void Engine::UpdateMainCamera() {
@@ -198,21 +304,35 @@ void Engine::OnRender() {
     auto *ecs = ecsModule->GetECS();
     auto *renderer = renderingModule->GetRenderer();
 
+    // A headless run that cannot render must still end, or CI waits forever
+    if (m_options.headless && !m_offscreen) {
+        Stop();
+        return;
+    }
+
     entt::entity camera = ecs->FindGameCamera();
     if (camera == entt::null) {
         Logger::Log(LogLevel::WARNING, "No game camera found!");
+        if (m_offscreen)
+            Stop();
         return;
     }
 
+    const int width = m_offscreen ? m_offscreen->GetWidth() : GetWindow()->GetWidth();
+    const int height = m_offscreen ? m_offscreen->GetHeight() : GetWindow()->GetHeight();
+
     renderer->BeginFrame();
     renderer->Render(
         *ecs,
         camera,
-        GetWindow()->GetWidth(),
-        GetWindow()->GetHeight()
+        width,
+        height
     );
     renderer->EndFrame();
 
+    if (m_offscreen)
+        FinishHeadlessFrame();
+
     if (showUI) {
         auto &transform = ecs->GetComponent<TransformComponent>(camera);
         auto &orientation = ecs->GetComponent<CameraOrientationComponent>(camera);
@@ -243,8 +363,10 @@ void Engine::OnRender() {
                 (float) GetWindow()->GetWidth() / (float) GetWindow()->GetHeight())
         );
 
+        PROFILE_SCOPE("UI");
         uiModule->GetImGuiManager()->BeginFrame();
-        m_overlay.Render(ecs, mainCameraEntity, resourceModule->GetMaterialManager());
+        m_overlay.Render(ecs, mainCameraEntity, resourceModule->GetMaterialManager(),
+                         &renderingModule->GetRenderer()->GetStats(), mm);
         uiModule->GetImGuiManager()->EndFrame();
     }
 }
@@ -256,8 +378,15 @@ void Engine::OnShutdown() {
     if (audioSystem)
         audioSystem->Shutdown();
 
+    if (m_offscreen) {
+        renderingModule->GetRenderer()->SetRenderTarget(nullptr);
+        m_offscreen.reset();
+    }
+
     mm->ShutdownAll();
 
+    GetJobSystem().Shutdown();
+
     Logger::Log(LogLevel::INFO, "==================================");
     Logger::Log(LogLevel::INFO, "Engine shutdown complete!");
 }
@@ -275,6 +404,13 @@ void Engine::SetMainCameraEntity(entt::entity newMainCameraEntity) {
 
 Engine::Engine(int w, int h, const std::string &title)
     : Application(w, h, title) {
+    m_options.width = w;
+    m_options.height = h;
+}
+
+Engine::Engine(const LaunchOptions &options, const std::string &title)
+    : Application(options.width, options.height, title, options.headless)
+      , m_options(options) {
 }
 
 void Engine::InitializeAS() {
@@ -304,4 +440,87 @@ void Engine::RegistraterCoreCommands() {
             Logger::Log(LogLevel::INFO, "Exit requested from menu");
             Stop();
         });
+}
+
+void Engine::InitializeHeadless() {
+    auto *renderer = renderingModule->GetRenderer();
+    if (!renderingModule->HasOpenGL() || !renderer) {
+        Logger::Log(LogLevel::ERROR, "Headless: no OpenGL context, nothing to render");
+        return;
+    }
+
+    m_offscreen = std::make_unique<Framebuffer>(m_options.width, m_options.height);
+    renderer->SetRenderTarget(m_offscreen.get());
+
+    // Same simulated time every run, so dumped frames can be compared across machines
+    GetTime()->SetFixedDelta(1.0f / 60.0f);
+
+    if (!m_options.scene.empty())
+        CommandManager::ExecuteCommand("onLoadScene", {m_options.scene});
+
+    if (!m_options.outputDir.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(m_options.outputDir, error);
+        if (error)
+            Logger::Log(LogLevel::ERROR, "Headless: cannot create " + m_options.outputDir + ": " + error.message());
+    }
+
+    Logger::Log(LogLevel::INFO,
+                "Headless: rendering " + std::to_string(m_options.frames) + " frames at " +
+                std::to_string(m_options.width) + "x" + std::to_string(m_options.height) +
+                (m_options.outputDir.empty() ? "" : " into " + m_options.outputDir));
+}
+
+void Engine::FinishHeadlessFrame() {
+    m_headlessFrame++;
+    m_headlessFrameMs += renderingModule->GetRenderer()->GetStats().frameTime;
+
+    if (!m_options.outputDir.empty() && m_headlessFrame % m_options.dumpEvery == 0) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%05d.ppm", m_headlessFrame);
+        const std::filesystem::path path = std::filesystem::path(m_options.outputDir) / name;
+        if (!m_offscreen->SaveToPPM(path.string()))
+            Logger::Log(LogLevel::ERROR, "Headless: failed to write " + path.string());
+    }
+
+    if (m_headlessFrame < m_options.frames)
+        return;
+
+    Logger::Log(LogLevel::INFO,
+                "Headless: " + std::to_string(m_headlessFrame) + " frames, avg CPU frame " +
+                std::to_string(m_headlessFrameMs / m_headlessFrame) + " ms");
+    Stop();
+}
+
+void Engine::RunLaunchCommands() {
+    for (const std::string &line: m_options.commands) {
+        std::istringstream tokens(line);
+        std::string name;
+        tokens >> name;
+
+        CommandArgs args;
+        for (std::string token; tokens >> token;) {
+            size_t used = 0;
+            try {
+                if (int value = std::stoi(token, &used); used == token.size()) {
+                    args.emplace_back(value);
+                    continue;
+                }
+                if (float value = std::stof(token, &used); used == token.size()) {
+                    args.emplace_back(value);
+                    continue;
+                }
+            } catch (...) {
+            }
+            args.emplace_back(token);
+        }
+
+        if (!CommandManager::HasCommand(name)) {
+            Logger::Log(LogLevel::WARNING, "--run: unknown command " + name);
+            continue;
+        }
+
+        Logger::Log(LogLevel::INFO, "--run: " + line);
+        CommandManager::ExecuteCommand(name, args);
+    }
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <GLFW/glfw3.h>
 
 #include "application/Application.h"
+#include "application/LaunchOptions.h"
 #include "rendering/core/Framebuffer.h"
 #include "scripting/ASBindings.h"
 #include "ECS/systems/Systems.h"
@@ -39,6 +40,7 @@ private:
     std::unique_ptr<InputControllerSystem> inputControllerSystem;
     std::unique_ptr<PhysicsDebugRenderSystem> physicsDebugSystem;
     std::unique_ptr<AudioSystem> audioSystem;
+    std::unique_ptr<TransformSystem> transformSystem;
 
     std::unique_ptr<EditorCommandHandler> ech;
 
@@ -52,6 +54,12 @@ private:
 
     DebugOverlay m_overlay;
 
+    LaunchOptions m_options;
+    /// Headless runs render here instead of the window
+    std::unique_ptr<Framebuffer> m_offscreen;
+    int m_headlessFrame = 0;
+    double m_headlessFrameMs = 0.0;
+
     bool cameraControlEnabled;
     bool showUI;
 
@@ -94,10 +102,21 @@ protected:
 public:
     Engine(int w, int h, const std::string &title);
 
+    Engine(const LaunchOptions &options, const std::string &title);
+
 private:
     void InitializeAS();
 
     void ProcessInput();
 
     void RegistraterCoreCommands();
+
+    /// Sets up the offscreen target and loads the requested scene
+    void InitializeHeadless();
+
+    /// Dumps the frame if asked to and stops once the requested frame count is reached
+    void FinishHeadlessFrame();
+
+    /// Executes the --run commands, e.g. a stress scene followed by a benchmark
+    void RunLaunchCommands();
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "EngineCommandHandler.h"
 #include <string>
+#include <random>
+#include <algorithm>
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
 #include "core/logging/Logger.h"
@@ -123,18 +125,12 @@ void EditorCommandHandler::RegisterObjectCommands() {
                                             return;
                                         }
 
-                                        Logger::Log(LogLevel::INFO, "Calling LoadWithECS...");
-                                        auto entity = m_resModule->GetModelManager()->LoadWithECS(
+                                        // Import runs on the job system; the root shows a placeholder until
+                                        // ResourceModule has uploaded the meshes
+                                        Logger::Log(LogLevel::INFO, "Calling LoadWithECSAsync...");
+                                        m_resModule->GetModelManager()->LoadWithECSAsync(
                                             filepath, m_ecsModule->GetECS());
 
-                                        if (entity == entt::null) {
-                                            Logger::Log(LogLevel::ERROR, "Failed to load model: " + filepath);
-                                            return;
-                                        }
-
-                                        Logger::Log(LogLevel::INFO,
-                                                    "Total entities in world: " + std::to_string(
-                                                        m_ecsModule->GetECS()->GetEntityCount()));
                                         Logger::Log(LogLevel::INFO, "=== onLoadModel command complete ===\n");
                                     });
 
@@ -191,6 +187,45 @@ void EditorCommandHandler::RegisterLightCommands() {
                                             "assets/textures/icons/light_spot.png", 0.35f);
                                         Logger::Log(LogLevel::INFO, "Spot light created with icon");
                                     });
+
+    // Floor plus a grid of small coloured point lights, for Renderer_BenchmarkLights
+    CommandManager::RegisterCommand("onCreateLightStressScene",
+                                    [this](const CommandArgs &args) {
+                                        int count = 256;
+                                        if (!args.empty() && std::holds_alternative<int>(args[0]))
+                                            count = std::max(std::get<int>(args[0]), 1);
+
+                                        auto *ecs = m_ecsModule->GetECS();
+                                        auto floor = m_resModule->GetModelManager()->LoadWithECS(
+                                            "assets/objects/shapes/plane/plane.obj", ecs, true);
+                                        if (floor != entt::null && ecs->HasComponent<TransformComponent>(floor))
+                                            ecs->GetRegistry().patch<TransformComponent>(floor, [](auto &t) {
+                                                t.scale = glm::vec3(40.0f);
+                                            });
+
+                                        std::mt19937 rng(1337);
+                                        std::uniform_real_distribution<float> area(-38.0f, 38.0f);
+                                        std::uniform_real_distribution<float> height(0.5f, 3.0f);
+                                        std::uniform_real_distribution<float> hue(0.2f, 1.0f);
+
+                                        for (int i = 0; i < count; ++i) {
+                                            auto entity = ecs->CreateEntity("Stress Light " + std::to_string(i));
+                                            ecs->AddComponent<TransformComponent>(entity,
+                                                glm::vec3(area(rng), height(rng), area(rng)), glm::vec3(0),
+                                                glm::vec3(1));
+
+                                            LightComponent light(LightType::POINT);
+                                            light.diffuse = glm::vec3(hue(rng), hue(rng), hue(rng));
+                                            light.ambient = glm::vec3(0.0f);
+                                            light.radius = 6.0f;
+                                            light.castShadows = false;
+                                            ecs->AddComponent<LightComponent>(entity, light);
+                                            ecs->AddComponent<VisibilityComponent>(entity, true);
+                                        }
+
+                                        Logger::Log(LogLevel::INFO, "Light stress scene created with " +
+                                                                    std::to_string(count) + " point lights");
+                                    });
 }
 
 void EditorCommandHandler::RegisterSceneCommands() {
@@ -0,0 +1,84 @@
+#include "LoggingBenchmark.h"
+
+#include <chrono>
+#include <vector>
+
+#include "core/logging/Logger.h"
+#include "ECS/World.h"
+#include "resource/model/ModelLoader.h"
+
+namespace {
+    class CountingSink : public ILogSink {
+    public:
+        size_t count = 0;
+
+        void write(const LogData &) override {
+            count++;
+        }
+    };
+
+    template<typename Func>
+    double TimeMs(Func &&func) {
+        using Clock = std::chrono::high_resolution_clock;
+
+        auto t0 = Clock::now();
+        func();
+        // The writer thread's share of the cost belongs to the run that queued the messages
+        Logger::Flush();
+        auto t1 = Clock::now();
+
+        return std::chrono::duration<double, std::milli>(t1 - t0).count();
+    }
+}
+
+void BenchmarkLogging(const std::string &modelPath) {
+    constexpr int ENTITY_COUNT = 100000;
+    constexpr int IMPORT_RUNS = 20;
+
+    CountingSink counter;
+    std::vector<ILogSink *> sinks{&counter};
+    Logger::SwapSinks(sinks);
+
+    const LogLevel ecsLevel = Logger::GetLevel(LogCategory::ECS_SYSTEM);
+    const LogLevel resourceLevel = Logger::GetLevel(LogCategory::RESOURCE);
+
+    auto createEntities = [] {
+        ECSWorld world;
+        for (int i = 0; i < ENTITY_COUNT; i++)
+            world.CreateEntity("Entity");
+    };
+
+    auto importModel = [&modelPath] {
+        for (int i = 0; i < IMPORT_RUNS; i++)
+            ImportScene(modelPath);
+    };
+
+    // Warm the file cache so the first timed import is not the only cold one
+    ImportScene(modelPath);
+
+    Logger::SetLevel(LogCategory::ECS_SYSTEM, LogLevel::DEBUG);
+    Logger::SetLevel(LogCategory::RESOURCE, LogLevel::DEBUG);
+    size_t before = counter.count;
+    const double entitiesLoggedMs = TimeMs(createEntities);
+    const size_t entityMessages = counter.count - before;
+
+    before = counter.count;
+    const double importLoggedMs = TimeMs(importModel);
+    const size_t importMessages = counter.count - before;
+
+    Logger::SetLevel(LogCategory::ECS_SYSTEM, LogLevel::WARNING);
+    Logger::SetLevel(LogCategory::RESOURCE, LogLevel::WARNING);
+    const double entitiesFilteredMs = TimeMs(createEntities);
+    const double importFilteredMs = TimeMs(importModel);
+
+    Logger::SetLevel(LogCategory::ECS_SYSTEM, ecsLevel);
+    Logger::SetLevel(LogCategory::RESOURCE, resourceLevel);
+    Logger::SwapSinks(sinks);
+
+    // Filtered statements cost one relaxed load; in a build with a higher
+    // LOG_COMPILE_MIN_LEVEL the "logged" runs lose their DEBUG/INFO messages too
+    LOG_INFO(CORE, "Logging benchmark (compiled-in floor {}): {} entities: {:.2f} ms logged ({} messages), "
+             "{:.2f} ms filtered | {}x import of {}: {:.2f} ms logged ({} messages), {:.2f} ms filtered",
+             LogLevelName(LOG_COMPILE_MIN_LEVEL), ENTITY_COUNT, entitiesLoggedMs, entityMessages, entitiesFilteredMs,
+             IMPORT_RUNS, modelPath, importLoggedMs, importMessages, importFilteredMs);
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+/**
+ * @brief Time entity creation and model import with their log statements written versus filtered out
+ *
+ * Output goes to a counting sink for the duration, so the numbers cover formatting and
+ * queueing rather than the console. Registered as the "Log_Benchmark" command.
+ */
+void BenchmarkLogging(const std::string &modelPath);
\ No newline at end of file
@@ -1,12 +1,13 @@
 #include "engine/Engine.h"
+#include "application/LaunchOptions.h"
 #include "core/logging/Logger.h"
 
-int main() {
+int main(int argc, char **argv) {
 #if defined (__WIN32__)
     exit()
 #endif
 
-    Engine e(1020, 800, "Allusion");
+    Engine e(LaunchOptions::Parse(argc, argv), "Allusion");
 
     if (!e.Initialize()) {
         Logger::Log(LogLevel::ERROR, "Failed to initialize game");
@@ -0,0 +1,153 @@
+#include "Broadphase.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+
+#include "core/logging/Logger.h"
+
+namespace {
+    bool Overlaps(const AABB &a, const AABB &b) {
+        return a.min.x < b.max.x && b.min.x < a.max.x &&
+               a.min.y < b.max.y && b.min.y < a.max.y &&
+               a.min.z < b.max.z && b.min.z < a.max.z;
+    }
+}
+
+void SweepAndPrune::BeginUpdate() {
+    stamp++;
+}
+
+void SweepAndPrune::UpdateProxy(entt::entity entity, const AABB &bounds, uint32_t userData) {
+    auto it = lookup.find(entity);
+    if (it != lookup.end()) {
+        Proxy &proxy = proxies[it->second];
+        proxy.bounds = bounds;
+        proxy.userData = userData;
+        proxy.stamp = stamp;
+        return;
+    }
+
+    lookup.emplace(entity, static_cast<uint32_t>(proxies.size()));
+    proxies.push_back({entity, bounds, userData, stamp});
+    inserted++;
+}
+
+void SweepAndPrune::FindPairs(std::vector<BroadphasePair> &pairs) {
+    pairs.clear();
+
+    const size_t before = proxies.size();
+    proxies.erase(std::remove_if(proxies.begin(), proxies.end(),
+                                 [&](const Proxy &p) { return p.stamp != stamp; }),
+                  proxies.end());
+
+    auto byMinX = [](const Proxy &a, const Proxy &b) { return a.bounds.min.x < b.bounds.min.x; };
+
+    if (inserted > proxies.size() / 8) {
+        // Many fresh, unordered proxies (first step, scene load): a full sort is cheaper
+        std::sort(proxies.begin(), proxies.end(), byMinX);
+    } else {
+        // Insertion sort: almost no work when last step's order still holds
+        for (size_t i = 1; i < proxies.size(); i++) {
+            Proxy moving = proxies[i];
+            size_t j = i;
+            while (j > 0 && byMinX(moving, proxies[j - 1])) {
+                proxies[j] = proxies[j - 1];
+                j--;
+            }
+            proxies[j] = moving;
+        }
+    }
+    inserted = 0;
+
+    if (before != proxies.size())
+        lookup.clear();
+
+    for (size_t i = 0; i < proxies.size(); i++)
+        lookup[proxies[i].entity] = static_cast<uint32_t>(i);
+
+    for (size_t i = 0; i < proxies.size(); i++) {
+        const AABB &a = proxies[i].bounds;
+
+        for (size_t j = i + 1; j < proxies.size(); j++) {
+            const AABB &b = proxies[j].bounds;
+            if (b.min.x >= a.max.x)
+                break;
+
+            if (a.min.y < b.max.y && b.min.y < a.max.y &&
+                a.min.z < b.max.z && b.min.z < a.max.z)
+                pairs.push_back({proxies[i].userData, proxies[j].userData});
+        }
+    }
+}
+
+void SweepAndPrune::Clear() {
+    proxies.clear();
+    lookup.clear();
+    inserted = 0;
+}
+
+size_t SweepAndPrune::GetProxyCount() const {
+    return proxies.size();
+}
+
+void BenchmarkBroadphase(const std::vector<int> &bodyCounts) {
+    using Clock = std::chrono::high_resolution_clock;
+    constexpr int STEPS = 10;
+
+    std::mt19937 rng(1337);
+
+    for (int count: bodyCounts) {
+        // Keep density roughly constant so pair counts stay comparable across sizes
+        const float extent = 10.0f * std::cbrt(static_cast<float>(count));
+        std::uniform_real_distribution<float> position(-extent, extent);
+        std::uniform_real_distribution<float> size(0.5f, 2.0f);
+        std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+
+        std::vector<AABB> boxes(count);
+        for (auto &box: boxes) {
+            glm::vec3 p(position(rng), position(rng), position(rng));
+            box.min = p;
+            box.max = p + glm::vec3(size(rng));
+        }
+
+        SweepAndPrune sap;
+        std::vector<BroadphasePair> pairs;
+        size_t brutePairs = 0;
+
+        double bruteMs = 0.0;
+        double sapMs = 0.0;
+
+        for (int step = 0; step < STEPS; step++) {
+            for (auto &box: boxes) {
+                glm::vec3 d(jitter(rng), jitter(rng), jitter(rng));
+                box.min += d;
+                box.max += d;
+            }
+
+            auto t0 = Clock::now();
+            brutePairs = 0;
+            for (int i = 0; i < count; i++)
+                for (int j = i + 1; j < count; j++)
+                    if (Overlaps(boxes[i], boxes[j]))
+                        brutePairs++;
+            auto t1 = Clock::now();
+
+            sap.BeginUpdate();
+            for (int i = 0; i < count; i++)
+                sap.UpdateProxy(static_cast<entt::entity>(i), boxes[i], static_cast<uint32_t>(i));
+            sap.FindPairs(pairs);
+            auto t2 = Clock::now();
+
+            bruteMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+            sapMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+        }
+
+        Logger::Log(LogLevel::INFO,
+                    "Broadphase benchmark: " + std::to_string(count) + " bodies | brute force " +
+                    std::to_string(bruteMs / STEPS) + " ms (" + std::to_string(brutePairs) + " pairs)" +
+                    " | sweep-and-prune " + std::to_string(sapMs / STEPS) + " ms (" +
+                    std::to_string(pairs.size()) + " pairs)");
+    }
+}
\ No newline at end of file
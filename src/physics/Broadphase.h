@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "ECS/components/Physics.h"
+
+/// Two proxies whose world bounds overlap; values are the userData passed to UpdateProxy()
+struct BroadphasePair {
+    uint32_t a;
+    uint32_t b;
+};
+
+/**
+ * @class SweepAndPrune
+ * @brief Incremental sweep-and-prune over the X axis
+ *
+ * Proxies stay sorted by min.x between steps, so the insertion sort that
+ * restores the order is close to linear while bodies move coherently.
+ * Proxies not refreshed since the last BeginUpdate() are dropped in FindPairs().
+ */
+class SweepAndPrune {
+    struct Proxy {
+        entt::entity entity;
+        AABB bounds;
+        uint32_t userData;
+        uint32_t stamp;
+    };
+
+    std::vector<Proxy> proxies;
+    std::unordered_map<entt::entity, uint32_t> lookup;
+    uint32_t stamp = 0;
+    size_t inserted = 0;
+
+public:
+    void BeginUpdate();
+
+    void UpdateProxy(entt::entity entity, const AABB &bounds, uint32_t userData);
+
+    /// Appends every overlapping pair to @p pairs (which is cleared first)
+    void FindPairs(std::vector<BroadphasePair> &pairs);
+
+    void Clear();
+
+    size_t GetProxyCount() const;
+};
+
+/**
+ * @brief Time brute-force O(n^2) pair finding against SweepAndPrune on random boxes
+ *
+ * Results go to the log. Registered as the "Physics_BenchmarkBroadphase" command.
+ */
+void BenchmarkBroadphase(const std::vector<int> &bodyCounts);
\ No newline at end of file
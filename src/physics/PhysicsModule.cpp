@@ -1,5 +1,12 @@
 #include "PhysicsModule.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "core/CommandManager.h"
+#include "core/logging/Logger.h"
+#include "physics/Broadphase.h"
+
 PhysicsModule::PhysicsModule(ECSWorld *ecs)
     : m_ecs(ecs) {
 }
@@ -7,6 +14,12 @@ PhysicsModule::PhysicsModule(ECSWorld *ecs)
 bool PhysicsModule::Initialize() {
     try {
         m_physics = std::make_unique<PhysicsSystem>();
+
+        if (!CommandManager::HasCommand("Physics_BenchmarkBroadphase"))
+            CommandManager::RegisterCommand("Physics_BenchmarkBroadphase", [](const CommandArgs &) {
+                BenchmarkBroadphase({100, 1000, 10000});
+            });
+
         isInitialized = true;
         return true;
     } catch (...) {
@@ -16,7 +29,26 @@ bool PhysicsModule::Initialize() {
 }
 
 void PhysicsModule::Update(float deltaTime) {
-    m_physics->Update(*m_ecs, deltaTime);
+    m_accumulator += deltaTime;
+
+    m_physics->BeginFixedUpdate(*m_ecs);
+
+    int steps = 0;
+    while (m_accumulator >= m_fixedTimeStep && steps < m_maxSubSteps) {
+        m_physics->Step(*m_ecs, m_fixedTimeStep);
+        m_accumulator -= m_fixedTimeStep;
+        steps++;
+    }
+
+    if (m_accumulator >= m_fixedTimeStep) {
+        Logger::Log(LogLevel::DEBUG, "Physics: dropped " +
+                                     std::to_string(static_cast<int>(m_accumulator / m_fixedTimeStep)) +
+                                     " steps after hitting the substep cap");
+        m_accumulator = std::fmod(m_accumulator, m_fixedTimeStep);
+    }
+
+    m_alpha = m_accumulator / m_fixedTimeStep;
+    m_physics->Interpolate(*m_ecs, m_alpha);
 }
 
 void PhysicsModule::Shutdown() {
@@ -35,6 +67,36 @@ bool PhysicsModule::IsRequired() const {
     return true;
 }
 
+ModuleAccess PhysicsModule::GetAccess() const {
+    // Triggers are queued on the EventBus and no components are added, so a worker can run it.
+    // Interpolate() queues moved bodies through MarkTransformDirty().
+    return ModuleAccess()
+            .Read<ColliderComponent>()
+            .Write<TransformComponent, RigidBodyComponent, PhysicsInterpolationComponent, WorldTransformComponent>()
+            .AnyThread();
+}
+
 PhysicsSystem *PhysicsModule::GetPhysics() {
     return m_physics.get();
+}
+
+void PhysicsModule::SetFixedRate(float hz) {
+    if (hz <= 0.0f) return;
+    m_fixedTimeStep = 1.0f / hz;
+}
+
+float PhysicsModule::GetFixedTimeStep() const {
+    return m_fixedTimeStep;
+}
+
+void PhysicsModule::SetMaxSubSteps(int steps) {
+    m_maxSubSteps = std::max(steps, 1);
+}
+
+int PhysicsModule::GetMaxSubSteps() const {
+    return m_maxSubSteps;
+}
+
+float PhysicsModule::GetInterpolationAlpha() const {
+    return m_alpha;
 }
\ No newline at end of file
@@ -12,6 +12,11 @@ class PhysicsModule : public IModule {
     std::unique_ptr<PhysicsSystem> m_physics;
     ECSWorld *m_ecs = nullptr;
 
+    float m_fixedTimeStep = 1.0f / 60.0f;
+    int m_maxSubSteps = 8;
+    float m_accumulator = 0.0f;
+    float m_alpha = 0.0f;
+
 public:
     PhysicsModule(ECSWorld *ecs);
 
@@ -33,7 +38,22 @@ public:
 
     bool IsRequired() const override;
 
+    ModuleAccess GetAccess() const override;
+
     /// @}
 
     PhysicsSystem *GetPhysics();
+
+    /// Simulation rate in steps per second, independent of the frame rate
+    void SetFixedRate(float hz);
+
+    float GetFixedTimeStep() const;
+
+    /// Cap on steps per frame; time beyond it is dropped so a hitch cannot spiral
+    void SetMaxSubSteps(int steps);
+
+    int GetMaxSubSteps() const;
+
+    /// Fraction of a step left in the accumulator, used to blend rendered positions
+    float GetInterpolationAlpha() const;
 };
\ No newline at end of file
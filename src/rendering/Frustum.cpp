@@ -0,0 +1,55 @@
+#include "Frustum.h"
+
+Frustum::Frustum(const glm::mat4 &viewProjection) {
+    Update(viewProjection);
+}
+
+void Frustum::Update(const glm::mat4 &viewProjection) {
+    const glm::mat4 &m = viewProjection;
+
+    auto row = [&](int i) {
+        return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+    };
+
+    planes[0] = row(3) + row(0); // left
+    planes[1] = row(3) - row(0); // right
+    planes[2] = row(3) + row(1); // bottom
+    planes[3] = row(3) - row(1); // top
+    planes[4] = row(3) + row(2); // near
+    planes[5] = row(3) - row(2); // far
+
+    for (auto &plane: planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f)
+            plane /= length;
+    }
+}
+
+bool Frustum::IntersectsSphere(const glm::vec3 &center, float radius) const {
+    for (const auto &plane: planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+bool Frustum::IntersectsAABB(const glm::vec3 &min, const glm::vec3 &max) const {
+    const glm::vec3 center = (min + max) * 0.5f;
+    const glm::vec3 extents = (max - min) * 0.5f;
+
+    for (const auto &plane: planes) {
+        const glm::vec3 normal(plane);
+        const float reach = glm::dot(extents, glm::abs(normal));
+        if (glm::dot(normal, center) + plane.w < -reach)
+            return false;
+    }
+    return true;
+}
+
+bool Frustum::Intersects(const MeshBounds &worldBounds) const {
+    if (!worldBounds.valid)
+        return true;
+
+    return IntersectsSphere(worldBounds.center, worldBounds.radius) &&
+           IntersectsAABB(worldBounds.min, worldBounds.max);
+}
\ No newline at end of file
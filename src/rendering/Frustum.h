@@ -0,0 +1,32 @@
+#pragma once
+
+#include <array>
+
+#include <glm/glm.hpp>
+
+#include "rendering/MeshData.h"
+
+/**
+ * @class Frustum
+ * @brief Six clip planes extracted from a view-projection matrix
+ *
+ * Plane normals point inwards, so a point is inside when every
+ * dot(normal, p) + d is non-negative.
+ */
+class Frustum {
+    std::array<glm::vec4, 6> planes{};
+
+public:
+    Frustum() = default;
+
+    explicit Frustum(const glm::mat4 &viewProjection);
+
+    void Update(const glm::mat4 &viewProjection);
+
+    bool IntersectsSphere(const glm::vec3 &center, float radius) const;
+
+    bool IntersectsAABB(const glm::vec3 &min, const glm::vec3 &max) const;
+
+    /// @param worldBounds Bounds already moved to world space; invalid bounds are never culled
+    bool Intersects(const MeshBounds &worldBounds) const;
+};
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "LightClusters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "core/JobSystem.h"
+
+namespace {
+    /// Grow-only capacity so steady frames re-specify the same store size
+    void UploadStorage(std::unique_ptr<UniformBuffer> &buffer, const void *data, size_t bytes, GLuint binding) {
+        if (!buffer)
+            buffer = std::make_unique<UniformBuffer>(GL_SHADER_STORAGE_BUFFER, GL_STREAM_DRAW);
+
+        // A zero-sized range cannot be bound, and the shader still declares the block
+        const size_t needed = std::max<size_t>(bytes, 16);
+        buffer->Allocate(std::max(needed + needed / 2, buffer->GetSize()));
+
+        if (bytes > 0)
+            buffer->SetData(data, bytes);
+        buffer->BindBase(binding);
+    }
+}
+
+void LightClusters::SetupGrid(const glm::mat4 &proj, int viewportWidth, int viewportHeight) {
+    projection = proj;
+    orthographic = proj[2][3] == 0.0f;
+
+    if (orthographic) {
+        nearPlane = (proj[3][2] + 1.0f) / proj[2][2];
+        farPlane = (proj[3][2] - 1.0f) / proj[2][2];
+    } else {
+        nearPlane = proj[3][2] / (proj[2][2] - 1.0f);
+        farPlane = proj[3][2] / (proj[2][2] + 1.0f);
+    }
+
+    // Log slicing needs a positive near plane, and an orthographic one may sit at or behind the eye
+    nearPlane = std::max(nearPlane, 0.05f);
+    farPlane = std::max(farPlane, nearPlane * 2.0f);
+
+    const float logRatio = std::log(farPlane / nearPlane);
+    zScale = static_cast<float>(SLICES) / logRatio;
+    zBias = static_cast<float>(SLICES) * std::log(nearPlane) / logRatio;
+
+    tileSize = glm::vec2(std::max(viewportWidth, 1), std::max(viewportHeight, 1)) /
+               glm::vec2(TILES_X, TILES_Y);
+}
+
+bool LightClusters::NdcToTiles(float minNdc, float maxNdc, uint32_t tiles, uint32_t &first, uint32_t &last) {
+    if (maxNdc < -1.0f || minNdc > 1.0f)
+        return false;
+
+    const float scale = static_cast<float>(tiles) * 0.5f;
+    const float lo = std::floor((std::max(minNdc, -1.0f) + 1.0f) * scale);
+    const float hi = std::floor((std::min(maxNdc, 1.0f) + 1.0f) * scale);
+
+    first = static_cast<uint32_t>(std::clamp(lo, 0.0f, static_cast<float>(tiles - 1)));
+    last = static_cast<uint32_t>(std::clamp(hi, 0.0f, static_cast<float>(tiles - 1)));
+    return true;
+}
+
+void LightClusters::BinSlice(uint32_t slice) {
+    SliceBins &bins = slices[slice];
+    bins.counts.assign(TILE_COUNT, 0);
+    bins.offsets.resize(TILE_COUNT);
+    bins.indices.clear();
+    bins.rects.clear();
+    bins.rectLights.clear();
+
+    const float ratio = farPlane / nearPlane;
+    const float sliceNear = nearPlane * std::pow(ratio, static_cast<float>(slice) / SLICES);
+    const float sliceFar = nearPlane * std::pow(ratio, static_cast<float>(slice + 1) / SLICES);
+
+    const float p00 = projection[0][0];
+    const float p11 = projection[1][1];
+    const float p20 = projection[2][0];
+    const float p21 = projection[2][1];
+    const float p30 = projection[3][0];
+    const float p31 = projection[3][1];
+
+    const size_t count = radius.size();
+    for (size_t i = 0; i < count; i++) {
+        const float r = radius[i];
+        const float nearDepth = std::max(sliceNear, centerDepth[i] - r);
+        const float farDepth = std::min(sliceFar, centerDepth[i] + r);
+        if (nearDepth > farDepth)
+            continue;
+
+        const float x0 = centerX[i] - r;
+        const float x1 = centerX[i] + r;
+        const float y0 = centerY[i] - r;
+        const float y1 = centerY[i] + r;
+
+        float minX, maxX, minY, maxY;
+        if (orthographic) {
+            minX = p00 * x0 + p30;
+            maxX = p00 * x1 + p30;
+            minY = p11 * y0 + p31;
+            maxY = p11 * y1 + p31;
+        } else {
+            // x / depth is monotonic in depth, so the box's extremes sit at the clipped near or far depth
+            const float invNear = 1.0f / nearDepth;
+            const float invFar = 1.0f / farDepth;
+            minX = p00 * std::min(x0 * invNear, x0 * invFar) - p20;
+            maxX = p00 * std::max(x1 * invNear, x1 * invFar) - p20;
+            minY = p11 * std::min(y0 * invNear, y0 * invFar) - p21;
+            maxY = p11 * std::max(y1 * invNear, y1 * invFar) - p21;
+        }
+
+        uint32_t tx0, tx1, ty0, ty1;
+        if (!NdcToTiles(minX, maxX, TILES_X, tx0, tx1) || !NdcToTiles(minY, maxY, TILES_Y, ty0, ty1))
+            continue;
+
+        bins.rects.emplace_back(tx0, tx1, ty0, ty1);
+        bins.rectLights.push_back(lightIndex[i]);
+
+        for (uint32_t y = ty0; y <= ty1; y++)
+            for (uint32_t x = tx0; x <= tx1; x++)
+                bins.counts[y * TILES_X + x]++;
+    }
+
+    uint32_t total = 0;
+    for (uint32_t tile = 0; tile < TILE_COUNT; tile++) {
+        bins.offsets[tile] = total;
+        total += bins.counts[tile];
+    }
+
+    bins.indices.resize(total);
+    std::vector<uint32_t> cursor = bins.offsets;
+
+    for (size_t r = 0; r < bins.rects.size(); r++) {
+        const glm::uvec4 &rect = bins.rects[r];
+        for (uint32_t y = rect.z; y <= rect.w; y++)
+            for (uint32_t x = rect.x; x <= rect.y; x++)
+                bins.indices[cursor[y * TILES_X + x]++] = bins.rectLights[r];
+    }
+}
+
+void LightClusters::Build(const std::vector<LightBlock> &frameLights, uint32_t directional,
+                          const glm::mat4 &view, const glm::mat4 &proj, int viewportWidth, int viewportHeight) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    lights = &frameLights;
+    directionalCount = std::min<uint32_t>(directional, static_cast<uint32_t>(frameLights.size()));
+    SetupGrid(proj, viewportWidth, viewportHeight);
+
+    centerX.clear();
+    centerY.clear();
+    centerDepth.clear();
+    radius.clear();
+    lightIndex.clear();
+
+    for (uint32_t i = directionalCount; i < frameLights.size(); i++) {
+        const LightBlock &light = frameLights[i];
+        const glm::vec4 center = view * glm::vec4(light.position, 1.0f);
+        const float depth = -center.z;
+
+        if (cullingEnabled && (depth + light.range < nearPlane || depth - light.range > farPlane))
+            continue;
+
+        centerX.push_back(center.x);
+        centerY.push_back(center.y);
+        centerDepth.push_back(depth);
+        radius.push_back(light.range);
+        lightIndex.push_back(i);
+    }
+
+    ranges.resize(CLUSTER_COUNT);
+    indices.clear();
+    maxClusterLights = 0;
+
+    if (!cullingEnabled) {
+        indices = lightIndex;
+        std::fill(ranges.begin(), ranges.end(), glm::uvec2(0, static_cast<uint32_t>(indices.size())));
+        maxClusterLights = static_cast<uint32_t>(indices.size());
+    } else if (!lightIndex.empty()) {
+        GetJobSystem().ParallelFor(SLICES, 1, [this](size_t begin, size_t end) {
+            for (size_t slice = begin; slice < end; slice++)
+                BinSlice(static_cast<uint32_t>(slice));
+        });
+
+        for (uint32_t slice = 0; slice < SLICES; slice++) {
+            const SliceBins &bins = slices[slice];
+            const uint32_t base = static_cast<uint32_t>(indices.size());
+
+            for (uint32_t tile = 0; tile < TILE_COUNT; tile++) {
+                ranges[slice * TILE_COUNT + tile] = glm::uvec2(base + bins.offsets[tile], bins.counts[tile]);
+                maxClusterLights = std::max(maxClusterLights, bins.counts[tile]);
+            }
+
+            indices.insert(indices.end(), bins.indices.begin(), bins.indices.end());
+        }
+    } else {
+        std::fill(ranges.begin(), ranges.end(), glm::uvec2(0));
+    }
+
+    buildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void LightClusters::Upload() {
+    const size_t lightBytes = lights ? lights->size() * sizeof(LightBlock) : 0;
+
+    UploadStorage(lightBuffer, lights ? lights->data() : nullptr, lightBytes, LIGHT_BLOCK_BINDING);
+    UploadStorage(clusterBuffer, ranges.data(), ranges.size() * sizeof(glm::uvec2), CLUSTER_BLOCK_BINDING);
+    UploadStorage(indexBuffer, indices.data(), indices.size() * sizeof(uint32_t), LIGHT_INDEX_BLOCK_BINDING);
+}
+
+void LightClusters::WriteFrameParams(FrameBlock &frame) const {
+    frame.clusterGrid = glm::uvec4(TILES_X, TILES_Y, SLICES, directionalCount);
+    frame.clusterDepth = glm::vec4(zScale, zBias, tileSize.x, tileSize.y);
+    frame.numLights = lights ? static_cast<int>(lights->size()) : 0;
+}
+
+void LightClusters::SetCullingEnabled(bool enable) {
+    cullingEnabled = enable;
+}
+
+bool LightClusters::IsCullingEnabled() const {
+    return cullingEnabled;
+}
+
+double LightClusters::GetBuildMs() const {
+    return buildMs;
+}
+
+size_t LightClusters::GetIndexCount() const {
+    return indices.size();
+}
+
+uint32_t LightClusters::GetMaxClusterLights() const {
+    return maxClusterLights;
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "rendering/core/UniformBuffer.h"
+#include "rendering/ShaderBlocks.h"
+
+/**
+ * @class LightClusters
+ * @brief CPU light culling into a view-space froxel grid for clustered forward shading
+ *
+ * The grid is TILES_X x TILES_Y screen tiles by SLICES exponentially spaced depth
+ * slices. Point and spot lights are binned by their range sphere; each slice is
+ * binned on its own job, so slices never share output. Directional lights are
+ * not binned: they occupy the first entries of the light array and every
+ * fragment applies them.
+ *
+ * Upload() publishes three storage buffers: the lights (LIGHT_BLOCK_BINDING),
+ * an (offset, count) pair per cluster (CLUSTER_BLOCK_BINDING) and the flattened
+ * per-cluster light indices (LIGHT_INDEX_BLOCK_BINDING).
+ */
+class LightClusters {
+public:
+    static constexpr uint32_t TILES_X = 16;
+    static constexpr uint32_t TILES_Y = 9;
+    static constexpr uint32_t SLICES = 24;
+    static constexpr uint32_t TILE_COUNT = TILES_X * TILES_Y;
+    static constexpr uint32_t CLUSTER_COUNT = TILE_COUNT * SLICES;
+
+private:
+    /// Per-slice output, merged into ranges/indices after the jobs finish
+    struct SliceBins {
+        std::vector<uint32_t> counts;
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> indices;
+        /// Light and its tile rectangle, inclusive
+        std::vector<glm::uvec4> rects;
+        std::vector<uint32_t> rectLights;
+    };
+
+    // View-space range spheres of the binned lights, one array per component so the slice loops stay linear
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerDepth;
+    std::vector<float> radius;
+    std::vector<uint32_t> lightIndex;
+
+    std::vector<SliceBins> slices = std::vector<SliceBins>(SLICES);
+
+    std::vector<glm::uvec2> ranges;
+    std::vector<uint32_t> indices;
+
+    const std::vector<LightBlock> *lights = nullptr;
+    uint32_t directionalCount = 0;
+
+    glm::mat4 projection{1.0f};
+    bool orthographic = false;
+    float nearPlane = 0.1f;
+    float farPlane = 1000.0f;
+    float zScale = 0.0f;
+    float zBias = 0.0f;
+    glm::vec2 tileSize{1.0f};
+
+    bool cullingEnabled = true;
+
+    std::unique_ptr<UniformBuffer> lightBuffer;
+    std::unique_ptr<UniformBuffer> clusterBuffer;
+    std::unique_ptr<UniformBuffer> indexBuffer;
+
+    double buildMs = 0.0;
+    uint32_t maxClusterLights = 0;
+
+    void SetupGrid(const glm::mat4 &proj, int viewportWidth, int viewportHeight);
+
+    void BinSlice(uint32_t slice);
+
+    /// Inclusive tile range covered by [minNdc, maxNdc] on one axis, or false if off screen
+    static bool NdcToTiles(float minNdc, float maxNdc, uint32_t tiles, uint32_t &first, uint32_t &last);
+
+public:
+    /**
+     * @brief Bin the point and spot lights of @p frameLights into the grid
+     * @param frameLights All lights, directional ones first; must stay alive until Upload()
+     * @param directional Number of leading directional lights
+     */
+    void Build(const std::vector<LightBlock> &frameLights, uint32_t directional,
+               const glm::mat4 &view, const glm::mat4 &proj, int viewportWidth, int viewportHeight);
+
+    /// Upload lights and cluster lists and bind them to their storage block bindings
+    void Upload();
+
+    /// Grid dimensions and depth slicing for the shader
+    void WriteFrameParams(FrameBlock &frame) const;
+
+    /// When disabled, every cluster lists every light: the shading cost of the old per-fragment loop
+    void SetCullingEnabled(bool enable);
+
+    bool IsCullingEnabled() const;
+
+    double GetBuildMs() const;
+
+    size_t GetIndexCount() const;
+
+    uint32_t GetMaxClusterLights() const;
+};
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "MaterialBuffer.h"
+
+#include <algorithm>
+
+#include "rendering/ShaderBlocks.h"
+#include "resource/material/Material.h"
+
+namespace {
+    uint64_t NextGeneration() {
+        static uint64_t counter = 1;
+        return counter++;
+    }
+}
+
+MaterialBuffer::MaterialBuffer()
+    : generation(NextGeneration()) {
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+    const size_t align = static_cast<size_t>(std::max(alignment, 1));
+    stride = (sizeof(MaterialBlock) + align - 1) / align * align;
+
+    buffer.Allocate(stride * 64);
+}
+
+void MaterialBuffer::Bind(Material &material) {
+    const size_t offset = static_cast<size_t>(material.GetID()) * stride;
+
+    if (offset + stride > buffer.GetSize())
+        buffer.Reserve(std::max(offset + stride, buffer.GetSize() * 2));
+
+    if (material.blockDirty || material.blockGeneration != generation) {
+        const MaterialBlock block = material.GetBlock();
+        buffer.SetData(&block, sizeof(block), offset);
+
+        material.blockDirty = false;
+        material.blockGeneration = generation;
+        uploads++;
+    }
+
+    buffer.BindRange(MATERIAL_BLOCK_BINDING, offset, sizeof(MaterialBlock));
+}
+
+size_t MaterialBuffer::GetUploadCount() const {
+    return uploads;
+}
+
+void MaterialBuffer::ResetStats() {
+    uploads = 0;
+}
\ No newline at end of file
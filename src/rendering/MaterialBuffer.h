@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "rendering/core/UniformBuffer.h"
+
+class Material;
+
+/**
+ * @class MaterialBuffer
+ * @brief Every material's MaterialBlock in one persistent UBO, one aligned slot per material ID
+ *
+ * A material is re-uploaded only when it changed since its last upload, so
+ * switching materials costs one glBindBufferRange.
+ */
+class MaterialBuffer {
+    UniformBuffer buffer{GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW};
+    size_t stride = 0;
+
+    /// Distinguishes buffers across renderer restarts, so materials know their slot is gone
+    uint64_t generation;
+
+    size_t uploads = 0;
+
+public:
+    MaterialBuffer();
+
+    /// Upload @p material if stale and bind its slot to MATERIAL_BLOCK_BINDING
+    void Bind(Material &material);
+
+    /// Slot uploads since the last ResetStats()
+    size_t GetUploadCount() const;
+
+    void ResetStats();
+};
\ No newline at end of file
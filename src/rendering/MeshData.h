@@ -4,6 +4,8 @@
 
 #include <glm/glm.hpp>
 
+#include "resource/texture/TextureHandle.h"
+
 struct Vertex {
     glm::vec3 Position;
     glm::vec3 Normal;
@@ -13,8 +15,50 @@ struct Vertex {
     glm::vec3 Bitangent;
 };
 
+/**
+ * @brief Axis-aligned box and bounding sphere of a mesh
+ *
+ * Meshes keep these in local space; Transform() produces the world-space
+ * bounds used by the culling tests.
+ */
+struct MeshBounds {
+    glm::vec3 min{0.0f};
+    glm::vec3 max{0.0f};
+    glm::vec3 center{0.0f};
+    float radius = 0.0f;
+    bool valid = false;
+
+    MeshBounds Transform(const glm::mat4 &model) const {
+        if (!valid)
+            return *this;
+
+        const glm::vec3 localCenter = (min + max) * 0.5f;
+        const glm::vec3 extents = (max - min) * 0.5f;
+
+        const glm::vec3 worldCenter = glm::vec3(model * glm::vec4(localCenter, 1.0f));
+        const glm::vec3 worldExtents =
+                glm::abs(glm::vec3(model[0])) * extents.x +
+                glm::abs(glm::vec3(model[1])) * extents.y +
+                glm::abs(glm::vec3(model[2])) * extents.z;
+
+        const float maxScale = glm::max(glm::length(glm::vec3(model[0])),
+                                        glm::max(glm::length(glm::vec3(model[1])),
+                                                 glm::length(glm::vec3(model[2]))));
+
+        MeshBounds world;
+        world.min = worldCenter - worldExtents;
+        world.max = worldCenter + worldExtents;
+        world.center = glm::vec3(model * glm::vec4(center, 1.0f));
+        world.radius = radius * maxScale;
+        world.valid = true;
+        return world;
+    }
+};
+
 struct Texture {
     unsigned int id;
     std::string type;
     std::string path;
+    /// Keeps the GL texture alive for as long as a material uses it
+    TextureRef ref;
 };
\ No newline at end of file
@@ -1,14 +1,22 @@
 #include "MeshRenderer.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include <glm/glm.hpp>
+
 #include "core/logging/Logger.h"
 
-MeshRenderer::MeshRenderer(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices) {
+MeshRenderer::MeshRenderer(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices)
+    : MeshRenderer(vertices.data(), vertices.size(), indices.data(), indices.size()) {
+}
+
+MeshRenderer::MeshRenderer(const Vertex *vertices, size_t vertexCount, const unsigned int *indices,
+                           size_t indexCount) {
     usedIndices = true;
-    indexCount = indices.size();
+    this->indexCount = indexCount;
 
-    Logger::Log(LogLevel::INFO, "MeshRenderer created with " +
-                                std::to_string(vertices.size()) + " vertices and " +
-                                std::to_string(indexCount) + " indices");
+    LOG_INFO(RENDERING, "MeshRenderer created with {} vertices and {} indices", vertexCount, indexCount);
 
     VAO = std::make_unique<VertexArray>();
     VBO = std::make_unique<VertexBuffer>();
@@ -17,10 +25,10 @@ MeshRenderer::MeshRenderer(const std::vector<Vertex> &vertices, const std::vecto
     VAO->Bind();
 
     VBO->Bind();
-    VBO->SetData(vertices.data(), vertices.size() * sizeof(Vertex), GL_STATIC_DRAW);
+    VBO->SetData(vertices, vertexCount * sizeof(Vertex), GL_STATIC_DRAW);
 
     EBO->Bind();
-    EBO->SetData(indices.data(), static_cast<unsigned int>(indices.size()), GL_STATIC_DRAW);
+    EBO->SetData(indices, static_cast<unsigned int>(indexCount), GL_STATIC_DRAW);
 
     VAO->AddAttribute(0, 3, GL_FLOAT, false, sizeof(Vertex), 0); // Position
     VAO->AddAttribute(1, 3, GL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, Normal)); // Normal
@@ -30,15 +38,16 @@ MeshRenderer::MeshRenderer(const std::vector<Vertex> &vertices, const std::vecto
 
     VAO->Unbind();
 
-    Logger::Log(LogLevel::INFO, "MeshRenderer attributes configured successfully");
+    ComputeBounds(reinterpret_cast<const float *>(vertices), vertexCount, sizeof(Vertex) / sizeof(float));
+
+    LOG_INFO(RENDERING, "MeshRenderer attributes configured successfully");
 }
 
 MeshRenderer::MeshRenderer(const float *data, size_t dataSize, int stride) {
     usedIndices = false;
     vertexCount = dataSize / (stride * sizeof(float));
 
-    Logger::Log(LogLevel::INFO, "MeshRenderer created from raw data: " +
-                                std::to_string(vertexCount) + " vertices, stride=" + std::to_string(stride));
+    LOG_INFO(RENDERING, "MeshRenderer created from raw data: {} vertices, stride={}", vertexCount, stride);
 
     VAO = std::make_unique<VertexArray>();
     VBO = std::make_unique<VertexBuffer>();
@@ -53,6 +62,36 @@ MeshRenderer::MeshRenderer(const float *data, size_t dataSize, int stride) {
     VAO->AddAttribute(2, 2, GL_FLOAT, false, stride * sizeof(float), 6 * sizeof(float));
 
     VAO->Unbind();
+
+    ComputeBounds(data, vertexCount, static_cast<size_t>(stride));
+}
+
+void MeshRenderer::ComputeBounds(const float *data, size_t count, size_t stride) {
+    // Position is always the first three floats of a vertex
+    if (!data || count == 0)
+        return;
+
+    bounds.min = glm::vec3(data[0], data[1], data[2]);
+    bounds.max = bounds.min;
+
+    for (size_t i = 1; i < count; i++) {
+        const float *p = data + i * stride;
+        const glm::vec3 position(p[0], p[1], p[2]);
+        bounds.min = glm::min(bounds.min, position);
+        bounds.max = glm::max(bounds.max, position);
+    }
+
+    bounds.center = (bounds.min + bounds.max) * 0.5f;
+
+    float radiusSq = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        const float *p = data + i * stride;
+        const glm::vec3 offset = glm::vec3(p[0], p[1], p[2]) - bounds.center;
+        radiusSq = std::max(radiusSq, glm::dot(offset, offset));
+    }
+
+    bounds.radius = std::sqrt(radiusSq);
+    bounds.valid = true;
 }
 
 void MeshRenderer::Draw() {
@@ -64,6 +103,30 @@ void MeshRenderer::Draw() {
     VAO->Unbind();
 }
 
+void MeshRenderer::Bind(GLContext &context) const {
+    context.BindVAO(VAO->GetID());
+}
+
+void MeshRenderer::DrawBound(GLContext &context) const {
+    if (usedIndices)
+        context.DrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, 0);
+    else
+        context.DrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertexCount));
+}
+
+void MeshRenderer::DrawInstanced(GLContext &context, GLsizei instanceCount, GLuint baseInstance) const {
+    if (usedIndices)
+        context.DrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, 0,
+                                      instanceCount, baseInstance);
+    else
+        context.DrawArraysInstanced(GL_TRIANGLES, 0, static_cast<GLsizei>(vertexCount),
+                                    instanceCount, baseInstance);
+}
+
 size_t MeshRenderer::GetVertexCount() const {
     return vertexCount;
+}
+
+const MeshBounds &MeshRenderer::GetBounds() const {
+    return bounds;
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "rendering/core/VertexBuffer.h"
 #include "rendering/core/VertexArray.h"
 #include "rendering/core/IndexBuffer.h"
+#include "rendering/core/GLContext.h"
 #include "MeshData.h"
 
 class MeshRenderer {
@@ -21,12 +22,30 @@ private:
     size_t vertexCount = 0;
     bool usedIndices = false;
 
+    MeshBounds bounds;
+
+    void ComputeBounds(const float *data, size_t count, size_t stride);
+
 public:
     MeshRenderer(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices);
 
+    MeshRenderer(const Vertex *vertices, size_t vertexCount, const unsigned int *indices, size_t indexCount);
+
     MeshRenderer(const float *data, size_t dataSize, int stride);
 
     void Draw();
 
+    /// @name Tracked path used by RenderQueue: bind once, draw many
+    /// @{
+    void Bind(GLContext &context) const;
+
+    void DrawBound(GLContext &context) const;
+
+    void DrawInstanced(GLContext &context, GLsizei instanceCount, GLuint baseInstance) const;
+
+    /// @}
+
     size_t GetVertexCount() const;
+
+    const MeshBounds &GetBounds() const;
 };
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glad/glad.h>
+
+/// Typed commands the render passes send to the Renderer; see CommandManager::Execute
+
+struct RenderGeometryCommand {
+    static constexpr const char *NAME = "Renderer_RenderGeometry";
+
+    struct Args {
+        const glm::mat4 &view;
+        const glm::mat4 &projection;
+        const std::string &shaderName;
+
+        /// Cascade and spot light matrices, in shadow array layer order
+        std::span<const glm::mat4> lightSpaceMatrices;
+        /// 0 renders without shadows
+        GLuint shadowMapArray = 0;
+        const std::vector<int> *shadowMapIndices = nullptr;
+        GLuint cubeShadowMapArray = 0;
+        const std::vector<int> *cubeShadowMapIndices = nullptr;
+
+        glm::vec4 cascadeSplits{0.0f};
+        int cascadeCount = 0;
+    };
+};
+
+struct RenderUICommand {
+    static constexpr const char *NAME = "Renderer_RenderUI";
+
+    struct Args {
+        const glm::mat4 &view;
+        const glm::mat4 &projection;
+        const std::string &shaderName;
+    };
+};
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+
+uint64_t RenderQueue::MakeKey(RenderPassType pass, uint32_t shader, uint32_t material,
+                              uint32_t mesh, float depth01) {
+    constexpr uint64_t depthMax = (1ull << DEPTH_BITS) - 1;
+
+    float d = std::clamp(depth01, 0.0f, 1.0f);
+    if (pass == RenderPassType::TRANSPARENT)
+        d = 1.0f - d;
+
+    uint64_t depth = static_cast<uint64_t>(d * static_cast<float>(depthMax));
+
+    uint64_t key = 0;
+    key |= (static_cast<uint64_t>(pass) & 0xF) << 60;
+    key |= (static_cast<uint64_t>(shader) & ((1ull << SHADER_BITS) - 1)) << 52;
+    key |= (static_cast<uint64_t>(material) & ((1ull << MATERIAL_BITS) - 1)) << 36;
+    key |= (static_cast<uint64_t>(mesh) & ((1ull << MESH_BITS) - 1)) << DEPTH_BITS;
+    key |= depth & depthMax;
+    return key;
+}
+
+void RenderQueue::Clear() {
+    items.clear();
+    sorted.clear();
+}
+
+void RenderQueue::Push(const DrawItem &item) {
+    items.push_back(item);
+}
+
+void RenderQueue::Sort() {
+    const size_t count = items.size();
+
+    sorted.resize(count);
+    scratch.resize(count);
+
+    for (size_t i = 0; i < count; i++)
+        sorted[i] = {items[i].key, static_cast<uint32_t>(i)};
+
+    // LSD radix sort, one byte per pass; passes where every key shares the byte are skipped
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t histogram[256] = {};
+
+        for (const auto &entry: sorted)
+            histogram[(entry.key >> shift) & 0xFF]++;
+
+        if (count == 0 || histogram[(sorted[0].key >> shift) & 0xFF] == count)
+            continue;
+
+        size_t offset = 0;
+        for (auto &bucket: histogram) {
+            size_t n = bucket;
+            bucket = offset;
+            offset += n;
+        }
+
+        for (const auto &entry: sorted)
+            scratch[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+
+        sorted.swap(scratch);
+    }
+}
+
+bool RenderQueue::CanInstance(const DrawItem &a, const DrawItem &b) const {
+    if (a.color || b.color)
+        return false;
+
+    return a.shader == b.shader && a.material == b.material && a.mesh == b.mesh;
+}
+
+void RenderQueue::BuildBatches() {
+    batches.clear();
+    drawData.clear();
+
+    const uint32_t count = static_cast<uint32_t>(sorted.size());
+    uint32_t first = 0;
+
+    for (const auto &entry: sorted) {
+        const DrawItem &item = items[entry.index];
+        drawData.push_back({*item.model, glm::vec4(item.tiling, 0.0f, 0.0f)});
+    }
+
+    while (first < count) {
+        const DrawItem &head = items[sorted[first].index];
+
+        uint32_t last = first + 1;
+        if (instancingEnabled) {
+            while (last < count && CanInstance(head, items[sorted[last].index]))
+                last++;
+        }
+
+        const uint32_t run = last - first;
+        if (run >= minInstanceCount) {
+            batches.push_back({first, run});
+        } else {
+            for (uint32_t i = first; i < last; i++)
+                batches.push_back({i, 1});
+        }
+
+        first = last;
+    }
+}
+
+void RenderQueue::UploadDraws() {
+    if (drawData.empty())
+        return;
+
+    if (!drawBuffer)
+        drawBuffer = std::make_unique<UniformBuffer>(GL_SHADER_STORAGE_BUFFER, GL_STREAM_DRAW);
+
+    const size_t bytes = drawData.size() * sizeof(DrawBlock);
+    const size_t capacity = std::max(bytes + bytes / 2, drawBuffer->GetSize());
+
+    drawBuffer->Allocate(capacity);
+    drawBuffer->SetData(drawData.data(), bytes);
+    drawBuffer->BindBase(DRAW_BLOCK_BINDING);
+}
+
+void RenderQueue::Submit(GLContext &context, MaterialBuffer &materialBuffer) {
+    stats.Reset();
+    stats.items = static_cast<int>(sorted.size());
+
+    BuildBatches();
+    UploadDraws();
+
+    ShaderObj *currentShader = nullptr;
+    Material *currentMaterial = nullptr;
+    Mesh *currentMesh = nullptr;
+
+    for (const auto &batch: batches) {
+        const DrawItem &item = items[sorted[batch.first].index];
+
+        MeshRenderer *meshRenderer = item.mesh ? item.mesh->GetMeshRenderer() : nullptr;
+        if (!item.shader || !meshRenderer)
+            continue;
+
+        if (item.shader != currentShader) {
+            currentShader = item.shader;
+            context.UseShader(currentShader->ID);
+            stats.shaderChanges++;
+        }
+
+        if (item.color)
+            item.mesh->SetColor(*item.color);
+
+        if (item.material != currentMaterial || item.color) {
+            currentMaterial = item.material;
+            if (currentMaterial)
+                currentMaterial->Apply(materialBuffer, &context);
+            stats.materialChanges++;
+        }
+
+        if (item.mesh != currentMesh) {
+            currentMesh = item.mesh;
+            meshRenderer->Bind(context);
+            stats.meshChanges++;
+        }
+
+        // Singles go through the same call with one instance, so they find their DrawBlock too
+        meshRenderer->DrawInstanced(context, static_cast<GLsizei>(batch.count), batch.first);
+
+        if (batch.count > 1) {
+            stats.instancedBatches++;
+            stats.instancedItems += static_cast<int>(batch.count);
+        } else {
+            stats.singletonDraws++;
+        }
+    }
+
+    context.UnbindVAO();
+
+    if (currentMaterial)
+        currentMaterial->Unbind();
+}
+
+void RenderQueue::SetInstancingEnabled(bool enable) {
+    instancingEnabled = enable;
+}
+
+void RenderQueue::SetMinInstanceCount(uint32_t count) {
+    minInstanceCount = std::max(count, 2u);
+}
+
+size_t RenderQueue::Size() const {
+    return items.size();
+}
+
+const std::vector<DrawItem> &RenderQueue::GetItems() const {
+    return items;
+}
+
+const RenderQueueStats &RenderQueue::GetStats() const {
+    return stats;
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <memory>
+
+#include "rendering/core/GLContext.h"
+#include "rendering/core/UniformBuffer.h"
+#include "rendering/MaterialBuffer.h"
+#include "rendering/ShaderBlocks.h"
+#include "resource/shader/ShaderManager.h"
+#include "resource/material/Material.h"
+#include "scene/Mesh.h"
+
+enum class RenderPassType : uint8_t {
+    OPAQUE = 0,
+    TRANSPARENT = 1
+};
+
+/**
+ * @brief One mesh draw waiting in the queue
+ *
+ * Pointers stay owned by the ECS and must outlive the frame's Submit().
+ */
+struct DrawItem {
+    uint64_t key = 0;
+
+    ShaderObj *shader = nullptr;
+    Material *material = nullptr;
+    Mesh *mesh = nullptr;
+
+    const glm::mat4 *model = nullptr;
+    glm::vec2 tiling{1.0f};
+
+    /// ColorComponent override; forces the material to be re-applied for this item
+    const glm::vec3 *color = nullptr;
+};
+
+struct RenderQueueStats {
+    int items = 0;
+    int shaderChanges = 0;
+    int materialChanges = 0;
+    int meshChanges = 0;
+
+    int instancedBatches = 0;
+    int instancedItems = 0;
+    int singletonDraws = 0;
+
+    void Reset() {
+        items = 0;
+        shaderChanges = 0;
+        materialChanges = 0;
+        meshChanges = 0;
+        instancedBatches = 0;
+        instancedItems = 0;
+        singletonDraws = 0;
+    }
+};
+
+/**
+ * @class RenderQueue
+ * @brief Collects draw items, radix-sorts them by a 64-bit key and submits
+ * them touching GL state only when the shader, material or mesh changes.
+ *
+ * Key layout (most significant first):
+ *   pass (4) | shader (8) | material (16) | mesh (16) | depth (20)
+ *
+ * Every item's model matrix and tiling go into one per-frame DrawBlock storage
+ * buffer, and each batch is drawn with its first entry as base instance, so the
+ * shader reads its block at gl_BaseInstance + gl_InstanceID. Runs of adjacent
+ * items sharing shader, material and mesh (and without a color override) become
+ * one instanced draw. Material parameters come from MaterialBuffer, one
+ * glBindBufferRange per material switch.
+ */
+class RenderQueue {
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    /// A contiguous range of sorted entries drawn with one call; its DrawBlocks start at entry @c first
+    struct Batch {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    std::vector<DrawItem> items;
+    std::vector<SortEntry> sorted;
+    std::vector<SortEntry> scratch;
+
+    std::vector<Batch> batches;
+    std::vector<DrawBlock> drawData;
+
+    std::unique_ptr<UniformBuffer> drawBuffer;
+
+    bool instancingEnabled = true;
+    uint32_t minInstanceCount = 2;
+
+    RenderQueueStats stats;
+
+    bool CanInstance(const DrawItem &a, const DrawItem &b) const;
+
+    void BuildBatches();
+
+    void UploadDraws();
+
+public:
+    static constexpr int DEPTH_BITS = 20;
+    static constexpr int MESH_BITS = 16;
+    static constexpr int MATERIAL_BITS = 16;
+    static constexpr int SHADER_BITS = 8;
+
+    /**
+     * @param depth01 View depth normalized to [0, 1]; opaque items sort front-to-back,
+     * transparent ones back-to-front
+     */
+    static uint64_t MakeKey(RenderPassType pass, uint32_t shader, uint32_t material,
+                            uint32_t mesh, float depth01);
+
+    RenderQueue() = default;
+
+    RenderQueue(const RenderQueue &) = delete;
+
+    RenderQueue &operator=(const RenderQueue &) = delete;
+
+    void Clear();
+
+    void Push(const DrawItem &item);
+
+    void Sort();
+
+    void Submit(GLContext &context, MaterialBuffer &materialBuffer);
+
+    void SetInstancingEnabled(bool enable);
+
+    /// Smallest run of identical draws that is worth an instanced call
+    void SetMinInstanceCount(uint32_t count);
+
+    size_t Size() const;
+
+    const std::vector<DrawItem> &GetItems() const;
+
+    const RenderQueueStats &GetStats() const;
+};
\ No newline at end of file
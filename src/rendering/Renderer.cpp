@@ -1,10 +1,12 @@
 #include "Renderer.h"
+#include <algorithm>
 #include <string>
 #include <vector>
 #include "rendering/pipeline/PipelineBuilder.h"
 #include "rendering/pipeline/ForwardPipeline.h"
 #include "core/logging/Logger.h"
 #include "core/CommandManager.h"
+#include "core/Profiler.h"
 
 Renderer::Renderer(ShaderManager *sm, ECSWorld *w, TextureManager *tm)
     : shaderManager(sm)
@@ -23,6 +25,8 @@ Renderer::Renderer(ShaderManager *sm, ECSWorld *w, TextureManager *tm)
 }
 
 Renderer::~Renderer() {
+    CommandManager::Unregister<RenderGeometryCommand>();
+    CommandManager::Unregister<RenderUICommand>();
     Shutdown();
 }
 
@@ -31,6 +35,10 @@ bool Renderer::Initialize(GLuint skyboxVAO, GLuint cubemapTexture) {
 
     ApplySettings();
 
+    frameBuffer = std::make_unique<UniformBuffer>(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW);
+    frameBuffer->Allocate(sizeof(FrameBlock));
+    materialBuffer = std::make_unique<MaterialBuffer>();
+
     PipelineBuilder builder;
     pipeline = builder
             .SetContext(context.get())
@@ -45,6 +53,8 @@ bool Renderer::Initialize(GLuint skyboxVAO, GLuint cubemapTexture) {
         return false;
     }
 
+    ApplyShadowSettings();
+
     lastFPSUpdate = Clock::now();
     initialized = true;
     Logger::Log(LogLevel::INFO, "Renderer initialized successfully");
@@ -56,8 +66,15 @@ void Renderer::BeginFrame() {
 
     frameStart = Clock::now();
     context->ResetStats();
+    shaderManager->ResetUniformCacheStats();
+    materialBuffer->ResetStats();
     stats.Reset();
 
+    if (renderTarget)
+        renderTarget->Bind();
+    else
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
     context->ClearColor(
         config.clearColor.x, config.clearColor.y,
         config.clearColor.z, config.clearColor.w);
@@ -67,12 +84,19 @@ void Renderer::BeginFrame() {
 void Renderer::Render(ECSWorld &ecs, entt::entity cameraEntity,
                       int width, int height) {
     if (!initialized || !pipeline) return;
+    viewportWidth = width;
+    viewportHeight = height;
+    pipeline->SetTargetFramebuffer(renderTarget ? renderTarget->GetID() : 0);
     pipeline->Execute(ecs, cameraEntity, width, height);
 }
 
 void Renderer::EndFrame() {
     if (!initialized) return;
 
+    // Benchmark frames wait for the GPU, so frame time includes the shading cost
+    if (lightBenchmark.remaining > 0)
+        glFinish();
+
     auto now = Clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - frameStart);
     stats.frameTime = duration.count() / 1000.0f;
@@ -93,6 +117,41 @@ void Renderer::EndFrame() {
     stats.vertexCount = cs.vertexCount;
     stats.triangleCount = cs.triangleCount;
 
+    const auto &qs = renderSystem->GetQueue().GetStats();
+    stats.queuedDraws = qs.items;
+    stats.materialChanges = qs.materialChanges;
+    stats.meshChanges = qs.meshChanges;
+    stats.submittedObjects = qs.items;
+    stats.culledObjects = renderSystem->GetCulledCount();
+    stats.instancedBatches = qs.instancedBatches;
+    stats.instancedItems = qs.instancedItems;
+    stats.singletonDraws = qs.singletonDraws;
+
+    if (auto *fp = dynamic_cast<ForwardPipeline *>(pipeline.get())) {
+        if (auto *sp = fp->GetShadowPass()) {
+            stats.shadowCasters = sp->GetCastersDrawn();
+            stats.shadowCastersCulled = sp->GetCastersCulled();
+            stats.shadowLayersUpdated = sp->GetLayersUpdated();
+            stats.shadowLayersSkipped = sp->GetLayersSkipped();
+            stats.shadowStaticRefreshes = sp->GetStaticRefreshes();
+            stats.shadowRefreshesDeferred = sp->GetRefreshesDeferred();
+        }
+    }
+
+    const auto &us = shaderManager->GetUniformCacheStats();
+    stats.uniformCacheHits = static_cast<int>(us.hits);
+    stats.uniformCacheMisses = static_cast<int>(us.misses);
+    stats.uniformHandleUploads = static_cast<int>(us.handleUploads);
+    stats.materialUploads = static_cast<int>(materialBuffer->GetUploadCount());
+
+    stats.lights = static_cast<int>(frameLights.size());
+    stats.lightIndices = static_cast<int>(lightClusters.GetIndexCount());
+    stats.maxClusterLights = static_cast<int>(lightClusters.GetMaxClusterLights());
+    stats.lightCullMs = static_cast<float>(lightClusters.GetBuildMs());
+
+    if (lightBenchmark.remaining > 0)
+        StepLightBenchmark();
+
     if (frameCount % 60 == 0) LogStats();
 }
 
@@ -102,6 +161,8 @@ void Renderer::Shutdown() {
     renderSystem.reset();
     lightSystem.reset();
     m_icon.reset();
+    materialBuffer.reset();
+    frameBuffer.reset();
     context.reset();
     initialized = false;
     Logger::Log(LogLevel::INFO, "Renderer shutdown");
@@ -130,6 +191,26 @@ void Renderer::SetEnableShadows(bool enable) {
                 std::string("Shadows ") + (enable ? "enabled" : "disabled"));
 }
 
+void Renderer::ApplyShadowSettings() {
+    if (!pipeline) return;
+
+    if (auto *fp = dynamic_cast<ForwardPipeline *>(pipeline.get())) {
+        if (auto *sp = fp->GetShadowPass()) {
+            sp->SetShadowMapSize(config.shadowMapSize);
+            sp->SetCascades(config.shadowCascades, config.cascadeSplitLambda, config.shadowDistance);
+            sp->SetRefreshBudget(config.shadowRefreshBudget);
+        }
+    }
+}
+
+void Renderer::SetRenderTarget(Framebuffer *target) {
+    renderTarget = target;
+}
+
+Framebuffer *Renderer::GetRenderTarget() const {
+    return renderTarget;
+}
+
 GLContext *Renderer::GetContext() {
     return context.get();
 }
@@ -158,6 +239,10 @@ IconRenderSystem *Renderer::GetIcon() {
     return m_icon.get();
 }
 
+MaterialBuffer *Renderer::GetMaterialBuffer() {
+    return materialBuffer.get();
+}
+
 bool Renderer::IsInitialized() const {
     return initialized;
 }
@@ -174,93 +259,161 @@ void Renderer::LogStats() const {
                 "FPS: " + std::to_string(static_cast<int>(stats.fps)) +
                 " | Frame: " + std::to_string(stats.frameTime) + "ms" +
                 " | Draws: " + std::to_string(stats.drawCalls) +
-                " | Tris: " + std::to_string(stats.triangleCount));
+                " | Tris: " + std::to_string(stats.triangleCount) +
+                " | State: " + std::to_string(stats.stateChanges) +
+                " (" + std::to_string(stats.materialChanges) + " mat, " +
+                std::to_string(stats.meshChanges) + " mesh for " +
+                std::to_string(stats.queuedDraws) + " items)" +
+                " | Culled: " + std::to_string(stats.culledObjects) + "/" +
+                std::to_string(stats.culledObjects + stats.submittedObjects) + " objects, " +
+                std::to_string(stats.shadowCastersCulled) + "/" +
+                std::to_string(stats.shadowCastersCulled + stats.shadowCasters) + " casters, " +
+                std::to_string(stats.shadowLayersUpdated) + " layers drawn, " +
+                std::to_string(stats.shadowLayersSkipped) + " skipped" +
+                " | Instanced: " + std::to_string(stats.instancedBatches) + " batches (" +
+                std::to_string(stats.instancedItems) + " items), " +
+                std::to_string(stats.singletonDraws) + " single" +
+                " | Uniforms: " + std::to_string(stats.uniformHandleUploads) + " by handle, " +
+                std::to_string(stats.uniformCacheHits) + " by name (" +
+                std::to_string(stats.uniformCacheMisses) + " misses), " +
+                std::to_string(stats.materialUploads) + " material blocks" +
+                " | Lights: " + std::to_string(stats.lights) + " (" +
+                std::to_string(stats.lightIndices) + " cluster entries, max " +
+                std::to_string(stats.maxClusterLights) + ", " + std::to_string(stats.lightCullMs) + "ms)");
 }
 
 void Renderer::RegisterRenderCommands() {
-    if (CommandManager::HasCommand("Renderer_RenderGeometry")) {
-        Logger::Log(LogLevel::WARNING,
-                    "Renderer: Renderer_RenderGeometry already registered — skipping (hot-reload path?)");
-    } else
-        CommandManager::RegisterCommand("Renderer_RenderGeometry",
+    CommandManager::Register<RenderGeometryCommand, &Renderer::RenderGeometry>(*this);
+    CommandManager::Register<RenderUICommand, &Renderer::RenderUI>(*this);
+
+    if (!CommandManager::HasCommand("Renderer_BenchmarkLights"))
+        CommandManager::RegisterCommand("Renderer_BenchmarkLights",
             [this](const CommandArgs &args) {
-                if (args.size() < 3) {
-                    Logger::Log(LogLevel::ERROR,
-                                "Renderer_RenderGeometry: needs ≥3 args");
-                    return;
-                }
-
-                const auto &view = std::get<glm::mat4>(args[0]);
-                const auto &projection = std::get<glm::mat4>(args[1]);
-                const auto &shaderName = std::get<std::string>(args[2]);
-
-                shaderManager->Bind(shaderName);
-                shaderManager->SetMat4(shaderName, "projection", projection);
-                shaderManager->SetMat4(shaderName, "view", view);
-
-                bool shadowsEnabled = false;
-                if (args.size() >= 5) {
-                    const auto &lightSpaceMatrices = std::get<std::vector<glm::mat4> >(
-                        args[3]);
-                    GLuint shadowTexID = std::get<GLuint>(args[4]);
-
-                    for (int i = 0; i < lightSpaceMatrices.size(); i++)
-                        shaderManager->SetMat4(shaderName,
-                                               "lightSpaceMatrices[" + std::to_string(i)
-                                               + "]", lightSpaceMatrices[i]);
-
-                    if (shadowTexID != 0) {
-                        shadowsEnabled = true;
-                        shaderManager->SetBool(shaderName, "shadowsEnabled", true);
-
-                        shaderManager->SetInt(shaderName, "shadowMapArray", SHADOW_MAP_SLOT);
-                        glActiveTexture(GL_TEXTURE0 + SHADOW_MAP_SLOT);
-                        glBindTexture(GL_TEXTURE_2D_ARRAY, shadowTexID);
-
-                        if (args.size() >= 7) {
-                            GLuint cubeShadowTexID = std::get<GLuint>(args[6]);
-                            shaderManager->SetInt(shaderName, "shadowCubeArray", CUBE_SHADOW_MAP_SLOTS);
-                            shaderManager->SetFloat(shaderName, "pointLightFarPlane", 100.0f);
-                            glActiveTexture(GL_TEXTURE0 + CUBE_SHADOW_MAP_SLOTS);
-                            glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, cubeShadowTexID);
-                        }
-                    }
-                }
-
-                if (!shadowsEnabled)
-                    shaderManager->SetBool(shaderName, "shadowsEnabled", false);
-
-                const std::vector<int> *shadowMapIndices = nullptr;
-                if (args.size() >= 6) {
-                    shadowMapIndices = &std::get<std::vector<int> >(args[5]);
-                }
-
-                const std::vector<int> *cubeShadowMapIndices = nullptr;
-                if (args.size() >= 8) {
-                    cubeShadowMapIndices = &std::get<std::vector<int> >(args[7]);
-                }
-
-                lightSystem->Update(*world, *shaderManager, shaderName,
-                                    shadowMapIndices, cubeShadowMapIndices);
-                renderSystem->Update(*world, *shaderManager, shaderName);
-
-                shaderManager->Unbind();
+                int frames = 120;
+                if (!args.empty() && std::holds_alternative<int>(args[0]))
+                    frames = std::max(std::get<int>(args[0]), 1);
+
+                lightBenchmark = {};
+                lightBenchmark.frames = frames;
+                lightBenchmark.remaining = frames;
+                lightBenchmark.warmup = LightBenchmark::WARMUP_FRAMES;
+                lightClusters.SetCullingEnabled(true);
+
+                // The pass timers only run while the profiler does
+                if (!Profiler::Get().IsEnabled())
+                    Profiler::Get().SetEnabled(true);
+
+                Logger::Log(LogLevel::INFO, "Light benchmark: " + std::to_string(frames) +
+                                            " frames clustered, then " + std::to_string(frames) + " unculled");
             });
 
-    if (!CommandManager::HasCommand("Renderer_RenderUI"))
-        CommandManager::RegisterCommand("Renderer_RenderUI",
+    if (!CommandManager::HasCommand("Renderer_SetShadowCascades"))
+        CommandManager::RegisterCommand("Renderer_SetShadowCascades",
             [this](const CommandArgs &args) {
-                if (args.size() < 3) return;
-
-                const auto &view = std::get<glm::mat4>(args[0]);
-                const auto &projection = std::get<glm::mat4>(args[1]);
-                const auto &shaderName = std::get<std::string>(args[2]);
-
-                shaderManager->Bind(shaderName);
-                shaderManager->SetMat4(shaderName, "projection", projection);
-                shaderManager->SetMat4(shaderName, "view", view);
-                shaderManager->Unbind();
+                if (args.size() >= 1 && std::holds_alternative<int>(args[0]))
+                    config.shadowCascades = std::clamp(std::get<int>(args[0]), 1, MAX_SHADOW_CASCADES);
+                if (args.size() >= 2 && std::holds_alternative<float>(args[1]))
+                    config.cascadeSplitLambda = std::get<float>(args[1]);
+                if (args.size() >= 3 && std::holds_alternative<float>(args[2]))
+                    config.shadowDistance = std::get<float>(args[2]);
+
+                ApplyShadowSettings();
+                Logger::Log(LogLevel::INFO, "Shadow cascades: " + std::to_string(config.shadowCascades) +
+                                            ", lambda " + std::to_string(config.cascadeSplitLambda) +
+                                            ", distance " + std::to_string(config.shadowDistance));
             });
 
     Logger::Log(LogLevel::INFO, "Render commands registered");
+}
+
+void Renderer::RenderGeometry(const RenderGeometryCommand::Args &args) {
+    frameBlock.view = args.view;
+    frameBlock.projection = args.projection;
+    frameBlock.viewPos = glm::inverse(args.view)[3];
+    frameBlock.shadowsEnabled = 0;
+    frameBlock.cascadeCount = args.cascadeCount;
+    frameBlock.cascadeSplits = args.cascadeSplits;
+
+    const size_t matrixCount = std::min<size_t>(args.lightSpaceMatrices.size(), MAX_FRAME_SHADOW_MATRICES);
+    std::copy_n(args.lightSpaceMatrices.begin(), matrixCount, frameBlock.lightSpaceMatrices);
+
+    if (args.shadowMapArray != 0) {
+        frameBlock.shadowsEnabled = 1;
+
+        glActiveTexture(GL_TEXTURE0 + SHADOW_MAP_SLOT);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, args.shadowMapArray);
+
+        glActiveTexture(GL_TEXTURE0 + CUBE_SHADOW_MAP_SLOTS);
+        glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, args.cubeShadowMapArray);
+    }
+
+    {
+        PROFILE_SCOPE("LightCulling");
+        const uint32_t directional = lightSystem->Update(*world, frameLights, args.shadowMapIndices,
+                                                         args.cubeShadowMapIndices);
+        lightClusters.Build(frameLights, directional, args.view, args.projection, viewportWidth, viewportHeight);
+        lightClusters.Upload();
+        lightClusters.WriteFrameParams(frameBlock);
+        UploadFrameBlock();
+    }
+
+    PROFILE_SCOPE("RenderQueue");
+    renderSystem->SetInstancingEnabled(config.enableInstancing);
+    renderSystem->Update(*world, *shaderManager, *context, *materialBuffer, args.shaderName, args.view,
+                         args.projection);
+
+    shaderManager->Unbind();
+}
+
+void Renderer::RenderUI(const RenderUICommand::Args &args) {
+    shaderManager->Bind(args.shaderName);
+    shaderManager->SetMat4(args.shaderName, "projection", args.projection);
+    shaderManager->SetMat4(args.shaderName, "view", args.view);
+    shaderManager->Unbind();
+}
+
+void Renderer::UploadFrameBlock() {
+    frameBuffer->SetData(&frameBlock, sizeof(FrameBlock));
+    frameBuffer->BindBase(FRAME_BLOCK_BINDING);
+}
+
+void Renderer::StepLightBenchmark() {
+    LightBenchmark &bench = lightBenchmark;
+
+    if (bench.warmup > 0) {
+        bench.warmup--;
+        return;
+    }
+
+    bench.frameMs[bench.phase] += stats.frameTime;
+    bench.cullMs[bench.phase] += lightClusters.GetBuildMs();
+    for (const GpuProfileEvent &event: Profiler::Get().GetLastFrame().gpu)
+        bench.gpuMs[bench.phase] += event.durationNs / 1.0e6;
+
+    if (--bench.remaining > 0)
+        return;
+
+    if (bench.phase == 0) {
+        bench.phase = 1;
+        bench.remaining = bench.frames;
+        bench.warmup = LightBenchmark::WARMUP_FRAMES;
+        lightClusters.SetCullingEnabled(false);
+        return;
+    }
+
+    lightClusters.SetCullingEnabled(true);
+
+    // A paused profiler keeps handing back the same frame
+    const bool gpuValid = !Profiler::Get().IsPaused();
+    auto gpu = [&](int phase) {
+        return gpuValid ? std::to_string(bench.gpuMs[phase] / bench.frames) + " ms" : std::string("n/a");
+    };
+
+    const double frames = bench.frames;
+    Logger::Log(LogLevel::INFO,
+                "Light benchmark (" + std::to_string(frameLights.size()) + " lights, " +
+                std::to_string(LightClusters::CLUSTER_COUNT) + " clusters): clustered " +
+                std::to_string(bench.frameMs[0] / frames) + " ms/frame (GPU " + gpu(0) + ", culling " +
+                std::to_string(bench.cullMs[0] / frames) + " ms), unculled " +
+                std::to_string(bench.frameMs[1] / frames) + " ms/frame (GPU " + gpu(1) + ")");
 }
\ No newline at end of file
@@ -10,8 +10,13 @@
 #include "rendering/IRenderer.h"
 #include "rendering/core/GLContext.h"
 #include "rendering/core/Framebuffer.h"
+#include "rendering/core/UniformBuffer.h"
+#include "rendering/MaterialBuffer.h"
+#include "rendering/LightClusters.h"
+#include "rendering/ShaderBlocks.h"
 #include "rendering/pipeline/RenderPipeline.h"
 #include "rendering/RenderingTypes.h"
+#include "rendering/RenderCommands.h"
 #include "resource/shader/ShaderManager.h"
 #include "resource/texture/TextureManager.h"
 #include "ECS/World.h"
@@ -28,6 +33,37 @@ class Renderer : public IRenderer {
     std::unique_ptr<LightSystem> lightSystem;
     std::unique_ptr<IconRenderSystem> m_icon;
 
+    /// FrameBlock for the geometry shader, refilled and uploaded once per geometry pass
+    FrameBlock frameBlock;
+    std::unique_ptr<UniformBuffer> frameBuffer;
+    std::unique_ptr<MaterialBuffer> materialBuffer;
+
+    std::vector<LightBlock> frameLights;
+    LightClusters lightClusters;
+    int viewportWidth = 1;
+    int viewportHeight = 1;
+
+    /// Offscreen target for headless runs; null draws to the window
+    Framebuffer *renderTarget = nullptr;
+
+    /**
+     * Renderer_BenchmarkLights: a run with cluster culling, then one with every light in every cluster.
+     * Reproducible without a window:
+     * `WildFoxEngine --headless --frames 300 --run "onCreateLightStressScene 256" --run "Renderer_BenchmarkLights 120"`
+     */
+    struct LightBenchmark {
+        /// GPU timings reach the profiler a couple of frames late; these frames are not counted
+        static constexpr int WARMUP_FRAMES = 4;
+
+        int frames = 0;
+        int remaining = 0;
+        int warmup = 0;
+        int phase = 0;
+        double frameMs[2] = {};
+        double cullMs[2] = {};
+        double gpuMs[2] = {};
+    } lightBenchmark;
+
     ShaderManager *shaderManager;
     ECSWorld *world;
 
@@ -65,6 +101,14 @@ public:
 
     void SetEnableShadows(bool enable) override;
 
+    /// Pushes the shadow map size and cascade settings from config to the shadow pass
+    void ApplyShadowSettings();
+
+    /// Frames go to target from the next BeginFrame on; nullptr switches back to the window. Not owned.
+    void SetRenderTarget(Framebuffer *target);
+
+    Framebuffer *GetRenderTarget() const;
+
     GLContext *GetContext() override;
 
     RenderPipeline *GetPipeline() override;
@@ -79,6 +123,8 @@ public:
 
     IconRenderSystem *GetIcon();
 
+    MaterialBuffer *GetMaterialBuffer();
+
     bool IsInitialized() const override;
 
 private:
@@ -87,4 +133,13 @@ private:
     void LogStats() const;
 
     void RegisterRenderCommands();
+
+    /// RenderGeometryCommand target: fills the frame block, culls lights into clusters and draws the render queue
+    void RenderGeometry(const RenderGeometryCommand::Args &args);
+
+    void RenderUI(const RenderUICommand::Args &args);
+
+    void UploadFrameBlock();
+
+    void StepLightBenchmark();
 };
\ No newline at end of file
@@ -81,6 +81,11 @@ bool RenderingModule::IsRequired() const {
     return false;
 }
 
+ModuleAccess RenderingModule::GetAccess() const {
+    // Frames are drawn from Engine::OnRender, not from Update()
+    return {};
+}
+
 Renderer *RenderingModule::GetRenderer() {
     return renderer.get();
 }
@@ -74,6 +74,8 @@ public:
 
     bool IsRequired() const override;
 
+    ModuleAccess GetAccess() const override;
+
     /// @}
 
     /// @name Getters
@@ -10,8 +10,19 @@ struct RendererConfig {
     bool enableWireframe = false;
     glm::vec4 clearColor = glm::vec4(0.1f, 0.1f, 0.1f, 1.0f);
 
+    /// Resolution of each shadow array layer, shared by directional cascades and spot lights
     int shadowMapSize = 2048;
     bool enableShadows = false;
+
+    // Directional cascades: count (1-4), uniform/log split blend, and the view depth they cover
+    int shadowCascades = 4;
+    float cascadeSplitLambda = 0.75f;
+    float shadowDistance = 100.0f;
+
+    /// Lights whose cached static shadow depth may be re-rendered per frame; 0 means no limit
+    int shadowRefreshBudget = 2;
+
+    bool enableInstancing = true;
 };
 
 struct RenderStats {
@@ -22,10 +33,68 @@ struct RenderStats {
     float frameTime = 0.0f;
     float fps = 0.0f;
 
+    // Geometry render queue: items submitted and how often material/mesh state actually switched
+    int queuedDraws = 0;
+    int materialChanges = 0;
+    int meshChanges = 0;
+
+    // Frustum culling: meshes kept/rejected for the camera, and shadow caster draws kept/rejected
+    int submittedObjects = 0;
+    int culledObjects = 0;
+    int shadowCasters = 0;
+    int shadowCastersCulled = 0;
+
+    // Shadow cache: layers (cube faces included) redrawn / skipped, static re-renders done / deferred by the budget
+    int shadowLayersUpdated = 0;
+    int shadowLayersSkipped = 0;
+    int shadowStaticRefreshes = 0;
+    int shadowRefreshesDeferred = 0;
+
+    // Instanced calls issued, items they covered, and items still drawn one call each
+    int instancedBatches = 0;
+    int instancedItems = 0;
+    int singletonDraws = 0;
+
+    // Uniform lookups by name that hit/missed the location cache, and uploads through UniformHandle
+    int uniformCacheHits = 0;
+    int uniformCacheMisses = 0;
+    int uniformHandleUploads = 0;
+
+    // MaterialBuffer slots re-uploaded because their material changed
+    int materialUploads = 0;
+
+    // Clustered lighting: lights in the frame, cluster list entries, fullest cluster, CPU binning time
+    int lights = 0;
+    int lightIndices = 0;
+    int maxClusterLights = 0;
+    float lightCullMs = 0.0f;
+
     void Reset() {
         drawCalls = 0;
         stateChanges = 0;
         vertexCount = 0;
         triangleCount = 0;
+        queuedDraws = 0;
+        materialChanges = 0;
+        meshChanges = 0;
+        submittedObjects = 0;
+        culledObjects = 0;
+        shadowCasters = 0;
+        shadowCastersCulled = 0;
+        shadowLayersUpdated = 0;
+        shadowLayersSkipped = 0;
+        shadowStaticRefreshes = 0;
+        shadowRefreshesDeferred = 0;
+        instancedBatches = 0;
+        instancedItems = 0;
+        singletonDraws = 0;
+        uniformCacheHits = 0;
+        uniformCacheMisses = 0;
+        uniformHandleUploads = 0;
+        materialUploads = 0;
+        lights = 0;
+        lightIndices = 0;
+        maxClusterLights = 0;
+        lightCullMs = 0.0f;
     }
 };
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+/// @file ShaderBlocks.h
+/// @brief CPU mirrors of the interface blocks declared in basic.vsh / basic.fsh
+///
+/// Layouts follow std140 (uniform blocks) and std430 (storage blocks); keep the
+/// field order in sync with the GLSL declarations. LightBlock is used as a
+/// std430 array element, where its 96-byte stride is the same as under std140.
+
+/// Uniform block binding points
+constexpr GLuint FRAME_BLOCK_BINDING = 0;
+constexpr GLuint MATERIAL_BLOCK_BINDING = 1;
+
+/// Shader storage bindings
+constexpr GLuint DRAW_BLOCK_BINDING = 0;
+constexpr GLuint LIGHT_BLOCK_BINDING = 1;
+constexpr GLuint CLUSTER_BLOCK_BINDING = 2;
+constexpr GLuint LIGHT_INDEX_BLOCK_BINDING = 3;
+
+constexpr int MAX_FRAME_SHADOW_MATRICES = 8;
+/// Cascade split depths travel as one vec4
+constexpr int MAX_SHADOW_CASCADES = 4;
+
+/// Material sampler units, fixed by layout(binding) in basic.fsh
+constexpr GLuint DIFFUSE_TEXTURE_UNIT = 0;
+constexpr GLuint SPECULAR_TEXTURE_UNIT = 1;
+constexpr GLuint NORMAL_TEXTURE_UNIT = 2;
+constexpr GLuint HEIGHT_TEXTURE_UNIT = 3;
+
+/// Each vec3 shares its 16-byte slot with the float after it
+struct LightBlock {
+    glm::vec3 position{0.0f};
+    float constant = 1.0f;
+
+    glm::vec3 direction{0.0f, -1.0f, 0.0f};
+    float linear = 0.0f;
+
+    glm::vec3 ambient{0.0f};
+    float quadratic = 0.0f;
+
+    glm::vec3 diffuse{0.0f};
+    float innerCutoff = 0.0f;
+
+    glm::vec3 specular{0.0f};
+    float outerCutoff = 0.0f;
+
+    int type = 0;
+    int shadowIndex = -1;
+    float farPlane = 100.0f;
+    /// Distance at which a point or spot light has faded out; bounds its cluster culling sphere
+    float range = 50.0f;
+};
+
+/// Camera, shadow matrices and light cluster grid; uploaded once per geometry pass
+struct FrameBlock {
+    glm::mat4 view{1.0f};
+    glm::mat4 projection{1.0f};
+    glm::mat4 lightSpaceMatrices[MAX_FRAME_SHADOW_MATRICES]{};
+    glm::vec4 viewPos{0.0f};
+
+    /// Tiles x, tiles y, depth slices, number of leading directional lights
+    glm::uvec4 clusterGrid{0u};
+    /// Slice = log(depth) * x - y; tile size in pixels in z, w
+    glm::vec4 clusterDepth{0.0f};
+    /// View depth at which each directional shadow cascade ends
+    glm::vec4 cascadeSplits{0.0f};
+
+    int numLights = 0;
+    int shadowsEnabled = 0;
+    int cascadeCount = 0;
+    int padding = 0;
+};
+
+/// One slot per material in MaterialBuffer
+struct MaterialBlock {
+    glm::vec4 color{1.0f};
+    int useColor = 0;
+    int padding[3]{};
+};
+
+/// Per-draw entry, indexed by gl_BaseInstance + gl_InstanceID
+struct DrawBlock {
+    glm::mat4 model{1.0f};
+    glm::vec4 tiling{1.0f, 1.0f, 0.0f, 0.0f};
+};
+
+static_assert(sizeof(LightBlock) == 96);
+static_assert(sizeof(FrameBlock) == 720);
+static_assert(sizeof(MaterialBlock) == 32);
+static_assert(sizeof(DrawBlock) == 80);
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "Framebuffer.h"
 
+#include <fstream>
 #include <string>
+#include <vector>
 
 #include "core/logging/Logger.h"
 
@@ -117,6 +119,33 @@ unsigned int Framebuffer::GetTextureID() const {
     return textureID;
 }
 
+unsigned int Framebuffer::GetID() const {
+    return FBO;
+}
+
+bool Framebuffer::SaveToPPM(const std::string &path) {
+    const size_t rowBytes = static_cast<size_t>(width) * 3;
+    std::vector<unsigned char> pixels(rowBytes * height);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        Logger::Log(LogLevel::ERROR, "Failed to open " + path + " for writing");
+        return false;
+    }
+
+    out << "P6\n" << width << " " << height << "\n255\n";
+    // GL rows start at the bottom
+    for (int y = height - 1; y >= 0; y--)
+        out.write(reinterpret_cast<const char *>(pixels.data() + rowBytes * y), static_cast<std::streamsize>(rowBytes));
+
+    return static_cast<bool>(out);
+}
+
 int Framebuffer::GetWidth() const {
     return width;
 }
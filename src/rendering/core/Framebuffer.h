@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 #include <glad/glad.h>
 
 class Framebuffer {
@@ -23,6 +25,11 @@ public:
 
     unsigned int GetTextureID() const;
 
+    unsigned int GetID() const;
+
+    /// Reads the color attachment back and writes it as a binary PPM, top row first
+    bool SaveToPPM(const std::string &path);
+
     int GetWidth() const;
 
     int GetHeight() const;
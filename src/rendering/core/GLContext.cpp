@@ -38,9 +38,16 @@ void GLContext::BindFBO(GLuint fbo) {
 
 void GLContext::BindTexture2D(GLuint texture, GLuint slot) {
     glActiveTexture(GL_TEXTURE0 + slot);
-    if (state.boundTexture2D != texture) {
+
+    if (slot >= MAX_TEXTURE_SLOTS) {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        stats.stateChanges++;
+        return;
+    }
+
+    if (state.boundTextures2D[slot] != texture) {
         glBindTexture(GL_TEXTURE_2D, texture);
-        state.boundTexture2D = texture;
+        state.boundTextures2D[slot] = texture;
         stats.stateChanges++;
     }
 }
@@ -128,6 +135,24 @@ void GLContext::DrawElements(GLenum mode, GLsizei count, GLenum type, const void
         stats.triangleCount += count / 3;
 }
 
+void GLContext::DrawArraysInstanced(GLenum mode, GLint first, GLsizei count,
+                                    GLsizei instanceCount, GLuint baseInstance) {
+    glDrawArraysInstancedBaseInstance(mode, first, count, instanceCount, baseInstance);
+    stats.drawCalls++;
+    stats.vertexCount += count * instanceCount;
+    if (mode == GL_TRIANGLES)
+        stats.triangleCount += count / 3 * instanceCount;
+}
+
+void GLContext::DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices,
+                                      GLsizei instanceCount, GLuint baseInstance) {
+    glDrawElementsInstancedBaseInstance(mode, count, type, indices, instanceCount, baseInstance);
+    stats.drawCalls++;
+    stats.vertexCount += count * instanceCount;
+    if (mode == GL_TRIANGLES)
+        stats.triangleCount += count / 3 * instanceCount;
+}
+
 void GLContext::Clear(GLbitfield mask) {
     glClear(mask);
 }
@@ -144,6 +169,17 @@ void GLContext::ResetStats() {
     stats.Reset();
 }
 
+void GLContext::InvalidateBindings() {
+    state.boundVAO = UNKNOWN_BINDING;
+    state.boundVBO = UNKNOWN_BINDING;
+    state.boundEBO = UNKNOWN_BINDING;
+    state.boundFBO = UNKNOWN_BINDING;
+    state.boundShader = UNKNOWN_BINDING;
+
+    for (auto &texture: state.boundTextures2D)
+        texture = UNKNOWN_BINDING;
+}
+
 const GLContext::State &GLContext::GetState() const {
     return state;
 }
\ No newline at end of file
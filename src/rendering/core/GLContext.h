@@ -3,13 +3,19 @@
 #include <glad/glad.h>
 
 class GLContext {
+public:
+    static constexpr int MAX_TEXTURE_SLOTS = 16;
+
 private:
+    /// Marks a cached binding as unknown so the next Bind* always reaches GL
+    static constexpr GLuint UNKNOWN_BINDING = ~0u;
+
     struct State {
         GLuint boundVAO = 0;
         GLuint boundVBO = 0;
         GLuint boundEBO = 0;
         GLuint boundFBO = 0;
-        GLuint boundTexture2D = 0;
+        GLuint boundTextures2D[MAX_TEXTURE_SLOTS] = {};
         GLuint boundShader = 0;
 
         bool depthTest = true;
@@ -69,6 +75,12 @@ public:
 
     void DrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices);
 
+    void DrawArraysInstanced(GLenum mode, GLint first, GLsizei count,
+                             GLsizei instanceCount, GLuint baseInstance = 0);
+
+    void DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices,
+                               GLsizei instanceCount, GLuint baseInstance = 0);
+
     void Clear(GLbitfield mask);
 
     void ClearColor(float r, float g, float b, float a);
@@ -77,5 +89,12 @@ public:
 
     void ResetStats();
 
+    /**
+     * @brief Forget cached object bindings
+     * Call before a batch of tracked draws when other code may have
+     * touched GL bindings directly.
+     */
+    void InvalidateBindings();
+
     const State &GetState() const;
 };
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "GpuTimer.h"
+#include "core/Profiler.h"
+
+GpuTimer::~GpuTimer() {
+    for (Section &section: sections)
+        for (Slot &slot: section.slots)
+            if (slot.query != 0)
+                glDeleteQueries(1, &slot.query);
+}
+
+int GpuTimer::Register(const char *name) {
+    Section section{name, {}, 0};
+    for (Slot &slot: section.slots)
+        glGenQueries(1, &slot.query);
+
+    sections.push_back(section);
+    return static_cast<int>(sections.size()) - 1;
+}
+
+const char *GpuTimer::GetName(int id) const {
+    return sections[id].name;
+}
+
+void GpuTimer::Begin(int id) {
+    if (active >= 0 || !Profiler::Get().IsEnabled())
+        return;
+
+    Section &section = sections[id];
+    Slot &slot = section.slots[section.next];
+
+    // Every query of this section is still in flight; skip a sample rather than wait for the GPU
+    if (slot.pending)
+        return;
+
+    slot.cpuStartNs = Profiler::Now();
+    glBeginQuery(GL_TIME_ELAPSED, slot.query);
+    active = id;
+}
+
+void GpuTimer::End() {
+    if (active < 0)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+
+    Section &section = sections[active];
+    section.slots[section.next].pending = true;
+    section.next = (section.next + 1) % FRAMES_IN_FLIGHT;
+    active = -1;
+}
+
+void GpuTimer::Collect() {
+    for (Section &section: sections) {
+        for (Slot &slot: section.slots) {
+            if (!slot.pending)
+                continue;
+
+            GLint available = 0;
+            glGetQueryObjectiv(slot.query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                continue;
+
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(slot.query, GL_QUERY_RESULT, &elapsed);
+            slot.pending = false;
+
+            Profiler::Get().RecordGpu(section.name, slot.cpuStartNs, elapsed);
+        }
+    }
+}
\ No newline at end of file
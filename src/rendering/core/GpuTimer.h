@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+
+/**
+ * @class GpuTimer
+ * @brief GL_TIME_ELAPSED queries around named GPU sections, reported to the Profiler
+ *
+ * Each section cycles through a few queries and results are only read once
+ * available, so timing never stalls the pipeline; they arrive a few frames
+ * late. Sections must not nest, as only one GL_TIME_ELAPSED query can be active.
+ */
+class GpuTimer {
+    static constexpr size_t FRAMES_IN_FLIGHT = 4;
+
+    struct Slot {
+        GLuint query = 0;
+        uint64_t cpuStartNs = 0;
+        bool pending = false;
+    };
+
+    struct Section {
+        const char *name;
+        std::array<Slot, FRAMES_IN_FLIGHT> slots;
+        size_t next = 0;
+    };
+
+    std::vector<Section> sections;
+    int active = -1;
+
+public:
+    GpuTimer() = default;
+
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer &) = delete;
+
+    GpuTimer &operator=(const GpuTimer &) = delete;
+
+    /// @param name must outlive the timer (a literal or Profiler::Intern)
+    /// @return id for Begin()
+    int Register(const char *name);
+
+    const char *GetName(int id) const;
+
+    void Begin(int id);
+
+    void End();
+
+    /// Hands every finished query to the Profiler
+    void Collect();
+};
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "UniformBuffer.h"
+
+UniformBuffer::UniformBuffer(GLenum bufferTarget, GLenum bufferUsage)
+    : target(bufferTarget), usage(bufferUsage) {
+    glGenBuffers(1, &buffer);
+}
+
+UniformBuffer::~UniformBuffer() {
+    glDeleteBuffers(1, &buffer);
+}
+
+void UniformBuffer::Allocate(size_t bytes) {
+    glBindBuffer(target, buffer);
+    glBufferData(target, static_cast<GLsizeiptr>(bytes), nullptr, usage);
+    size = bytes;
+}
+
+void UniformBuffer::Reserve(size_t bytes) {
+    if (bytes <= size)
+        return;
+
+    unsigned int grown;
+    glGenBuffers(1, &grown);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, grown);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, usage);
+
+    if (size > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(size));
+    }
+
+    glDeleteBuffers(1, &buffer);
+    buffer = grown;
+    size = bytes;
+}
+
+void UniformBuffer::SetData(const void *data, size_t bytes, size_t offset) {
+    glBindBuffer(target, buffer);
+    glBufferSubData(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), data);
+}
+
+void UniformBuffer::BindBase(GLuint binding) const {
+    glBindBufferBase(target, binding, buffer);
+}
+
+void UniformBuffer::BindRange(GLuint binding, size_t offset, size_t bytes) const {
+    glBindBufferRange(target, binding, buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes));
+}
+
+size_t UniformBuffer::GetSize() const {
+    return size;
+}
+
+unsigned int UniformBuffer::GetID() const {
+    return buffer;
+}
\ No newline at end of file
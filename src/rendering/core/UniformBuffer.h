@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+
+#include <glad/glad.h>
+
+/**
+ * @class UniformBuffer
+ * @brief GL buffer bound to indexed UBO or SSBO binding points
+ */
+class UniformBuffer {
+private:
+    unsigned int buffer = 0;
+    GLenum target;
+    GLenum usage;
+    size_t size = 0;
+
+public:
+    /// @param bufferTarget GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER
+    explicit UniformBuffer(GLenum bufferTarget = GL_UNIFORM_BUFFER, GLenum bufferUsage = GL_DYNAMIC_DRAW);
+
+    ~UniformBuffer();
+
+    UniformBuffer(const UniformBuffer &) = delete;
+
+    UniformBuffer &operator=(const UniformBuffer &) = delete;
+
+    /// Re-specify the store, orphaning the old contents so in-flight draws never stall the upload
+    void Allocate(size_t bytes);
+
+    /// Grow to at least @p bytes, keeping the current contents
+    void Reserve(size_t bytes);
+
+    void SetData(const void *data, size_t bytes, size_t offset = 0);
+
+    void BindBase(GLuint binding) const;
+
+    void BindRange(GLuint binding, size_t offset, size_t bytes) const;
+
+    size_t GetSize() const;
+
+    unsigned int GetID() const;
+};
\ No newline at end of file
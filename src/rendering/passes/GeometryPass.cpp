@@ -1,6 +1,7 @@
 #include "GeometryPass.h"
 #include <string>
 #include "core/CommandManager.h"
+#include "rendering/RenderCommands.h"
 
 GeometryPass::GeometryPass(GLContext *ctx, ShaderManager *sm, ECSWorld *w)
     : RenderPass("GeometryPass", ctx, sm)
@@ -17,6 +18,11 @@ void GeometryPass::SetShadowData(const std::vector<glm::mat4> &lightSpaceMatrice
     m_CubeShadowMapIndices = CubeShadowMapIndices;
 }
 
+void GeometryPass::SetCascades(const glm::vec4 &splits, int count) {
+    m_CascadeSplits = splits;
+    m_CascadeCount = count;
+}
+
 void GeometryPass::Setup() {
     glDepthMask(GL_TRUE);
     glEnable(GL_DEPTH_TEST); //context->SetDepthTest(true);
@@ -31,18 +37,20 @@ void GeometryPass::Execute(const glm::mat4 &view, const glm::mat4 &projection) {
     if (!enabled || !world) return;
     Setup();
 
-    CommandManager::ExecuteCommand("Renderer_RenderGeometry",
-                                   {
-                                       view,                   // 0
-                                       projection,             // 1
-                                       std::string("basic"), // 2
-                                       m_LightSpaceMatrices,   // 3
-                                       m_shadowMapArray,       // 4
-                                       m_ShadowMapIndices,     // 5
-                                       m_CubeShadowMapArray,   // 6
-                                       m_CubeShadowMapIndices  // 7
-                                   });
+    static const std::string shaderName = "basic";
 
+    CommandManager::Execute<RenderGeometryCommand>({
+        .view = view,
+        .projection = projection,
+        .shaderName = shaderName,
+        .lightSpaceMatrices = m_LightSpaceMatrices,
+        .shadowMapArray = m_shadowMapArray,
+        .shadowMapIndices = &m_ShadowMapIndices,
+        .cubeShadowMapArray = m_CubeShadowMapArray,
+        .cubeShadowMapIndices = &m_CubeShadowMapIndices,
+        .cascadeSplits = m_CascadeSplits,
+        .cascadeCount = m_CascadeCount
+    });
 
     CleanupShadowBinding();
 }
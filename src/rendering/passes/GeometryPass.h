@@ -20,6 +20,8 @@ class GeometryPass : public RenderPass {
     GLuint m_shadowMapArray;
     GLuint m_CubeShadowMapArray;
     std::vector<int> m_CubeShadowMapIndices;
+    glm::vec4 m_CascadeSplits{0.0f};
+    int m_CascadeCount = 0;
 
     static constexpr int SHADOW_MAP_TEXTURE_SLOT = 6;
     static constexpr int CUBE_SHADOW_MAP_TEXTURE_SLOT = 4;
@@ -31,6 +33,8 @@ public:
                        const std::vector<int> &shadowMapIndices = {}, GLuint shadowCubeMapArray = 0,
                        const std::vector<int> &CubeShadowMapIndices = {});
 
+    void SetCascades(const glm::vec4 &splits, int count);
+
     void Setup() override;
 
     void Execute(const glm::mat4 &view, const glm::mat4 &projection) override;
@@ -1,13 +1,47 @@
 #include "ShadowPass.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstring>
 #include <entt/entt.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include "core/logging/Logger.h"
 
+namespace {
+    /// How far behind a cascade, towards the light, casters are still rendered into it
+    constexpr float CASCADE_CASTER_DISTANCE = 100.0f;
+
+    /// @param sphere light position in xyz, range in w
+    bool InLightRange(const MeshBounds &bounds, const glm::vec4 &sphere) {
+        if (!bounds.valid)
+            return true;
+        const glm::vec3 offset = bounds.center - glm::vec3(sphere);
+        const float reach = bounds.radius + sphere.w;
+        return glm::dot(offset, offset) <= reach * reach;
+    }
+
+    bool HasGLExtension(const char *name) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; i++) {
+            const auto *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+            if (extension && std::strcmp(extension, name) == 0)
+                return true;
+        }
+        return false;
+    }
+}
+
 ShadowPass::ShadowPass(GLContext *ctx, ShaderManager *sm, ECSWorld *world)
     : RenderPass("ShadowPass", ctx, sm)
       , m_World(world) {
-    InitializeShadowMap(MAX_DIR_SPOT_LIGHTS);
+    // Writing gl_Layer from the vertex shader lets one instanced draw cover every visible cube face
+    m_LayeredCubes = HasGLExtension("GL_ARB_shader_viewport_layer_array") ||
+                     HasGLExtension("GL_AMD_vertex_shader_layer");
+    Logger::Log(LogLevel::INFO, std::string("ShadowPass: point shadows use ") +
+                                (m_LayeredCubes ? "vertex shader layer selection" : "the geometry shader"));
+
+    InitializeShadowMap(MAX_SHADOW_LAYERS);
     InitializeCubeShadowMap(MAX_POINT_LIGHTS);
 }
 
@@ -18,136 +52,405 @@ ShadowPass::~ShadowPass() {
 void ShadowPass::Setup() {
 }
 
-void ShadowPass::Execute(const glm::mat4 &, const glm::mat4 &) {
-    assert(m_LightSpaceMatrices.size() == MAX_DIR_SPOT_LIGHTS && "LightSpaceMatrices not initialized!");
-    assert(m_ShadowFBOs.size() == MAX_DIR_SPOT_LIGHTS && "ShadowFBOs not initialized!");
+void ShadowPass::Execute(const glm::mat4 &view, const glm::mat4 &projection) {
+    assert(m_LightSpaceMatrices.size() == MAX_SHADOW_LAYERS && "LightSpaceMatrices not initialized!");
+    assert(m_ShadowFBOs.size() == MAX_SHADOW_LAYERS && "ShadowFBOs not initialized!");
+
+    m_CastersDrawn = 0;
+    m_CastersCulled = 0;
+    m_LayersUpdated = 0;
+    m_LayersSkipped = 0;
+    m_StaticRefreshes = 0;
+    m_RefreshesDeferred = 0;
 
-    if (!enabled || !m_World)
+    // Nothing is tracked while disabled, so whatever was cached may be out of date by the time it comes back
+    if (!enabled || !m_World) {
+        InvalidateCache();
         return;
+    }
 
-    m_ShadowMapIndices.assign(8, -1);
-    m_PointShadowMapIndices.assign(8, -1);
-
-    std::vector<LightComponent> shadowLights;
-    std::vector<LightComponent> pointShadowLights;
-    std::vector<int> globalLightIndices;
-
-    auto renderSceneDepth = [&](const std::string& shaderName) {
-        m_World->Each<TransformComponent, MeshComponent, VisibilityComponent>(
-            [&](entt::entity entity,
-                TransformComponent &transform,
-                MeshComponent &meshComp,
-                VisibilityComponent &vis){
-                    if (!vis.isActive || !vis.visible || !meshComp.mesh)
-                        return;
-
-                    glm::mat4 model = m_World->GetGlobalTransform(entity);
-                    shaderManager->SetMat4(shaderName, "model", model);
-                    meshComp.mesh->DrawDepthOnly();
-                }
-            );
+    m_Frame++;
+    m_ShadowMapIndices.clear();
+    m_PointShadowMapIndices.clear();
+
+    // A cube light owns slot `first` of the cube array; the others own `count` 2D layers from `first`
+    struct ShadowLight {
+        LightComponent light;
+        entt::entity entity;
+        size_t lightIndex;
+        bool cube;
+        int first;
+        int count;
     };
 
-    int globalIndex = 0;
-    m_World->Each<LightComponent>(
-        [&](entt::entity, LightComponent &light) {
-            if (!light.isActive) {
-                globalIndex++;
+    std::vector<ShadowLight> shadowLights;
+    int usedLayers = 0;
+    int usedCubes = 0;
+
+    // Same lights in the same order as LightSystem::Update, so the index vectors line up with its output
+    m_World->Each<LightComponent, TransformComponent>(
+        [&](entt::entity entity, LightComponent &light, TransformComponent &transform) {
+            if (!light.isActive)
                 return;
-            }
 
-            if (globalIndex < MAX_SHADOW_LIGHTS) {
-                if (light.castShadows && light.type == LightType::POINT && shadowLights.size() < MAX_DIR_SPOT_LIGHTS) {
-                    int pointShadowIndex = static_cast<int>(pointShadowLights.size());
-                    m_PointShadowMapIndices[globalIndex] = pointShadowIndex;
-                    pointShadowLights.push_back(light);
-                }
-                else if (light.castShadows && light.type != LightType::POINT && shadowLights.size() < MAX_DIR_SPOT_LIGHTS) {
-                    int shadowIndex = static_cast<int>(shadowLights.size());
-                    m_ShadowMapIndices[globalIndex] = shadowIndex;
-                    shadowLights.push_back(light);
-                    globalLightIndices.push_back(globalIndex);
+            light.SyncWithTransform(transform);
+
+            const size_t lightIndex = m_ShadowMapIndices.size();
+            m_ShadowMapIndices.push_back(-1);
+            m_PointShadowMapIndices.push_back(-1);
+
+            if (!light.castShadows)
+                return;
+
+            if (light.type == LightType::POINT) {
+                if (usedCubes < MAX_POINT_LIGHTS) {
+                    m_PointShadowMapIndices[lightIndex] = usedCubes;
+                    shadowLights.push_back({light, entity, lightIndex, true, usedCubes, 1});
+                    usedCubes++;
                 }
+                return;
             }
-            globalIndex++;
+
+            const int layers = light.type == LightType::DIRECTIONAL ? m_CascadeCount : 1;
+            if (usedLayers + layers > MAX_SHADOW_LAYERS)
+                return;
+
+            m_ShadowMapIndices[lightIndex] = usedLayers;
+            shadowLights.push_back({light, entity, lightIndex, false, usedLayers, layers});
+            usedLayers += layers;
         });
 
+    GatherCasters();
+
+    float cameraNear = 0.0f;
+    float cameraFar = 0.0f;
+    ComputeCascadeSplits(projection, cameraNear, cameraFar);
+
+    // World-space camera frustum corners: near plane in 0..3, matching far corners in 4..7
+    const glm::mat4 invViewProjection = glm::inverse(projection * view);
+    std::array<glm::vec3, 8> frustumCorners;
+    for (int i = 0; i < 8; i++) {
+        const glm::vec4 ndc((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+        const glm::vec4 corner = invViewProjection * ndc;
+        frustumCorners[i] = glm::vec3(corner) / corner.w;
+    }
+
+    std::array<glm::mat4, MAX_SHADOW_LAYERS> desired{};
+    std::array<std::array<glm::mat4, 6>, MAX_POINT_LIGHTS> cubeFaces{};
+    for (const ShadowLight &entry : shadowLights) {
+        if (entry.cube) {
+            cubeFaces[entry.first] = BuildPointSpaceMatrices(entry.light);
+            continue;
+        }
+
+        if (entry.light.type == LightType::SPOT) {
+            desired[entry.first] = BuildSpotLightMatrix(entry.light);
+            continue;
+        }
+
+        const glm::vec3 lightDir = glm::normalize(entry.light.direction);
+        for (int cascade = 0; cascade < entry.count; cascade++) {
+            const float splitNear = cascade == 0 ? cameraNear : m_CascadeSplits[cascade - 1];
+            desired[entry.first + cascade] = BuildCascadeMatrix(lightDir, frustumCorners, cameraNear, cameraFar,
+                                                                splitNear, m_CascadeSplits[cascade]);
+        }
+    }
+
+    InvalidateLayers();
+
+    // Cubes are keyed by their +X face matrix, which pins both position and range
+    auto cacheOf = [&](const ShadowLight &entry, int i) -> LayerCache & {
+        return entry.cube ? m_CubeCache[entry.first] : m_LayerCache[entry.first + i];
+    };
+    auto desiredOf = [&](const ShadowLight &entry, int i) -> const glm::mat4 & {
+        return entry.cube ? cubeFaces[entry.first][0] : desired[entry.first + i];
+    };
+
+    // A light is stale when any of its caches was baked for another light, another matrix, or before a static caster changed
+    std::vector<bool> cached(shadowLights.size(), true);
+    std::vector<size_t> stale;
+    for (size_t k = 0; k < shadowLights.size(); k++) {
+        const ShadowLight &entry = shadowLights[k];
+        bool isStale = false;
+
+        for (int i = 0; i < entry.count; i++) {
+            const LayerCache &cache = cacheOf(entry, i);
+            const bool sameLight = cache.light == entry.entity;
+            const bool sameMatrix = cache.matrix == desiredOf(entry, i);
+
+            // Cube depth is measured from LightBlock.position, so a cube rendered elsewhere cannot stand in
+            if (!sameLight || !cache.hasStatic || (entry.cube && !sameMatrix))
+                cached[k] = false;
+            if (!sameLight || !cache.staticValid || !sameMatrix)
+                isStale = true;
+        }
+
+        if (isStale)
+            stale.push_back(k);
+    }
+
+    // Lights with nothing usable cached go first, then whichever has waited longest
+    std::stable_sort(stale.begin(), stale.end(), [&](size_t a, size_t b) {
+        if (cached[a] != cached[b])
+            return !cached[a];
+        return cacheOf(shadowLights[a], 0).staleFrames > cacheOf(shadowLights[b], 0).staleFrames;
+    });
+
+    const size_t refreshCount = m_RefreshBudget > 0
+                                    ? std::min(stale.size(), static_cast<size_t>(m_RefreshBudget))
+                                    : stale.size();
+
+    std::vector<bool> refresh(shadowLights.size(), false);
+    for (size_t k = 0; k < stale.size(); k++) {
+        const ShadowLight &entry = shadowLights[stale[k]];
+        if (k < refreshCount) {
+            refresh[stale[k]] = true;
+            continue;
+        }
+
+        // Deferred lights keep sampling their old depth; without any, they go unshadowed this frame
+        m_RefreshesDeferred++;
+        cacheOf(entry, 0).staleFrames++;
+        if (!cached[stale[k]])
+            (entry.cube ? m_PointShadowMapIndices : m_ShadowMapIndices)[entry.lightIndex] = -1;
+    }
+
+    // isVisible gets the caster's world bounds and decides whether it can touch this shadow map
+    auto drawCasters = [&](const std::vector<Caster> &casters, UniformHandle modelUniform, const auto &isVisible) {
+        for (const Caster &caster : casters) {
+            if (!isVisible(caster.bounds)) {
+                m_CastersCulled++;
+                continue;
+            }
+
+            m_CastersDrawn++;
+            shaderManager->SetMat4(modelUniform, caster.matrix);
+            caster.mesh->DrawDepthOnly();
+        }
+    };
+
     shaderManager->Bind("shadow_depth");
+    const UniformHandle lightSpaceUniform = shaderManager->GetUniformHandle("shadow_depth", "lightSpaceMatrix");
+    const UniformHandle modelUniform = shaderManager->GetUniformHandle("shadow_depth", "model");
     glDisable(GL_CULL_FACE);
     glCullFace(GL_FRONT);
+    glViewport(0, 0, m_ShadowMapSize, m_ShadowMapSize);
+
+    for (size_t k = 0; k < shadowLights.size(); k++) {
+        const ShadowLight &entry = shadowLights[k];
+        if (entry.cube || (!refresh[k] && !cached[k]))
+            continue;
 
-    for (int i = 0; i < shadowLights.size(); i++) {
-        auto &light = shadowLights[i];
+        if (refresh[k])
+            m_StaticRefreshes++;
 
-        glBindFramebuffer(GL_FRAMEBUFFER, m_ShadowFBOs[i]);
-        glViewport(0, 0, m_ShadowMapSize, m_ShadowMapSize);
-        glClear(GL_DEPTH_BUFFER_BIT);
+        for (int layer = entry.first; layer < entry.first + entry.count; layer++) {
+            LayerCache &cache = m_LayerCache[layer];
 
-        glm::mat4 lightMatrix;
+            if (refresh[k]) {
+                glBindFramebuffer(GL_FRAMEBUFFER, m_StaticShadowFBOs[layer]);
+                glClear(GL_DEPTH_BUFFER_BIT);
+                shaderManager->SetMat4(lightSpaceUniform, desired[layer]);
 
-        if (light.type == LightType::DIRECTIONAL)
-            lightMatrix = BuildLightSpaceMatrix(glm::normalize(light.direction));
-        else if (light.type == LightType::SPOT)
-            lightMatrix = BuildSpotLightMatrix(light);
-        else
-            continue;
+                const Frustum staticFrustum(desired[layer]);
+                drawCasters(m_StaticCasters, modelUniform, [&](const MeshBounds &bounds) {
+                    return staticFrustum.Intersects(bounds);
+                });
+
+                cache.light = entry.entity;
+                cache.matrix = desired[layer];
+                cache.hasStatic = true;
+                cache.staticValid = true;
+                cache.liveValid = false;
+                cache.staleFrames = 0;
+            }
 
-        m_LightSpaceMatrices[i] = lightMatrix;
-        shaderManager->SetMat4("shadow_depth", "lightSpaceMatrix", lightMatrix);
+            m_LightSpaceMatrices[layer] = cache.matrix;
 
-        renderSceneDepth("shadow_depth");
+            const Frustum lightFrustum(cache.matrix);
+            const bool dynamicHit = std::any_of(m_DynamicCasters.begin(), m_DynamicCasters.end(),
+                                                [&](const Caster &caster) {
+                                                    return lightFrustum.Intersects(caster.bounds);
+                                                });
+
+            // Still holds the static depth plus last frame's movers, and no mover is here now or was before
+            if (cache.liveValid && !dynamicHit && !cache.hadDynamic) {
+                m_LayersSkipped++;
+                continue;
+            }
+
+            CopyStaticLayer(layer);
+
+            if (dynamicHit) {
+                glBindFramebuffer(GL_FRAMEBUFFER, m_ShadowFBOs[layer]);
+                shaderManager->SetMat4(lightSpaceUniform, cache.matrix);
+                drawCasters(m_DynamicCasters, modelUniform, [&](const MeshBounds &bounds) {
+                    return lightFrustum.Intersects(bounds);
+                });
+            }
+
+            cache.liveValid = true;
+            cache.hadDynamic = dynamicHit;
+            m_LayersUpdated++;
+        }
     }
 
     shaderManager->Unbind();
 
-    shaderManager->Bind("shadowCubeMapDepth");
-    for (int i = 0; i < pointShadowLights.size(); i++) {
-        auto &light = pointShadowLights[i];
+    // Each cube light renders into its own six layers. The layered path draws one instance per visible face and
+    // picks the layer in the vertex shader; the fallback lets the geometry shader skip the hidden faces.
+    const std::string cubeShader = m_LayeredCubes ? "shadowCubeLayered" : "shadowCubeMapDepth";
+    shaderManager->Bind(cubeShader);
+    const UniformHandle shadowMatricesUniform = shaderManager->GetUniformHandle(cubeShader, "shadowMatrices");
+    const UniformHandle lightPosUniform = shaderManager->GetUniformHandle(cubeShader, "lightPos");
+    const UniformHandle farPlaneUniform = shaderManager->GetUniformHandle(cubeShader, "far_plane");
+    const UniformHandle cubeModelUniform = shaderManager->GetUniformHandle(cubeShader, "model");
+    const UniformHandle firstLayerUniform = shaderManager->GetUniformHandle(cubeShader, "firstLayer");
+    const UniformHandle facesUniform = shaderManager->GetUniformHandle(cubeShader, m_LayeredCubes ? "faceList" : "faceMask");
+
+    auto drawCubeCasters = [&](const std::vector<Caster> &casters, const std::array<Frustum, 6> &faceFrustums,
+                               const glm::vec4 &sphere) {
+        for (const Caster &caster : casters) {
+            if (!InLightRange(caster.bounds, sphere)) {
+                m_CastersCulled += 6;
+                continue;
+            }
 
-        glBindFramebuffer(GL_FRAMEBUFFER, m_CubeShadowFBO);
-        glViewport(0, 0, m_ShadowMapSize, m_ShadowMapSize);
-        glClear(GL_DEPTH_BUFFER_BIT);
+            int faceMask = 0;
+            int faceList = 0;
+            int faceCount = 0;
+            for (int face = 0; face < 6; face++) {
+                if (!faceFrustums[face].Intersects(caster.bounds))
+                    continue;
+                faceMask |= 1 << face;
+                faceList |= face << (3 * faceCount);
+                faceCount++;
+            }
 
-        auto matrices = BuildPointSpaceMatrices(light);
-        for ( int face = 0; face < 6; face++ ) {
-            std::string name = "shadowMatrices[" + std::to_string(face) + "]";
-            shaderManager->SetMat4("shadowCubeMapDepth", name, matrices[face]);
+            m_CastersDrawn += faceCount;
+            m_CastersCulled += 6 - faceCount;
+            if (faceCount == 0)
+                continue;
+
+            shaderManager->SetMat4(cubeModelUniform, caster.matrix);
+            if (m_LayeredCubes) {
+                shaderManager->SetInt(facesUniform, faceList);
+                caster.mesh->DrawDepthOnlyInstanced(*context, faceCount);
+            } else {
+                shaderManager->SetInt(facesUniform, faceMask);
+                caster.mesh->DrawDepthOnly();
+            }
+        }
+    };
+
+    for (size_t k = 0; k < shadowLights.size(); k++) {
+        const ShadowLight &entry = shadowLights[k];
+        if (!entry.cube || (!refresh[k] && !cached[k]))
+            continue;
+
+        LayerCache &cache = m_CubeCache[entry.first];
+        const std::array<glm::mat4, 6> &faces = cubeFaces[entry.first];
+        const float far = std::max(entry.light.radius, 100.0f);
+        const glm::vec4 sphere(entry.light.position, far);
+
+        std::array<Frustum, 6> faceFrustums;
+        for (int face = 0; face < 6; face++)
+            faceFrustums[face].Update(faces[face]);
+
+        shaderManager->SetMat4Array(shadowMatricesUniform, faces.data(), 6);
+        shaderManager->SetVec3(lightPosUniform, entry.light.position);
+        shaderManager->SetFloat(farPlaneUniform, far);
+        shaderManager->SetInt(firstLayerUniform, entry.first * 6);
+
+        if (refresh[k]) {
+            m_StaticRefreshes++;
+            ClearCube(m_StaticCubeShadowMapArray, entry.first);
+            glBindFramebuffer(GL_FRAMEBUFFER, m_StaticCubeShadowFBO);
+            drawCubeCasters(m_StaticCasters, faceFrustums, sphere);
+
+            cache.light = entry.entity;
+            cache.matrix = faces[0];
+            cache.sphere = sphere;
+            cache.hasStatic = true;
+            cache.staticValid = true;
+            cache.liveValid = false;
+            cache.staleFrames = 0;
+        }
+
+        const bool dynamicHit = std::any_of(m_DynamicCasters.begin(), m_DynamicCasters.end(),
+                                            [&](const Caster &caster) {
+                                                return InLightRange(caster.bounds, sphere);
+                                            });
+
+        if (cache.liveValid && !dynamicHit && !cache.hadDynamic) {
+            m_LayersSkipped += 6;
+            continue;
         }
 
-        float far = std::max(light.radius, 100.0f);
-        shaderManager->SetVec3("shadowCubeMapDepth", "lightPos", light.position);
-        shaderManager->SetFloat("shadowCubeMapDepth", "far_plane", far);
+        CopyStaticCube(entry.first);
 
-        renderSceneDepth("shadowCubeMapDepth");
+        if (dynamicHit) {
+            glBindFramebuffer(GL_FRAMEBUFFER, m_CubeShadowFBO);
+            drawCubeCasters(m_DynamicCasters, faceFrustums, sphere);
+        }
+
+        cache.liveValid = true;
+        cache.hadDynamic = dynamicHit;
+        m_LayersUpdated += 6;
     }
 
+    if (m_LayeredCubes)
+        context->UnbindVAO();
+
     glCullFace(GL_BACK);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+
 void ShadowPass::Cleanup() {
     if (!m_ShadowFBOs.empty()) {
         glDeleteFramebuffers(static_cast<GLsizei>(m_ShadowFBOs.size()), m_ShadowFBOs.data());
         m_ShadowFBOs.clear();
     }
 
+    if (!m_StaticShadowFBOs.empty()) {
+        glDeleteFramebuffers(static_cast<GLsizei>(m_StaticShadowFBOs.size()), m_StaticShadowFBOs.data());
+        m_StaticShadowFBOs.clear();
+    }
+
     if (m_ShadowMapArray != 0) {
         glDeleteTextures(1, &m_ShadowMapArray);
         m_ShadowMapArray = 0;
     }
 
+    if (m_StaticShadowMapArray != 0) {
+        glDeleteTextures(1, &m_StaticShadowMapArray);
+        m_StaticShadowMapArray = 0;
+    }
+
     if (m_CubeShadowFBO != 0) {
         glDeleteFramebuffers(1, &m_CubeShadowFBO);
         m_CubeShadowFBO = 0;
     }
 
+    if (m_StaticCubeShadowFBO != 0) {
+        glDeleteFramebuffers(1, &m_StaticCubeShadowFBO);
+        m_StaticCubeShadowFBO = 0;
+    }
+
     if (m_CubeShadowMapArray != 0) {
         glDeleteTextures(1, &m_CubeShadowMapArray);
         m_CubeShadowMapArray = 0;
     }
 
+    if (m_StaticCubeShadowMapArray != 0) {
+        glDeleteTextures(1, &m_StaticCubeShadowMapArray);
+        m_StaticCubeShadowMapArray = 0;
+    }
+
     m_LightSpaceMatrices.clear();
     m_ShadowMapIndices.clear();
+    InvalidateCache();
 }
 
 GLuint ShadowPass::GetShadowMapArray() const {
@@ -174,29 +477,76 @@ int ShadowPass::GetShadowMapSize() const {
     return m_ShadowMapSize;
 }
 
+const glm::vec4 &ShadowPass::GetCascadeSplits() const {
+    return m_CascadeSplits;
+}
+
+int ShadowPass::GetCascadeCount() const {
+    return m_CascadeCount;
+}
+
+int ShadowPass::GetCastersDrawn() const {
+    return m_CastersDrawn;
+}
+
+int ShadowPass::GetCastersCulled() const {
+    return m_CastersCulled;
+}
+
+int ShadowPass::GetLayersUpdated() const {
+    return m_LayersUpdated;
+}
+
+int ShadowPass::GetLayersSkipped() const {
+    return m_LayersSkipped;
+}
+
+int ShadowPass::GetStaticRefreshes() const {
+    return m_StaticRefreshes;
+}
+
+int ShadowPass::GetRefreshesDeferred() const {
+    return m_RefreshesDeferred;
+}
+
 void ShadowPass::SetShadowMapSize(int size) {
-    if (size == m_ShadowMapSize) return;
+    if (size == m_ShadowMapSize || size <= 0) return;
     m_ShadowMapSize = size;
     Cleanup();
-    InitializeShadowMap(8);
+    InitializeShadowMap(MAX_SHADOW_LAYERS);
+    InitializeCubeShadowMap(MAX_POINT_LIGHTS);
 }
 
-void ShadowPass::SetOrthoSize(float size) {
-    m_OrthoSize = size;
+void ShadowPass::SetCascades(int count, float lambda, float distance) {
+    m_CascadeCount = std::clamp(count, 1, MAX_SHADOW_CASCADES);
+    m_SplitLambda = std::clamp(lambda, 0.0f, 1.0f);
+    m_ShadowDistance = std::max(distance, 1.0f);
 }
 
-void ShadowPass::SetFarPlane(float farP) {
-    m_FarPlane = farP;
+void ShadowPass::SetRefreshBudget(int lightsPerFrame) {
+    m_RefreshBudget = std::max(lightsPerFrame, 0);
+}
+
+void ShadowPass::InvalidateCache() {
+    m_LayerCache.fill(LayerCache{});
+    m_CubeCache.fill(LayerCache{});
 }
 
 void ShadowPass::InitializeShadowMap(int count) {
-    m_ShadowFBOs.resize(count, 0);
     m_LightSpaceMatrices.resize(count, glm::mat4(1.0f));
 
-    glGenFramebuffers(count, m_ShadowFBOs.data());
+    m_ShadowMapArray = CreateShadowArray(count, m_ShadowFBOs);
+    m_StaticShadowMapArray = CreateShadowArray(count, m_StaticShadowFBOs);
+    InvalidateCache();
+}
+
+GLuint ShadowPass::CreateShadowArray(int count, std::vector<GLuint> &fbos) const {
+    fbos.resize(count, 0);
+    glGenFramebuffers(count, fbos.data());
 
-    glGenTextures(1, &m_ShadowMapArray);
-    glBindTexture(GL_TEXTURE_2D_ARRAY, m_ShadowMapArray);
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
     glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_DEPTH_COMPONENT32F,
                    m_ShadowMapSize, m_ShadowMapSize, count);
 
@@ -211,9 +561,9 @@ void ShadowPass::InitializeShadowMap(int count) {
 
     for (int i = 0; i < count; i++) {
         // framebuffers initializating
-        glBindFramebuffer(GL_FRAMEBUFFER, m_ShadowFBOs[i]);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbos[i]);
         glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
-                                  m_ShadowMapArray, 0, i);
+                                  texture, 0, i);
         glDrawBuffer(GL_NONE);
         glReadBuffer(GL_NONE);
 
@@ -228,11 +578,118 @@ void ShadowPass::InitializeShadowMap(int count) {
     }
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return texture;
+}
+
+void ShadowPass::GatherCasters() {
+    m_StaticCasters.clear();
+    m_DynamicCasters.clear();
+    m_Invalidated.clear();
+
+    const uint64_t transformFrame = m_World->GetTransformFrame();
+
+    m_World->GroupEach<WorldTransformComponent, MeshComponent, VisibilityComponent>(
+        [&](entt::entity entity,
+            WorldTransformComponent &worldTransform,
+            MeshComponent &meshComp,
+            VisibilityComponent &vis) {
+            if (!vis.isActive || !vis.visible || !meshComp.mesh)
+                return;
+
+            Mesh *mesh = meshComp.mesh.get();
+            const Caster caster{mesh, worldTransform.matrix, mesh->GetBounds().Transform(worldTransform.matrix)};
+            auto baked = m_BakedCasters.find(entity);
+
+            if (worldTransform.GetStableFrames(transformFrame) < STATIC_CASTER_FRAMES) {
+                // Started moving: its old depth is still in the static layers
+                if (baked != m_BakedCasters.end()) {
+                    m_Invalidated.push_back(baked->second.bounds);
+                    m_BakedCasters.erase(baked);
+                }
+                m_DynamicCasters.push_back(caster);
+                return;
+            }
+
+            if (baked == m_BakedCasters.end()) {
+                m_Invalidated.push_back(caster.bounds);
+                m_BakedCasters.emplace(entity, BakedCaster{mesh, caster.bounds, m_Frame});
+            } else {
+                if (baked->second.mesh != mesh) {
+                    m_Invalidated.push_back(baked->second.bounds);
+                    m_Invalidated.push_back(caster.bounds);
+                    baked->second.mesh = mesh;
+                    baked->second.bounds = caster.bounds;
+                }
+                baked->second.seenFrame = m_Frame;
+            }
+
+            m_StaticCasters.push_back(caster);
+        });
+
+    // Baked casters that were not visited were destroyed or hidden
+    std::erase_if(m_BakedCasters, [this](const auto &entry) {
+        if (entry.second.seenFrame == m_Frame)
+            return false;
+        m_Invalidated.push_back(entry.second.bounds);
+        return true;
+    });
+}
+
+void ShadowPass::InvalidateLayers() {
+    if (m_Invalidated.empty())
+        return;
+
+    for (LayerCache &cache : m_LayerCache) {
+        if (!cache.staticValid)
+            continue;
+
+        const Frustum bakedFrustum(cache.matrix);
+        cache.staticValid = std::none_of(m_Invalidated.begin(), m_Invalidated.end(),
+                                         [&](const MeshBounds &bounds) {
+                                             return bakedFrustum.Intersects(bounds);
+                                         });
+    }
+
+    for (LayerCache &cache : m_CubeCache) {
+        if (!cache.staticValid)
+            continue;
+
+        cache.staticValid = std::none_of(m_Invalidated.begin(), m_Invalidated.end(),
+                                         [&](const MeshBounds &bounds) {
+                                             return InLightRange(bounds, cache.sphere);
+                                         });
+    }
+}
+
+void ShadowPass::CopyStaticLayer(int layer) const {
+    glCopyImageSubData(m_StaticShadowMapArray, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer,
+                       m_ShadowMapArray, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer,
+                       m_ShadowMapSize, m_ShadowMapSize, 1);
+}
+
+void ShadowPass::CopyStaticCube(int slot) const {
+    glCopyImageSubData(m_StaticCubeShadowMapArray, GL_TEXTURE_CUBE_MAP_ARRAY, 0, 0, 0, slot * 6,
+                       m_CubeShadowMapArray, GL_TEXTURE_CUBE_MAP_ARRAY, 0, 0, 0, slot * 6,
+                       m_ShadowMapSize, m_ShadowMapSize, 6);
+}
+
+void ShadowPass::ClearCube(GLuint texture, int slot) const {
+    // A layered FBO would clear every cube, so only this light's six layers are reset
+    const float farDepth = 1.0f;
+    glClearTexSubImage(texture, 0, 0, 0, slot * 6, m_ShadowMapSize, m_ShadowMapSize, 6,
+                       GL_DEPTH_COMPONENT, GL_FLOAT, &farDepth);
 }
 
 void ShadowPass::InitializeCubeShadowMap(const int count) {
-    glGenTextures(1, &m_CubeShadowMapArray);
-    glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, m_CubeShadowMapArray);
+    m_CubeShadowMapArray = CreateCubeArray(count, m_CubeShadowFBO);
+    m_StaticCubeShadowMapArray = CreateCubeArray(count, m_StaticCubeShadowFBO);
+    m_CubeCache.fill(LayerCache{});
+}
+
+GLuint ShadowPass::CreateCubeArray(int count, GLuint &fbo) const {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, texture);
     glTexStorage3D(GL_TEXTURE_CUBE_MAP_ARRAY, 1, GL_DEPTH_COMPONENT32F,
         m_ShadowMapSize, m_ShadowMapSize, count * 6);
 
@@ -244,9 +701,13 @@ void ShadowPass::InitializeCubeShadowMap(const int count) {
     // glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
     // glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
 
-    glGenFramebuffers(1, &m_CubeShadowFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_CubeShadowFBO);
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_CubeShadowMapArray, 0);
+    // Layers beyond the lights cast this frame must still read as unoccluded
+    const float farDepth = 1.0f;
+    glClearTexImage(texture, 0, GL_DEPTH_COMPONENT, GL_FLOAT, &farDepth);
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0);
     glDrawBuffer(GL_NONE);
     glReadBuffer(GL_NONE);
 
@@ -257,21 +718,69 @@ void ShadowPass::InitializeCubeShadowMap(const int count) {
         Logger::Log(LogLevel::INFO, "ShadowPass: cube shadow map FBO created");
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return texture;
 }
 
-glm::mat4 ShadowPass::BuildLightSpaceMatrix(const glm::vec3 &lightDir) const {
-    glm::vec3 sceneCenter{0.0f, 0.0f, 0.0f};
-    glm::vec3 lightPos = sceneCenter - lightDir * (m_FarPlane * 0.5f);
+void ShadowPass::ComputeCascadeSplits(const glm::mat4 &projection, float &nearPlane, float &farPlane) {
+    if (projection[2][3] == 0.0f) {
+        nearPlane = (projection[3][2] + 1.0f) / projection[2][2];
+        farPlane = (projection[3][2] - 1.0f) / projection[2][2];
+    } else {
+        nearPlane = projection[3][2] / (projection[2][2] - 1.0f);
+        farPlane = projection[3][2] / (projection[2][2] + 1.0f);
+    }
+
+    // The logarithmic term needs a positive start; cascades past the shadow distance are wasted texels
+    const float splitStart = std::max(nearPlane, 0.05f);
+    const float splitEnd = std::max(std::min(farPlane, m_ShadowDistance), splitStart + 0.01f);
+
+    m_CascadeSplits = glm::vec4(0.0f);
+    for (int i = 0; i < m_CascadeCount; i++) {
+        const float p = static_cast<float>(i + 1) / static_cast<float>(m_CascadeCount);
+        const float logSplit = splitStart * std::pow(splitEnd / splitStart, p);
+        const float uniformSplit = splitStart + (splitEnd - splitStart) * p;
+        m_CascadeSplits[i] = m_SplitLambda * logSplit + (1.0f - m_SplitLambda) * uniformSplit;
+    }
+}
 
-    glm::mat4 lightView = glm::lookAt(lightPos, sceneCenter, glm::vec3(0.0f, 1.0f, 0.0f));
+glm::mat4 ShadowPass::BuildCascadeMatrix(const glm::vec3 &lightDir, const std::array<glm::vec3, 8> &frustumCorners,
+                                         float cameraNear, float cameraFar, float splitNear, float splitFar) const {
+    // View depth is linear along each corner ray, so the cascade's corners are lerps between the planes
+    const float depthRange = std::max(cameraFar - cameraNear, 1e-4f);
+    const float t0 = (splitNear - cameraNear) / depthRange;
+    const float t1 = (splitFar - cameraNear) / depthRange;
+
+    std::array<glm::vec3, 8> corners;
+    glm::vec3 center(0.0f);
+    for (int i = 0; i < 4; i++) {
+        const glm::vec3 ray = frustumCorners[i + 4] - frustumCorners[i];
+        corners[i] = frustumCorners[i] + ray * t0;
+        corners[i + 4] = frustumCorners[i] + ray * t1;
+        center += corners[i] + corners[i + 4];
+    }
+    center /= 8.0f;
+
+    // Fitting a sphere rather than a box keeps the extent fixed while the camera turns
+    float radius = 0.0f;
+    for (const glm::vec3 &corner : corners)
+        radius = std::max(radius, glm::length(corner - center));
+    radius = std::ceil(radius * 16.0f) / 16.0f;
+
+    glm::vec3 up(0.0f, 1.0f, 0.0f);
+    if (glm::abs(glm::dot(lightDir, up)) > 0.99f)
+        up = glm::vec3(0.0f, 0.0f, 1.0f);
 
-    if (glm::abs(glm::dot(lightDir, glm::vec3(0.0f, 1.0f, 0.0f))) > 0.99f)
-        lightView = glm::lookAt(lightPos, sceneCenter, glm::vec3(0.0f, 0.0f, 1.0f));
+    // The eye sits behind the sphere so casters between the light and the cascade still reach the map
+    const float eyeDistance = radius + CASCADE_CASTER_DISTANCE;
+    const glm::mat4 lightView = glm::lookAt(center - lightDir * eyeDistance, center, up);
+    glm::mat4 lightProjection = glm::ortho(-radius, radius, -radius, radius, 0.0f, eyeDistance + radius);
 
-    glm::mat4 lightProjection = glm::ortho(
-        -m_OrthoSize, m_OrthoSize,
-        -m_OrthoSize, m_OrthoSize,
-        m_NearPlane, m_FarPlane);
+    // Move the projection by the sub-texel remainder of the world origin so texels stay put as the camera moves
+    const float halfSize = static_cast<float>(m_ShadowMapSize) * 0.5f;
+    const glm::vec2 originTexels = glm::vec2(lightProjection * lightView * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)) * halfSize;
+    const glm::vec2 snap = (glm::round(originTexels) - originTexels) / halfSize;
+    lightProjection[3][0] += snap.x;
+    lightProjection[3][1] += snap.y;
 
     return lightProjection * lightView;
 }
@@ -301,7 +810,7 @@ glm::mat4 ShadowPass::BuildSpotLightMatrix(const LightComponent &light) {
     return proj * view;
 }
 
-std::vector<glm::mat4> ShadowPass::BuildPointSpaceMatrices(const LightComponent &light) {
+std::array<glm::mat4, 6> ShadowPass::BuildPointSpaceMatrices(const LightComponent &light) {
     float far = std::max(light.radius, 100.0f);
     glm::mat4 proj = glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, far);
     glm::vec3 pos = light.position;
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include <glm/glm.hpp>
@@ -7,37 +10,107 @@
 
 #include "rendering/passes/RenderPass.h"
 #include "rendering/core/GLContext.h"
+#include "rendering/Frustum.h"
+#include "rendering/ShaderBlocks.h"
 #include "resource/shader/ShaderManager.h"
 #include "ECS/World.h"
 #include "ECS/components/Components.h"
 
 constexpr int MAX_POINT_LIGHTS = 4;
-constexpr int MAX_DIR_SPOT_LIGHTS = 6;
-constexpr int MAX_SHADOW_LIGHTS = MAX_DIR_SPOT_LIGHTS + MAX_POINT_LIGHTS;
+/// Layers of the 2D shadow array: a directional light takes one per cascade, a spot light one
+constexpr int MAX_SHADOW_LAYERS = MAX_FRAME_SHADOW_MATRICES;
+/// Updates a caster's world transform must stay unchanged before it is baked into the static shadow cache
+constexpr uint32_t STATIC_CASTER_FRAMES = 30;
 
+/**
+ * @class ShadowPass
+ * @brief Renders directional cascades, spot maps and point cubes
+ *
+ * Casters whose transform has been still for STATIC_CASTER_FRAMES are baked
+ * once per layer into a static array. Each frame the static depth is copied
+ * into the sampled array and only moving casters are drawn on top. A layer is
+ * skipped entirely when nothing that touches it changed.
+ *
+ * Every point light owns one cube of the cube array and writes only its six
+ * layers. Casters are culled per face, and only the faces they reach are drawn.
+ */
 class ShadowPass : public RenderPass {
     std::vector<GLuint> m_ShadowFBOs;
+    std::vector<GLuint> m_StaticShadowFBOs;
     GLuint m_CubeShadowFBO = 0;
+    GLuint m_StaticCubeShadowFBO = 0;
     GLuint m_ShadowMapArray = 0;
+    GLuint m_StaticShadowMapArray = 0;
     GLuint m_CubeShadowMapArray = 0;
+    GLuint m_StaticCubeShadowMapArray = 0;
+    /// Cube faces pick their layer in the vertex shader instead of being amplified by a geometry shader
+    bool m_LayeredCubes = false;
     int m_ShadowMapSize = 2048;
 
+    struct Caster {
+        Mesh *mesh;
+        glm::mat4 matrix;
+        MeshBounds bounds;
+    };
+
+    /// A caster baked into static layers, with the bounds it was baked at
+    struct BakedCaster {
+        Mesh *mesh;
+        MeshBounds bounds;
+        uint64_t seenFrame;
+    };
+
+    /// What a 2D layer's or a cube's static depth was rendered for
+    struct LayerCache {
+        entt::entity light = entt::null;
+        /// A cube stores its +X face matrix here
+        glm::mat4 matrix{1.0f};
+        /// Cubes only: light position and range
+        glm::vec4 sphere{0.0f};
+        bool hasStatic = false;
+        bool staticValid = false;
+        bool liveValid = false;
+        bool hadDynamic = false;
+        uint32_t staleFrames = 0;
+    };
+
+    std::vector<Caster> m_StaticCasters;
+    std::vector<Caster> m_DynamicCasters;
+    std::vector<MeshBounds> m_Invalidated;
+    std::unordered_map<entt::entity, BakedCaster> m_BakedCasters;
+    std::array<LayerCache, MAX_SHADOW_LAYERS> m_LayerCache;
+    std::array<LayerCache, MAX_POINT_LIGHTS> m_CubeCache;
+    uint64_t m_Frame = 0;
+
+    /// Lights whose static layers may be re-rendered per frame; 0 means no limit
+    int m_RefreshBudget = 2;
+
     ECSWorld *m_World = nullptr;
 
     std::vector<glm::mat4> m_LightSpaceMatrices;
     std::vector<int> m_ShadowMapIndices;
     std::vector<int> m_PointShadowMapIndices;
 
-    float m_OrthoSize = 30.0f;
-    float m_NearPlane = 1.0f;
-    float m_FarPlane = 100.0f;
+    int m_CascadeCount = 4;
+    float m_SplitLambda = 0.75f;
+    float m_ShadowDistance = 100.0f;
+    /// View-space depth where each cascade ends; unused entries are 0
+    glm::vec4 m_CascadeSplits{0.0f};
+
+    int m_CastersDrawn = 0;
+    int m_CastersCulled = 0;
+
+    int m_LayersUpdated = 0;
+    int m_LayersSkipped = 0;
+    int m_StaticRefreshes = 0;
+    int m_RefreshesDeferred = 0;
 
 public:
     ShadowPass(GLContext *ctx, ShaderManager *sm, ECSWorld *world);
     ~ShadowPass() override;
 
     void Setup() override;
-    void Execute(const glm::mat4 &, const glm::mat4 &) override;
+    void Execute(const glm::mat4 &view, const glm::mat4 &projection) override;
     void Cleanup() override;
 
     GLuint GetShadowMapArray() const;
@@ -46,16 +119,49 @@ public:
     const std::vector<int> &GetShadowMapIndices() const;
     const std::vector<int> &GetPointShadowMapIndices() const;
     int GetShadowMapSize() const;
+    const glm::vec4 &GetCascadeSplits() const;
+    int GetCascadeCount() const;
+
+    /// Caster draws issued / rejected across all shadow maps in the last Execute(); cube faces count individually
+    int GetCastersDrawn() const;
+    int GetCastersCulled() const;
+
+    /// Shadow layers (cube faces count individually) redrawn / left untouched in the last Execute()
+    int GetLayersUpdated() const;
+    int GetLayersSkipped() const;
+    /// Lights whose static depth was re-rendered, and stale ones pushed to a later frame by the budget
+    int GetStaticRefreshes() const;
+    int GetRefreshesDeferred() const;
 
     void SetShadowMapSize(int size);
-    void SetOrthoSize(float size);
-    void SetFarPlane(float farP);
+
+    /// @param lambda blend between uniform (0) and logarithmic (1) split distances
+    /// @param distance view depth past which directional lights cast no shadow
+    void SetCascades(int count, float lambda, float distance);
+
+    void SetRefreshBudget(int lightsPerFrame);
+
+    /// Drops every cached layer, e.g. after the arrays were recreated
+    void InvalidateCache();
 
 private:
     void InitializeShadowMap(int count);
     void InitializeCubeShadowMap(int count);
+    GLuint CreateShadowArray(int count, std::vector<GLuint> &fbos) const;
+    /// Creates a cube array and one layered FBO over all of it
+    GLuint CreateCubeArray(int count, GLuint &fbo) const;
+
+    /// Splits visible meshes into static and dynamic casters and records static ones that appeared, moved or vanished
+    void GatherCasters();
+    void InvalidateLayers();
+    void CopyStaticLayer(int layer) const;
+    void CopyStaticCube(int slot) const;
+    void ClearCube(GLuint texture, int slot) const;
 
-    glm::mat4 BuildLightSpaceMatrix(const glm::vec3 &lightDir) const;
+    /// Fills m_CascadeSplits and returns the camera's near and far planes
+    void ComputeCascadeSplits(const glm::mat4 &projection, float &nearPlane, float &farPlane);
+    glm::mat4 BuildCascadeMatrix(const glm::vec3 &lightDir, const std::array<glm::vec3, 8> &frustumCorners,
+                                 float cameraNear, float cameraFar, float splitNear, float splitFar) const;
     glm::mat4 BuildSpotLightMatrix(const LightComponent &light);
-    static std::vector<glm::mat4> BuildPointSpaceMatrices(const LightComponent &light);
+    static std::array<glm::mat4, 6> BuildPointSpaceMatrices(const LightComponent &light);
 };
\ No newline at end of file
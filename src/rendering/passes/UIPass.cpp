@@ -1,6 +1,7 @@
 #include "UIPass.h"
 #include <string>
 #include "core/CommandManager.h"
+#include "rendering/RenderCommands.h"
 
 UIPass::UIPass(GLContext *ctx, ShaderManager *sm)
     : RenderPass("UIPass", ctx, sm) {
@@ -19,12 +20,9 @@ void UIPass::Execute(const glm::mat4 &view, const glm::mat4 &projection) {
 
     Setup();
 
-    CommandManager::ExecuteCommand("Renderer_RenderUI",
-                                   {
-                                       view,
-                                       projection,
-                                       std::string("icon")
-                                   });
+    static const std::string shaderName = "icon";
+
+    CommandManager::Execute<RenderUICommand>({.view = view, .projection = projection, .shaderName = shaderName});
 
     Cleanup();
 }
@@ -46,6 +46,8 @@ void ForwardPipeline::Initialize() {
 
 void ForwardPipeline::Execute(ECSWorld &ecs, entt::entity cameraEntity,
                               int width, int height) {
+    gpuTimer.Collect();
+
     if (!ecs.HasComponent<CameraComponent>(cameraEntity) ||
         !ecs.HasComponent<TransformComponent>(cameraEntity) ||
         !ecs.HasComponent<CameraOrientationComponent>(cameraEntity))
@@ -65,8 +67,10 @@ void ForwardPipeline::Execute(ECSWorld &ecs, entt::entity cameraEntity,
     IsEnabled()
     )
     {
-        m_ShadowPassPtr->Execute(view, projection);
+        ExecutePass(*m_ShadowPassPtr, view, projection);
 
+        // The shadow pass leaves its own FBOs behind
+        glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
         glViewport(0, 0, width, height);
 
         m_GeometryPassPtr->SetShadowData(
@@ -76,21 +80,24 @@ void ForwardPipeline::Execute(ECSWorld &ecs, entt::entity cameraEntity,
             m_ShadowPassPtr->GetCubeShadowMapArray(),
             m_ShadowPassPtr->GetPointShadowMapIndices()
         );
+        m_GeometryPassPtr->SetCascades(m_ShadowPassPtr->GetCascadeSplits(),
+                                       m_ShadowPassPtr->GetCascadeCount());
     }
     else
     if (m_GeometryPassPtr) {
         m_GeometryPassPtr->SetShadowData({glm::mat4(1.0f)}, 0);
+        m_GeometryPassPtr->SetCascades(glm::vec4(0.0f), 0);
     }
 
     for (auto &pass: passes) {
         if (!pass || !pass->IsEnabled()) continue;
         if (pass.get() == m_ShadowPassPtr) continue;
         if (pass.get() == m_GeometryPassPtr) continue;
-        pass->Execute(view, projection);
+        ExecutePass(*pass, view, projection);
     }
 
     if (m_GeometryPassPtr && m_GeometryPassPtr->IsEnabled())
-        m_GeometryPassPtr->Execute(view, projection);
+        ExecutePass(*m_GeometryPassPtr, view, projection);
 }
 
 ShadowPass *ForwardPipeline::GetShadowPass() const {
@@ -1,5 +1,6 @@
 #include "RenderPipeline.h"
 #include <glm/glm.hpp>
+#include "core/Profiler.h"
 #include "core/logging/Logger.h"
 
 RenderPipeline::RenderPipeline(const std::string &n, GLContext *ctx, ShaderManager *sm)
@@ -8,6 +9,8 @@ RenderPipeline::RenderPipeline(const std::string &n, GLContext *ctx, ShaderManag
 }
 
 void RenderPipeline::Execute(ECSWorld &ecs, entt::entity cameraEntity, int width, int height) {
+    gpuTimer.Collect();
+
     if (ecs.HasComponent<CameraComponent>(cameraEntity) &&
         ecs.HasComponent<TransformComponent>(cameraEntity) &&
         ecs.HasComponent<CameraOrientationComponent>(cameraEntity)) {
@@ -21,7 +24,7 @@ void RenderPipeline::Execute(ECSWorld &ecs, entt::entity cameraEntity, int width
 
         for (auto &pass: passes)
             if (pass && pass->IsEnabled())
-                pass->Execute(view, projection);
+                ExecutePass(*pass, view, projection);
     } else {
         return;
     }
@@ -34,10 +37,24 @@ void RenderPipeline::AddPass(std::unique_ptr<RenderPass> pass) {
     }
 
     std::string passName = pass->GetName();
+    passTimers[pass.get()] = gpuTimer.Register(Profiler::Get().Intern(passName));
     passes.push_back(std::move(pass));
     Logger::Log(LogLevel::DEBUG, "Added pass: " + passName);
 }
 
+void RenderPipeline::SetTargetFramebuffer(GLuint fbo) {
+    targetFramebuffer = fbo;
+}
+
+void RenderPipeline::ExecutePass(RenderPass &pass, const glm::mat4 &view, const glm::mat4 &projection) {
+    const int timer = passTimers.at(&pass);
+
+    PROFILE_SCOPE(gpuTimer.GetName(timer));
+    gpuTimer.Begin(timer);
+    pass.Execute(view, projection);
+    gpuTimer.End();
+}
+
 RenderPass *RenderPipeline::GetPass(const std::string &passName) {
     for (auto &pass: passes)
         if (pass && pass->GetName() == passName)
@@ -2,12 +2,14 @@
 
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include <entt/entt.hpp>
 
 #include "rendering/passes/RenderPass.h"
 #include "rendering/core/GLContext.h"
+#include "rendering/core/GpuTimer.h"
 #include "resource/shader/ShaderManager.h"
 #include "ECS/World.h"
 #include "ECS/components/Components.h"
@@ -18,6 +20,14 @@ protected:
     std::vector<std::unique_ptr<RenderPass> > passes;
     GLContext *context;
     ShaderManager *shaderManager;
+    /// Where the scene ends up; 0 is the window's default framebuffer
+    GLuint targetFramebuffer = 0;
+
+    GpuTimer gpuTimer;
+    std::unordered_map<const RenderPass *, int> passTimers;
+
+    /// Runs one pass inside a CPU profile scope and a GPU timer named after it
+    void ExecutePass(RenderPass &pass, const glm::mat4 &view, const glm::mat4 &projection);
 
 public:
     RenderPipeline(const std::string &n, GLContext *ctx, ShaderManager *sm);
@@ -30,6 +40,8 @@ public:
 
     void AddPass(std::unique_ptr<RenderPass> pass);
 
+    void SetTargetFramebuffer(GLuint fbo);
+
     RenderPass *GetPass(const std::string &passName);
 
     const std::string &GetName() const;
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+/// @file CookedFile.h
+/// @brief Helpers shared by the cooked asset formats (models, textures)
+
+/// Size and mtime of a source asset; a cooked file records both and is stale once either changes
+struct SourceStamp {
+    int64_t time = 0;
+    uint64_t size = 0;
+
+    bool operator==(const SourceStamp &) const = default;
+};
+
+inline bool GetSourceStamp(const std::string &path, SourceStamp &stamp) {
+    std::error_code ec;
+    stamp.size = std::filesystem::file_size(path, ec);
+    if (ec)
+        return false;
+
+    const auto time = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        return false;
+
+    stamp.time = static_cast<int64_t>(time.time_since_epoch().count());
+    return true;
+}
+
+/**
+ * @brief "<directory>/<source stem>_<hash of key>.<extension>"
+ * @param key Source path plus anything else that selects a distinct cooked variant
+ */
+inline std::string GetCookedFilePath(const std::string &directory, const std::string &sourcePath,
+                                     const std::string &key, const char *extension) {
+    // FNV-1a, stable across runs and standard libraries unlike std::hash
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c: key) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+
+    return directory + "/" + std::filesystem::path(sourcePath).stem().string() + "_" + hex + extension;
+}
+
+/// Per-thread scratch name; cookers write here and rename over the real file so readers never see a torn one
+inline std::string GetCookTempPath(const std::string &cookedPath) {
+    return cookedPath + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+}
+
+class CookWriter {
+    std::ofstream &out;
+    size_t offset = 0;
+
+public:
+    explicit CookWriter(std::ofstream &stream) : out(stream) {
+    }
+
+    void Write(const void *data, size_t size) {
+        out.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+        offset += size;
+    }
+
+    template<typename T>
+    void Write(const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Write(&value, sizeof(T));
+    }
+
+    void WriteString(const std::string &value) {
+        Write(static_cast<uint32_t>(value.size()));
+        Write(value.data(), value.size());
+    }
+
+    void Align(size_t alignment) {
+        static constexpr char zeros[64] = {};
+        const size_t padding = (alignment - offset % alignment) % alignment;
+        Write(zeros, padding);
+    }
+
+    size_t GetOffset() const {
+        return offset;
+    }
+};
+
+/// Bounds-checked reads from a mapped cooked file; every failed read returns false
+class CookReader {
+    const uint8_t *data;
+    size_t size;
+    size_t offset = 0;
+
+public:
+    CookReader(const uint8_t *bytes, size_t length) : data(bytes), size(length) {
+    }
+
+    template<typename T>
+    bool Read(T &value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (size - offset < sizeof(T))
+            return false;
+
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string &value) {
+        uint32_t length = 0;
+        if (!Read(length) || size - offset < length)
+            return false;
+
+        value.assign(reinterpret_cast<const char *>(data + offset), length);
+        offset += length;
+        return true;
+    }
+
+    size_t GetRemaining() const {
+        return size - offset;
+    }
+
+    /// View @p count elements in place; the writer aligned them and mappings are page aligned
+    template<typename T>
+    bool ReadSpan(std::span<const T> &view, uint64_t count) {
+        offset = (offset + alignof(T) - 1) / alignof(T) * alignof(T);
+        if (offset > size || count > (size - offset) / sizeof(T))
+            return false;
+
+        view = std::span<const T>(reinterpret_cast<const T *>(data + offset), static_cast<size_t>(count));
+        offset += static_cast<size_t>(count) * sizeof(T);
+        return true;
+    }
+};
\ No newline at end of file
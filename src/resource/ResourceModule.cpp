@@ -1,6 +1,7 @@
 #include "ResourceModule.h"
 #include <string>
 #include "core/logging/Logger.h"
+#include "core/CommandManager.h"
 
 bool ResourceModule::Initialize() {
     Logger::Log(LogLevel::INFO, "Creating resource managers...");
@@ -21,6 +22,10 @@ bool ResourceModule::Initialize() {
         modelManager->SetMaterialManager(materialManager.get());
         Logger::Log(LogLevel::DEBUG, "  ModelManager created");
 
+        CommandManager::RegisterCommand("Textures_Benchmark", [](const CommandArgs &args) {
+            BenchmarkTextureLoading(args.empty() ? "assets/textures/rust_metal.jpg" : std::get<std::string>(args[0]));
+        });
+
         isInitialized = true;
 
         return true;
@@ -35,6 +40,11 @@ bool ResourceModule::Initialize() {
 }
 
 void ResourceModule::Update(float deltaTime) {
+    if (modelManager)
+        modelManager->Update();
+
+    if (textureManager)
+        textureManager->CollectGarbage();
 }
 
 void ResourceModule::Shutdown() {
@@ -65,6 +75,11 @@ bool ResourceModule::IsRequired() const {
     return true;
 }
 
+ModuleAccess ResourceModule::GetAccess() const {
+    // Streamed models finish here: GL uploads plus new entities and components
+    return ModuleAccess::Exclusive();
+}
+
 ModelManager *ResourceModule::GetModelManager() {
     return modelManager.get();
 }
@@ -31,6 +31,8 @@ public:
 
     bool IsRequired() const override;
 
+    ModuleAccess GetAccess() const override;
+
     /// @}
 
     ModelManager *GetModelManager();
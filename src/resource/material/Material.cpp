@@ -3,6 +3,7 @@
 #include <glad/glad.h>
 
 #include "core/logging/Logger.h"
+#include "rendering/MaterialBuffer.h"
 
 Material::Material(const std::vector<Texture> &textures, const std::string &materialName)
     : name(materialName), type("texture"), textures(textures), useColor(false), color(1.0f, 1.0f, 1.0f) {
@@ -36,51 +37,76 @@ Material &Material::operator=(Material &other) {
     this->color = other.color;
     this->textures = other.textures;
     this->useColor = other.useColor;
+    this->blockDirty = true;
 
     return *this;
 }
 
-void Material::Bind(ShaderManager &shaderManager, const std::string &shaderName) {
-    shaderManager.Bind(shaderName);
+namespace {
+    /// Unit the shader samples @p textureType from, or -1 if it has none
+    int TextureUnitFor(const std::string &textureType) {
+        if (textureType == "texture_diffuse")
+            return DIFFUSE_TEXTURE_UNIT;
+        if (textureType == "texture_specular")
+            return SPECULAR_TEXTURE_UNIT;
+        if (textureType == "texture_normal")
+            return NORMAL_TEXTURE_UNIT;
+        if (textureType == "texture_height")
+            return HEIGHT_TEXTURE_UNIT;
+        return -1;
+    }
+}
 
-    shaderManager.SetBool(shaderName, "useColor", useColor);
+void Material::Bind(ShaderManager &shaderManager, const std::string &shaderName, MaterialBuffer &materialBuffer) {
+    shaderManager.Bind(shaderName);
+    Apply(materialBuffer);
+}
 
-    if (useColor) {
-        shaderManager.SetVec3(shaderName, "material.color", color);
-    } else {
-        unsigned int diffuseNr = 1;
-        unsigned int specularNr = 1;
-        unsigned int normalNr = 1;
-        unsigned int heightNr = 1;
-
-        for (unsigned int i = 0; i < textures.size(); i++) {
-            glActiveTexture(GL_TEXTURE0 + i);
-
-            std::string number;
-            std::string texType = textures[i].type;
-
-            if (texType == "texture_diffuse")
-                number = std::to_string(diffuseNr++);
-            else if (texType == "texture_specular")
-                number = std::to_string(specularNr++);
-            else if (texType == "texture_normal")
-                number = std::to_string(normalNr++);
-            else if (texType == "texture_height")
-                number = std::to_string(heightNr++);
-
-            std::string uniformName = "material." + texType + number;
-            shaderManager.SetInt(shaderName, uniformName.c_str(), i);
-            glBindTexture(GL_TEXTURE_2D, textures[i].id);
+void Material::Apply(MaterialBuffer &materialBuffer, GLContext *context) {
+    materialBuffer.Bind(*this);
+
+    if (useColor)
+        return;
+
+    // The shader samples the first texture of each type; later ones are ignored
+    bool boundUnits[HEIGHT_TEXTURE_UNIT + 1] = {};
+    for (const auto &texture: textures) {
+        const int unit = TextureUnitFor(texture.type);
+        if (unit < 0 || boundUnits[unit])
+            continue;
+        boundUnits[unit] = true;
+
+        if (context) {
+            context->BindTexture2D(texture.id, unit);
+        } else {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            glBindTexture(GL_TEXTURE_2D, texture.id);
         }
+    }
 
+    if (!context)
         glActiveTexture(GL_TEXTURE0);
-    }
+}
+
+MaterialBlock Material::GetBlock() const {
+    MaterialBlock block;
+    block.color = glm::vec4(color, 1.0f);
+    block.useColor = useColor ? 1 : 0;
+    return block;
+}
+
+uint32_t Material::GetID() const {
+    return id;
 }
 
 void Material::Unbind() {
     if (!useColor) {
-        for (unsigned int i = 0; i < textures.size(); i++) {
-            glActiveTexture(GL_TEXTURE0 + i);
+        for (const auto &texture: textures) {
+            const int unit = TextureUnitFor(texture.type);
+            if (unit < 0)
+                continue;
+
+            glActiveTexture(GL_TEXTURE0 + unit);
             glBindTexture(GL_TEXTURE_2D, 0);
         }
         glActiveTexture(GL_TEXTURE0);
@@ -91,17 +117,20 @@ void Material::SetColor(glm::vec3 newColor) {
     color = newColor;
     useColor = true;
     textures.clear();
+    blockDirty = true;
 }
 
 void Material::SetTextures(std::vector<Texture> newTextures) {
     textures = newTextures;
     useColor = false;
+    blockDirty = true;
 }
 
 // --- split_headers: auto-generated ---
 
 void Material::SetColorUsing(bool newUsing) {
     useColor = newUsing;
+    blockDirty = true;
 }
 
 void Material::SetName(const std::string &newName) {
@@ -2,10 +2,15 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <glm/glm.hpp>
 
 #include "rendering/MeshData.h"
 #include "resource/shader/ShaderManager.h"
+#include "rendering/core/GLContext.h"
+#include "rendering/ShaderBlocks.h"
+
+class MaterialBuffer;
 
 class Material {
 private:
@@ -15,6 +20,19 @@ private:
     glm::vec3 color;
     bool useColor = false;
 
+    uint32_t id = NextID();
+
+    /// MaterialBuffer slot state: set by every parameter change, cleared on upload
+    bool blockDirty = true;
+    uint64_t blockGeneration = 0;
+
+    friend class MaterialBuffer;
+
+    static uint32_t NextID() {
+        static uint32_t counter = 1;
+        return counter++;
+    }
+
 public:
     Material(const std::vector<Texture> &textures, const std::string &materialName = "unnamed");
 
@@ -22,7 +40,18 @@ public:
 
     Material &operator=(Material &other);
 
-    void Bind(ShaderManager &shaderManager, const std::string &shaderName);
+    void Bind(ShaderManager &shaderManager, const std::string &shaderName, MaterialBuffer &materialBuffer);
+
+    /**
+     * @brief Bind the material's parameter block and textures for the already bound program
+     * @param context When given, texture binds go through its state cache
+     */
+    void Apply(MaterialBuffer &materialBuffer, GLContext *context = nullptr);
+
+    /// Parameters as laid out in the shader's MaterialBlock
+    MaterialBlock GetBlock() const;
+
+    uint32_t GetID() const;
 
     void Unbind();
 
@@ -67,52 +67,56 @@ std::shared_ptr<Material> MaterialManager::CreateTextureMaterial(const std::stri
     std::vector<Texture> textures;
 
     if (!diffusePath.empty()) {
-        unsigned int diffuseMap = textureManager->LoadTexture(diffusePath);
-        if (diffuseMap != 0) {
+        TextureRef diffuseMap = textureManager->Acquire(diffusePath);
+        if (diffuseMap.IsValid()) {
             Texture diff
             {
-                .id = diffuseMap,
+                .id = diffuseMap.GetID(),
                 .type = "texture_diffuse",
-                .path = diffusePath
+                .path = diffusePath,
+                .ref = std::move(diffuseMap)
             };
             textures.push_back(diff);
         }
     }
 
     if (!specularPath.empty()) {
-        unsigned int specularMap = textureManager->LoadTexture(specularPath);
-        if (specularMap != 0) {
+        TextureRef specularMap = textureManager->Acquire(specularPath);
+        if (specularMap.IsValid()) {
             Texture spec
             {
-                .id = specularMap,
+                .id = specularMap.GetID(),
                 .type = "texture_specular",
-                .path = specularPath
+                .path = specularPath,
+                .ref = std::move(specularMap)
             };
             textures.push_back(spec);
         }
     }
 
     if (!normalPath.empty()) {
-        unsigned int normalMap = textureManager->LoadTexture(normalPath);
-        if (normalMap != 0) {
+        TextureRef normalMap = textureManager->Acquire(normalPath);
+        if (normalMap.IsValid()) {
             Texture norm
             {
-                .id = normalMap,
+                .id = normalMap.GetID(),
                 .type = "texture_normal",
-                .path = normalPath
+                .path = normalPath,
+                .ref = std::move(normalMap)
             };
             textures.push_back(norm);
         }
     }
 
     if (!heightPath.empty()) {
-        unsigned int heightMap = textureManager->LoadTexture(heightPath);
-        if (heightMap != 0) {
+        TextureRef heightMap = textureManager->Acquire(heightPath);
+        if (heightMap.IsValid()) {
             Texture height
             {
-                .id = heightMap,
+                .id = heightMap.GetID(),
                 .type = "texture_height",
-                .path = heightPath
+                .path = heightPath,
+                .ref = std::move(heightMap)
             };
             textures.push_back(height);
         }
@@ -213,4 +217,8 @@ size_t MaterialManager::GetMaterialsCount() const {
 
 const std::unordered_map<std::string, std::shared_ptr<Material> > &MaterialManager::GetMaterialsMap() const {
     return materials;
+}
+
+TextureManager *MaterialManager::GetTextureManager() const {
+    return textureManager;
 }
\ No newline at end of file
@@ -51,6 +51,8 @@ public:
 
     const std::unordered_map<std::string, std::shared_ptr<Material> > &GetMaterialsMap() const;
 
+    TextureManager *GetTextureManager() const;
+
 private:
     void CreateDefaultMaterials();
 
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "rendering/MeshData.h"
+#include "core/MappedFile.h"
+#include "resource/texture/TextureCooker.h"
+
+/// @file ImportedModel.h
+/// @brief CPU-side result of a model import, before any GL object or entity exists
+
+struct ImportedTexture {
+    std::string path;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+
+    /// Tightly packed 8-bit rows; empty when the image failed to decode or @ref cooked is set
+    std::vector<unsigned char> pixels;
+
+    /// Mapped mip chain from the texture cache, uploaded without decoding
+    std::shared_ptr<CookedTexture> cooked;
+
+    size_t GetByteSize() const {
+        return cooked ? cooked->GetByteSize() : pixels.size();
+    }
+};
+
+struct ImportedMaterial {
+    std::string name;
+    glm::vec3 color{0.8f};
+
+    /// Use MaterialManager's "default" instead of building a material (base shapes)
+    bool useDefault = false;
+
+    /// Sampler type ("texture_diffuse", ...) and index into ImportedModel::textures
+    std::vector<std::pair<std::string, size_t> > textures;
+};
+
+struct ImportedMesh {
+    std::string nodeName;
+    glm::mat4 transform{1.0f};
+
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    ImportedMaterial material;
+
+    /// Used instead of the vectors when the mesh comes from a mapped cook file
+    std::span<const Vertex> mappedVertices;
+    std::span<const unsigned int> mappedIndices;
+
+    std::span<const Vertex> GetVertices() const {
+        return mappedVertices.empty() ? std::span<const Vertex>(vertices) : mappedVertices;
+    }
+
+    std::span<const unsigned int> GetIndices() const {
+        return mappedIndices.empty() ? std::span<const unsigned int>(indices) : mappedIndices;
+    }
+
+    size_t GetByteSize() const {
+        return GetVertices().size_bytes() + GetIndices().size_bytes();
+    }
+};
+
+struct ImportedNode {
+    std::string name;
+    glm::mat4 transform{1.0f};
+
+    std::vector<int> meshIndices;
+    std::vector<ImportedNode> children;
+};
+
+struct ImportedModel {
+    std::string path;
+    bool isBaseShape = false;
+
+    /// In node traversal order; a mesh referenced by two nodes appears twice
+    std::vector<ImportedMesh> meshes;
+    /// Deduplicated by path across all materials of the model
+    std::vector<ImportedTexture> textures;
+    ImportedNode root;
+
+    /// Keeps mapped mesh arrays alive until they are uploaded
+    std::shared_ptr<MappedFile> storage;
+};
\ No newline at end of file
@@ -31,10 +31,10 @@ const std::vector<std::shared_ptr<Mesh> > &Model::GetMeshes() const {
     return meshes;
 }
 
-void Model::Draw(ShaderManager &shaderManager, const std::string &shaderName) {
+void Model::Draw(ShaderManager &shaderManager, const std::string &shaderName, MaterialBuffer &materialBuffer) {
     for (auto &mesh: meshes)
         if (mesh)
-            mesh->Draw(shaderManager, shaderName);
+            mesh->Draw(shaderManager, shaderName, materialBuffer);
 }
 
 void Model::SetTextures(const std::vector<Texture> &textures) {
@@ -30,7 +30,7 @@ public:
     void AddMesh(Mesh &&mesh);
     void AddMesh(std::shared_ptr<Mesh> mesh);
 
-    void Draw(ShaderManager &shaderManager, const std::string &shaderName);
+    void Draw(ShaderManager &shaderManager, const std::string &shaderName, MaterialBuffer &materialBuffer);
 
     // void SetColor(const glm::vec3& color) 
     // {
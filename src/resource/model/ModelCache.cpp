@@ -0,0 +1,322 @@
+#include "ModelCache.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+#include "core/logging/Logger.h"
+#include "resource/CookedFile.h"
+#include "resource/model/ModelLoader.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr std::array<char, 4> COOKED_MAGIC = {'W', 'F', 'M', 'C'};
+    constexpr uint32_t COOKED_VERSION = 1;
+    constexpr uint32_t MAX_NODE_DEPTH = 256;
+
+    std::string s_CacheDirectory = "cache/models";
+
+    struct CookedModelHeader {
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint32_t vertexSize;
+        uint32_t importFlags;
+        uint32_t isBaseShape;
+        uint32_t meshCount;
+        uint32_t textureCount;
+        uint32_t reserved;
+        int64_t sourceTime;
+        uint64_t sourceSize;
+    };
+
+    void WriteNode(CookWriter &writer, const ImportedNode &node) {
+        writer.WriteString(node.name);
+        writer.Write(node.transform);
+
+        writer.Write(static_cast<uint32_t>(node.meshIndices.size()));
+        for (int index: node.meshIndices)
+            writer.Write(static_cast<int32_t>(index));
+
+        writer.Write(static_cast<uint32_t>(node.children.size()));
+        for (const ImportedNode &child: node.children)
+            WriteNode(writer, child);
+    }
+
+    bool ReadNode(CookReader &reader, ImportedNode &node, size_t meshCount, uint32_t depth) {
+        if (depth > MAX_NODE_DEPTH)
+            return false;
+
+        uint32_t meshIndexCount = 0;
+        if (!reader.ReadString(node.name) || !reader.Read(node.transform) || !reader.Read(meshIndexCount))
+            return false;
+
+        for (uint32_t i = 0; i < meshIndexCount; i++) {
+            int32_t index = 0;
+            if (!reader.Read(index) || index < 0 || static_cast<size_t>(index) >= meshCount)
+                return false;
+            node.meshIndices.push_back(index);
+        }
+
+        uint32_t childCount = 0;
+        if (!reader.Read(childCount))
+            return false;
+
+        for (uint32_t i = 0; i < childCount; i++) {
+            ImportedNode &child = node.children.emplace_back();
+            if (!ReadNode(reader, child, meshCount, depth + 1))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool ReadHeader(CookReader &reader, const std::string &sourcePath, bool isBaseShape,
+                    CookedModelHeader &header) {
+        SourceStamp stamp;
+        if (!GetSourceStamp(sourcePath, stamp))
+            return false;
+
+        std::string cookedSource;
+        if (!reader.Read(header) || !reader.ReadString(cookedSource))
+            return false;
+
+        return header.magic == COOKED_MAGIC &&
+               header.version == COOKED_VERSION &&
+               header.vertexSize == sizeof(Vertex) &&
+               header.importFlags == MODEL_IMPORT_FLAGS &&
+               header.isBaseShape == (isBaseShape ? 1u : 0u) &&
+               SourceStamp{header.sourceTime, header.sourceSize} == stamp &&
+               cookedSource == sourcePath;
+    }
+
+    /// Texture and mesh records each start with a string length, so larger counts cannot be genuine
+    bool CanHoldEntries(const CookReader &reader, uint32_t count) {
+        return count <= reader.GetRemaining() / sizeof(uint32_t);
+    }
+
+    bool ReadMesh(CookReader &reader, ImportedMesh &mesh, size_t textureCount) {
+        ImportedMaterial &material = mesh.material;
+
+        uint32_t useDefault = 0;
+        uint32_t textureRefCount = 0;
+        if (!reader.ReadString(mesh.nodeName) || !reader.Read(mesh.transform) ||
+            !reader.ReadString(material.name) || !reader.Read(material.color) ||
+            !reader.Read(useDefault) || !reader.Read(textureRefCount))
+            return false;
+
+        material.useDefault = useDefault != 0;
+
+        for (uint32_t i = 0; i < textureRefCount; i++) {
+            std::string type;
+            uint32_t index = 0;
+            if (!reader.ReadString(type) || !reader.Read(index) || index >= textureCount)
+                return false;
+            material.textures.emplace_back(std::move(type), index);
+        }
+
+        uint64_t vertexCount = 0;
+        uint64_t indexCount = 0;
+        return reader.Read(vertexCount) && reader.Read(indexCount) &&
+               reader.ReadSpan(mesh.mappedVertices, vertexCount) &&
+               reader.ReadSpan(mesh.mappedIndices, indexCount);
+    }
+}
+
+void SetModelCacheDirectory(const std::string &directory) {
+    s_CacheDirectory = directory;
+}
+
+const std::string &GetModelCacheDirectory() {
+    return s_CacheDirectory;
+}
+
+std::string GetCookedModelPath(const std::string &sourcePath, bool isBaseShape) {
+    return GetCookedFilePath(s_CacheDirectory, sourcePath, sourcePath + (isBaseShape ? "#base" : ""), ".wfmodel");
+}
+
+bool IsCookedModelFresh(const std::string &sourcePath, bool isBaseShape) {
+    MappedFile file;
+    if (!file.Open(GetCookedModelPath(sourcePath, isBaseShape)))
+        return false;
+
+    CookReader reader(file.GetData(), file.GetSize());
+    CookedModelHeader header{};
+    return ReadHeader(reader, sourcePath, isBaseShape, header);
+}
+
+std::unique_ptr<ImportedModel> LoadCookedModel(const std::string &sourcePath, bool isBaseShape) {
+    auto file = std::make_shared<MappedFile>();
+    if (!file->Open(GetCookedModelPath(sourcePath, isBaseShape)))
+        return nullptr;
+
+    CookReader reader(file->GetData(), file->GetSize());
+
+    CookedModelHeader header{};
+    if (!ReadHeader(reader, sourcePath, isBaseShape, header)) {
+        Logger::Log(LogLevel::DEBUG, "Cooked model is stale: " + sourcePath);
+        return nullptr;
+    }
+
+    auto model = std::make_unique<ImportedModel>();
+    model->path = sourcePath;
+    model->isBaseShape = isBaseShape;
+    model->storage = file;
+
+    bool ok = CanHoldEntries(reader, header.textureCount);
+
+    if (ok)
+        model->textures.resize(header.textureCount);
+    for (ImportedTexture &texture: model->textures) {
+        ok = ok && reader.ReadString(texture.path) &&
+             reader.Read(texture.width) && reader.Read(texture.height) && reader.Read(texture.channels);
+    }
+
+    ok = ok && CanHoldEntries(reader, header.meshCount);
+
+    if (ok)
+        model->meshes.resize(header.meshCount);
+    for (ImportedMesh &mesh: model->meshes)
+        ok = ok && ReadMesh(reader, mesh, model->textures.size());
+
+    ok = ok && ReadNode(reader, model->root, model->meshes.size(), 0);
+
+    if (!ok) {
+        Logger::Log(LogLevel::WARNING, "Cooked model is truncated or corrupt: " +
+                                       GetCookedModelPath(sourcePath, isBaseShape));
+        return nullptr;
+    }
+
+    return model;
+}
+
+bool CookModel(const ImportedModel &model) {
+    SourceStamp stamp;
+    if (!GetSourceStamp(model.path, stamp))
+        return false;
+
+    const std::string cookedPath = GetCookedModelPath(model.path, model.isBaseShape);
+
+    std::error_code ec;
+    fs::create_directories(s_CacheDirectory, ec);
+
+    // Concurrent loads of the same model each write their own file; the last rename wins
+    const std::string tempPath = GetCookTempPath(cookedPath);
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            Logger::Log(LogLevel::WARNING, "Cannot write cooked model: " + tempPath);
+            return false;
+        }
+
+        CookWriter writer(out);
+
+        CookedModelHeader header{};
+        header.magic = COOKED_MAGIC;
+        header.version = COOKED_VERSION;
+        header.vertexSize = sizeof(Vertex);
+        header.importFlags = MODEL_IMPORT_FLAGS;
+        header.isBaseShape = model.isBaseShape ? 1 : 0;
+        header.meshCount = static_cast<uint32_t>(model.meshes.size());
+        header.textureCount = static_cast<uint32_t>(model.textures.size());
+        header.sourceTime = stamp.time;
+        header.sourceSize = stamp.size;
+
+        writer.Write(header);
+        writer.WriteString(model.path);
+
+        for (const ImportedTexture &texture: model.textures) {
+            writer.WriteString(texture.path);
+            writer.Write(texture.width);
+            writer.Write(texture.height);
+            writer.Write(texture.channels);
+        }
+
+        for (const ImportedMesh &mesh: model.meshes) {
+            const ImportedMaterial &material = mesh.material;
+
+            writer.WriteString(mesh.nodeName);
+            writer.Write(mesh.transform);
+            writer.WriteString(material.name);
+            writer.Write(material.color);
+            writer.Write(static_cast<uint32_t>(material.useDefault ? 1 : 0));
+
+            writer.Write(static_cast<uint32_t>(material.textures.size()));
+            for (const auto &[type, index]: material.textures) {
+                writer.WriteString(type);
+                writer.Write(static_cast<uint32_t>(index));
+            }
+
+            const std::span<const Vertex> vertices = mesh.GetVertices();
+            const std::span<const unsigned int> indices = mesh.GetIndices();
+
+            writer.Write(static_cast<uint64_t>(vertices.size()));
+            writer.Write(static_cast<uint64_t>(indices.size()));
+            writer.Align(alignof(Vertex));
+            writer.Write(vertices.data(), vertices.size_bytes());
+            writer.Align(alignof(unsigned int));
+            writer.Write(indices.data(), indices.size_bytes());
+        }
+
+        WriteNode(writer, model.root);
+
+        if (!out) {
+            Logger::Log(LogLevel::WARNING, "Failed writing cooked model: " + tempPath);
+            out.close();
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, cookedPath, ec);
+    if (ec) {
+        Logger::Log(LogLevel::WARNING, "Cannot replace cooked model " + cookedPath + ": " + ec.message());
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    Logger::Log(LogLevel::INFO, "Cooked model: " + model.path + " -> " + cookedPath);
+    return true;
+}
+
+size_t CookModelsInDirectory(const std::string &directory) {
+    static const std::array<std::string, 6> extensions = {".obj", ".fbx", ".gltf", ".glb", ".dae", ".3ds"};
+
+    size_t cooked = 0;
+    size_t upToDate = 0;
+
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file())
+            continue;
+
+        std::string extension = it->path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        if (std::find(extensions.begin(), extensions.end(), extension) == extensions.end())
+            continue;
+
+        const std::string path = it->path().generic_string();
+        if (IsCookedModelFresh(path, false)) {
+            upToDate++;
+            continue;
+        }
+
+        std::unique_ptr<ImportedModel> model = ImportScene(path, false);
+        if (model && CookModel(*model))
+            cooked++;
+    }
+
+    if (ec)
+        Logger::Log(LogLevel::WARNING, "Cannot scan " + directory + ": " + ec.message());
+
+    Logger::Log(LogLevel::INFO,
+                "Model cook: " + std::to_string(cooked) + " cooked, " +
+                std::to_string(upToDate) + " up to date in " + directory);
+
+    return cooked;
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "resource/model/ImportedModel.h"
+
+/// @file ModelCache.h
+/// @brief Cooked models: ImportedModel meshes, nodes and material references in a binary file
+///
+/// A cooked file is keyed by source path, source size and mtime, MODEL_IMPORT_FLAGS
+/// and the format version; any mismatch makes it stale and the model is re-imported.
+
+void SetModelCacheDirectory(const std::string &directory);
+
+const std::string &GetModelCacheDirectory();
+
+std::string GetCookedModelPath(const std::string &sourcePath, bool isBaseShape);
+
+bool IsCookedModelFresh(const std::string &sourcePath, bool isBaseShape);
+
+/**
+ * @brief Map the cooked file for @p sourcePath; nullptr when missing or stale
+ *
+ * Mesh arrays point into the mapping (ImportedModel::storage), texture pixels are not decoded.
+ */
+std::unique_ptr<ImportedModel> LoadCookedModel(const std::string &sourcePath, bool isBaseShape);
+
+/// Write @p model next to the other cooked files; the file is swapped in atomically
+bool CookModel(const ImportedModel &model);
+
+/**
+ * @brief Cook every model file under @p directory whose cache entry is missing or stale
+ *
+ * Registered as the "Models_Cook" command.
+ * @return Number of models cooked
+ */
+size_t CookModelsInDirectory(const std::string &directory);
\ No newline at end of file
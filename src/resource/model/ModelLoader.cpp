@@ -1,10 +1,15 @@
 #include "ModelLoader.h"
 
+#include <algorithm>
+#include <cstdint>
+
 #include <glad/glad.h>
-#include <assimp/postprocess.h>
+#include <stb_image.h>
 
 #include "core/logging/Logger.h"
 #include "ECS/components/Components.h"
+#include "resource/model/ModelCache.h"
+#include "resource/texture/TextureManager.h"
 
 std::pair<Model *, entt::entity> LoadModelFromFile(
     std::string & path,
@@ -12,71 +17,36 @@ std::pair<Model *, entt::entity> LoadModelFromFile(
     ECSWorld * world,
     const bool isBaseShape)
 {
-    Logger::Log(LogLevel::INFO, "=== LoadModelFromFile START ===");
+    LOG_INFO(RESOURCE, "=== LoadModelFromFile START ===");
 
     std::string removePath = "../assets/objects/";
     size_t pos = path.find(removePath);
     if (pos != std::string::npos)
         path.erase(pos, removePath.length());
 
-    Logger::Log(LogLevel::INFO, "Path: " + path);
-    Logger::Log(LogLevel::INFO, "World pointer: " + std::string(world ? "OK" : "NULL"));
-    
-    Assimp::Importer importer;
-    
-    const aiScene* scene = importer.ReadFile(path, 
-        aiProcess_Triangulate | 
-        aiProcess_FlipUVs | 
-        aiProcess_CalcTangentSpace |
-        aiProcess_GenSmoothNormals
-    );
-    
-    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) 
-    {
-        Logger::Log(LogLevel::ERROR, 
-            "Assimp error: " + std::string(importer.GetErrorString()));
+    LOG_INFO(RESOURCE, "Path: {}", path);
+    LOG_INFO(RESOURCE, "World pointer: {}", world ? "OK" : "NULL");
+
+    std::unique_ptr<ImportedModel> imported = ImportModel(path, isBaseShape,
+                                                          materialManager.GetTextureManager()->GetRegistry().get());
+    if (!imported)
         return {nullptr, entt::null};
-    }
-    
-    std::string directory = path.substr(0, path.find_last_of('/'));
-    Logger::Log(LogLevel::INFO, "Directory: " + directory);
-    
-    Model* model = new Model(path);
-    
+
     entt::entity rootEntity = entt::null;
     if (world)
     {
-        Logger::Log(LogLevel::INFO, "Creating root entity...");
-        rootEntity = world->CreateEntity(model->GetName() + (!isBaseShape ? "_Root" : ""));
-        world->AddComponent<TransformComponent>(rootEntity, glm::vec3(0, 0, -5), glm::vec3(0), glm::vec3(1));
-        world->AddComponent<VisibilityComponent>(rootEntity, true);
-        world->AddComponent<HierarchyComponent>(rootEntity);
-        world->AddComponent<ModelComponent>(rootEntity, path);
-
-        Logger::Log(LogLevel::INFO, "Root entity created: " + model->GetName() + "_Root");
+        LOG_INFO(RESOURCE, "Creating root entity...");
+        rootEntity = CreateModelRoot(*world, path, isBaseShape);
     }
     else
     {
-        Logger::Log(LogLevel::WARNING, "World is NULL, skipping entity creation");
+        LOG_WARNING(RESOURCE, "World is NULL, skipping entity creation");
     }
-    
-    globalMeshCounter = 0;
-    
-    Logger::Log(LogLevel::INFO, "Starting ProcessNode...");
-
-    std::shared_ptr<ModelNode> rootNode = ProcessNode(
-        scene->mRootNode, 
-        scene, 
-        model, 
-        directory, 
-        materialManager, 
-        world, 
-        rootEntity,
-        isBaseShape
-    );
-    model->SetRootNode(rootNode);
-
-    auto children = world->GetChildren(rootEntity);
+
+    ModelBuilder builder(std::move(imported), materialManager);
+    Model *model = builder.Finish(world, rootEntity);
+
+    auto children = world ? world->GetChildren(rootEntity) : std::unordered_set<entt::entity>{};
     if (children.size() == 1)
     {
         auto it = children.begin();
@@ -92,120 +62,124 @@ std::pair<Model *, entt::entity> LoadModelFromFile(
         world->DestroyEntity(rootEntity);
         rootEntity = meshEntity;
     }
-    
-    Logger::Log(LogLevel::INFO, 
-        "Model loaded: " + path + " (" + 
-        std::to_string(model->GetMeshCount()) + " meshes)");
-    
+
+    LOG_INFO(RESOURCE, "Model loaded: {} ({} meshes)", path, model->GetMeshCount());
+
     if (world && rootEntity != entt::null)
     {
-        auto children = world->GetChildren(rootEntity);
-        Logger::Log(LogLevel::INFO, 
-            "Root entity has " + std::to_string(children.size()) + " children");
+        LOG_INFO(RESOURCE, "Root entity has {} children", world->GetChildren(rootEntity).size());
     }
-    
-    loadedTexturesCache.clear();
-    
-    Logger::Log(LogLevel::INFO, "=== LoadModelFromFile END ===\n");
-    
+
+    LOG_INFO(RESOURCE, "=== LoadModelFromFile END ===\n");
+
     return {model, rootEntity};
 }
 
-std::shared_ptr<ModelNode> ProcessNode(
-    aiNode *node,
-    const aiScene *scene,
-    Model *model,
-    const std::string &directory,
-    MaterialManager &materialManager,
-    ECSWorld *world,
-    entt::entity parentEntity,
-    bool isBaseShape)
-{
-    Logger::Log(LogLevel::INFO, "ProcessNode: " + std::string(node->mName.C_Str()));
-    Logger::Log(LogLevel::INFO, "  Meshes in this node: " + std::to_string(node->mNumMeshes));
-    Logger::Log(LogLevel::INFO, "  World: " + std::string(world ? "OK" : "NULL"));
-    Logger::Log(LogLevel::INFO, "  Parent entity valid: " + std::string(parentEntity != entt::null ? "YES" : "NO"));
+entt::entity CreateModelRoot(ECSWorld &world, const std::string &path, bool isBaseShape) {
+    const Model naming(path);
 
-    glm::mat4 transform = ConvertAssimpMatrix(node->mTransformation);
-    auto modelNode = std::make_shared<ModelNode>(
-        std::string(node->mName.C_Str()),
-        transform
-    );
+    entt::entity rootEntity = world.CreateEntity(naming.GetName() + (!isBaseShape ? "_Root" : ""));
+    world.AddComponent<TransformComponent>(rootEntity, glm::vec3(0, 0, -5), glm::vec3(0), glm::vec3(1));
+    world.AddComponent<VisibilityComponent>(rootEntity, true);
+    world.AddComponent<HierarchyComponent>(rootEntity);
+    world.AddComponent<ModelComponent>(rootEntity, path);
 
-    for (unsigned int i = 0; i < node->mNumMeshes; i++) {
-        aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
-
-        std::shared_ptr<Mesh> processedMesh = ProcessMesh(
-            mesh,
-            scene,
-            directory,
-            materialManager,
-            globalMeshCounter,
-            isBaseShape
-        );
-
-        int meshIndex = model->GetMeshCount();
-        model->AddMesh(processedMesh);
-        modelNode->meshIndices.push_back(meshIndex);
-
-        if (world && parentEntity != entt::null) {
-            std::string meshName = model->GetName() + (isBaseShape
-                                                           ? ""
-                                                           : "_" +
-                                                             std::string(node->mName.C_Str()) + "_Mesh_" +
-                                                             std::to_string(globalMeshCounter));
+    LOG_INFO(RESOURCE, "Root entity created: {}_Root", naming.GetName());
+    return rootEntity;
+}
 
-            entt::entity meshEntity = world->CreateEntity(meshName);
+std::unique_ptr<ImportedModel> ImportModel(const std::string &path, bool isBaseShape,
+                                           const TextureRegistry *resident) {
+    std::unique_ptr<ImportedModel> model = LoadCookedModel(path, isBaseShape);
 
-            glm::vec3 position, rotation, scale;
-            DecomposeTransform(transform, position, rotation, scale);
+    if (model) {
+        LOG_INFO(RESOURCE, "Using cooked model: {}", GetCookedModelPath(path, isBaseShape));
+    } else {
+        model = ImportScene(path, isBaseShape);
+        if (!model)
+            return nullptr;
 
-            world->AddComponent<TransformComponent>(meshEntity, position, rotation, scale);
-            world->AddComponent<MeshComponent>(meshEntity, processedMesh);
+        CookModel(*model);
+    }
 
-            auto meshMaterial = processedMesh->GetMaterial();
-            if (meshMaterial)
-                world->AddComponent<MaterialComponent>(meshEntity, meshMaterial);
+    for (ImportedTexture &texture: model->textures) {
+        if (texture.channels == 0)
+            continue;
+        if (resident && resident->Contains(TextureRegistry::MakeKey(texture.path, MODEL_TEXTURE_SETTINGS)))
+            continue;
 
-            world->AddComponent<VisibilityComponent>(meshEntity, true);
-            world->SetParent(meshEntity, parentEntity);
-        }
+        texture = DecodeTexture(texture.path);
+    }
+
+    return model;
+}
+
+std::unique_ptr<ImportedModel> ImportScene(const std::string &path, bool isBaseShape) {
+    Assimp::Importer importer;
+
+    const aiScene* scene = importer.ReadFile(path, MODEL_IMPORT_FLAGS);
 
-        globalMeshCounter++;
+    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) 
+    {
+        LOG_ERROR(RESOURCE, "Assimp error: {}", importer.GetErrorString());
+        return nullptr;
     }
 
-    for (unsigned int i = 0; i < node->mNumChildren; i++) {
-        std::shared_ptr<ModelNode> childNode = ProcessNode(
-            node->mChildren[i],
-            scene,
-            model,
-            directory,
-            materialManager,
-            world,
-            parentEntity,
-            isBaseShape
-        );
-
-        modelNode->AddChild(childNode);
+    std::string directory = path.substr(0, path.find_last_of('/'));
+    LOG_INFO(RESOURCE, "Directory: {}", directory);
+
+    auto model = std::make_unique<ImportedModel>();
+    model->path = path;
+    model->isBaseShape = isBaseShape;
+
+    ImportNode(scene->mRootNode, scene, *model, model->root, directory);
+
+    LOG_INFO(RESOURCE, "Imported {}: {} meshes, {} textures", path, model->meshes.size(), model->textures.size());
+
+    return model;
+}
+
+void ImportNode(
+    aiNode *node,
+    const aiScene *scene,
+    ImportedModel &model,
+    ImportedNode &importedNode,
+    const std::string &directory)
+{
+    LOG_INFO(RESOURCE, "ProcessNode: {}", node->mName.C_Str());
+    LOG_INFO(RESOURCE, "  Meshes in this node: {}", node->mNumMeshes);
+
+    importedNode.name = node->mName.C_Str();
+    importedNode.transform = ConvertAssimpMatrix(node->mTransformation);
+
+    for (unsigned int i = 0; i < node->mNumMeshes; i++) {
+        const int meshIndex = static_cast<int>(model.meshes.size());
+
+        ImportedMesh mesh = ImportMesh(scene->mMeshes[node->mMeshes[i]], scene, model, directory, meshIndex);
+        mesh.nodeName = importedNode.name;
+        mesh.transform = importedNode.transform;
+
+        model.meshes.push_back(std::move(mesh));
+        importedNode.meshIndices.push_back(meshIndex);
     }
 
-    return modelNode;
+    importedNode.children.resize(node->mNumChildren);
+    for (unsigned int i = 0; i < node->mNumChildren; i++)
+        ImportNode(node->mChildren[i], scene, model, importedNode.children[i], directory);
 }
 
-std::shared_ptr<Mesh> ProcessMesh(
+ImportedMesh ImportMesh(
     aiMesh *mesh,
     const aiScene *scene,
+    ImportedModel &model,
     const std::string &directory,
-    MaterialManager &materialManager,
-    int meshIndex,
-    bool isBaseShape)
+    int meshIndex)
 {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    std::vector<Texture> textures;
+    ImportedMesh imported;
 
-    Logger::Log(LogLevel::INFO, "=== Processing Mesh #" + std::to_string(meshIndex) + " ===");
+    LOG_INFO(RESOURCE, "=== Processing Mesh #{} ===", meshIndex);
 
+    imported.vertices.reserve(mesh->mNumVertices);
     for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
         Vertex vertex{};
         vertex.Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
@@ -221,208 +195,309 @@ std::shared_ptr<Mesh> ProcessMesh(
         vertex.Bitangent = mesh->HasTangentsAndBitangents()
                                ? glm::vec3(mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z)
                                : glm::vec3(0.0f);
-        vertices.push_back(vertex);
+        imported.vertices.push_back(vertex);
     }
-    Logger::Log(LogLevel::INFO, "Vertices processed: " + std::to_string(vertices.size()));
+    LOG_INFO(RESOURCE, "Vertices processed: {}", imported.vertices.size());
 
+    imported.indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
     for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
-        aiFace face = mesh->mFaces[i];
+        const aiFace &face = mesh->mFaces[i];
         for (unsigned int j = 0; j < face.mNumIndices; j++)
-            indices.push_back(face.mIndices[j]);
-    }
-    Logger::Log(LogLevel::INFO, "Indices processed: " + std::to_string(indices.size()));
-
-    std::shared_ptr<Material> meshMaterial;
-    Logger::Log(LogLevel::INFO, "Material index: " + std::to_string(mesh->mMaterialIndex));
-
-    if (mesh->mMaterialIndex >= 0 && !isBaseShape) {
-        aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
-
-        aiString matName;
-        material->Get(AI_MATKEY_NAME, matName);
-
-        std::string modelName = directory.substr(directory.find_last_of('/') + 1);
-        std::string materialName = modelName + "_" + std::string(matName.C_Str()) + "_mesh" + std::to_string(meshIndex);
-
-        Logger::Log(LogLevel::INFO, "Material name from model: " + std::string(matName.C_Str()));
-        Logger::Log(LogLevel::INFO, "Generated material name: " + materialName);
-
-        Logger::Log(LogLevel::INFO, "Loading DIFFUSE textures...");
-        std::vector<Texture> diffuseMaps = LoadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse",
-                                                                directory);
-        Logger::Log(LogLevel::INFO, "Found " + std::to_string(diffuseMaps.size()) + " diffuse textures");
-        textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
-
-        Logger::Log(LogLevel::INFO, "Loading SPECULAR textures...");
-        std::vector<Texture> specularMaps = LoadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular",
-                                                                 directory);
-        Logger::Log(LogLevel::INFO, "Found " + std::to_string(specularMaps.size()) + " specular textures");
-        textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
-
-        Logger::Log(LogLevel::INFO, "Loading NORMAL textures...");
-        std::vector<Texture> normalMaps = LoadMaterialTextures(material, aiTextureType_NORMALS, "texture_normal",
-                                                               directory);
-        Logger::Log(LogLevel::INFO, "Found " + std::to_string(normalMaps.size()) + " normal textures");
-        textures.insert(textures.end(), normalMaps.begin(), normalMaps.end());
-
-        Logger::Log(LogLevel::INFO, "Loading HEIGHT textures...");
-        std::vector<Texture> heightMaps = LoadMaterialTextures(material, aiTextureType_HEIGHT, "texture_height",
-                                                               directory);
-        Logger::Log(LogLevel::INFO, "Found " + std::to_string(heightMaps.size()) + " height textures");
-        textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
-
-        Logger::Log(LogLevel::INFO, "Total textures loaded: " + std::to_string(textures.size()));
-
-        if (!textures.empty()) {
-            Logger::Log(LogLevel::INFO,
-                        "Creating TEXTURE material with " + std::to_string(textures.size()) + " textures");
-            for (size_t i = 0; i < textures.size(); i++) {
-                Logger::Log(LogLevel::INFO,
-                            "  Texture " + std::to_string(i) + ": " + textures[i].path + " (ID: " +
-                            std::to_string(textures[i].id) + ", type: " + textures[i].type + ")");
-            }
-            meshMaterial = std::make_shared<Material>(textures, materialName);
-            Logger::Log(LogLevel::INFO, "Texture material created successfully");
-        } else {
-            aiColor3D color(0.8f, 0.8f, 0.8f);
-            material->Get(AI_MATKEY_COLOR_DIFFUSE, color);
-            glm::vec3 matColor(color.r, color.g, color.b);
-
-            Logger::Log(LogLevel::INFO,
-                        "No textures found. Creating COLOR material with color: (" + std::to_string(matColor.x) + ", " +
-                        std::to_string(matColor.y) + ", " + std::to_string(matColor.z) + ")");
-            meshMaterial = std::make_shared<Material>(matColor, materialName);
-            Logger::Log(LogLevel::INFO, "Color material created successfully");
-        }
-    } else if (isBaseShape) {
-        meshMaterial = materialManager.GetMaterial("default");
-    } else {
-        Logger::Log(LogLevel::WARNING, "No material index found, using default material");
-        meshMaterial = materialManager.GetMaterial("default");
+            imported.indices.push_back(face.mIndices[j]);
     }
+    LOG_INFO(RESOURCE, "Indices processed: {}", imported.indices.size());
 
-    Logger::Log(LogLevel::INFO, "Creating Mesh object...");
-    auto createdMesh = std::make_shared<Mesh>(vertices, indices, textures);
-    Logger::Log(LogLevel::INFO, "Mesh object created");
-
-    if (meshMaterial) {
-        Logger::Log(LogLevel::INFO, "Setting material to mesh...");
-        createdMesh->SetMaterial(meshMaterial);
-        if (!materialManager.HasMaterial(meshMaterial->GetName()))
-            materialManager.AddMaterial(meshMaterial);
-        Logger::Log(LogLevel::INFO,
-                    "Material successfully set to mesh! (textures: " + std::to_string(textures.size()) + ")");
-
-        auto checkMaterial = createdMesh->GetMaterial();
-        if (checkMaterial) {
-            Logger::Log(LogLevel::INFO,
-                        "Verified: Material is set (name: " + checkMaterial->GetName() + ", type: " + checkMaterial->
-                        GetType() + ", using color: " + (checkMaterial->IsUsingColor() ? "YES" : "NO") + ")");
-        } else {
-            Logger::Log(LogLevel::ERROR, "Material is NULL after SetMaterial!");
-        }
-    } else {
-        Logger::Log(LogLevel::ERROR, "MeshMaterial is NULL, cannot set material!");
+    ImportedMaterial &material = imported.material;
+
+    if (model.isBaseShape || mesh->mMaterialIndex >= scene->mNumMaterials) {
+        if (!model.isBaseShape)
+            LOG_WARNING(RESOURCE, "No material index found, using default material");
+        material.useDefault = true;
+        return imported;
     }
 
-    Logger::Log(LogLevel::INFO, "=== Mesh #" + std::to_string(meshIndex) + " processing complete ===\n");
+    aiMaterial *aiMat = scene->mMaterials[mesh->mMaterialIndex];
+
+    aiString matName;
+    aiMat->Get(AI_MATKEY_NAME, matName);
+
+    std::string modelName = directory.substr(directory.find_last_of('/') + 1);
+    material.name = modelName + "_" + std::string(matName.C_Str()) + "_mesh" + std::to_string(meshIndex);
+    LOG_INFO(RESOURCE, "Generated material name: {}", material.name);
 
-    return createdMesh;
+    ImportMaterialTextures(aiMat, aiTextureType_DIFFUSE, "texture_diffuse", directory, model, material);
+    ImportMaterialTextures(aiMat, aiTextureType_SPECULAR, "texture_specular", directory, model, material);
+    ImportMaterialTextures(aiMat, aiTextureType_NORMALS, "texture_normal", directory, model, material);
+    ImportMaterialTextures(aiMat, aiTextureType_HEIGHT, "texture_height", directory, model, material);
+
+    LOG_INFO(RESOURCE, "Total textures loaded: {}", material.textures.size());
+
+    if (material.textures.empty()) {
+        aiColor3D color(0.8f, 0.8f, 0.8f);
+        aiMat->Get(AI_MATKEY_COLOR_DIFFUSE, color);
+        material.color = glm::vec3(color.r, color.g, color.b);
+    }
+
+    return imported;
 }
 
-std::vector<Texture> LoadMaterialTextures(
+void ImportMaterialTextures(
     aiMaterial *mat,
     aiTextureType type,
     const std::string &typeName,
-    const std::string &directory) {
-    std::vector<Texture> textures;
-
+    const std::string &directory,
+    ImportedModel &model,
+    ImportedMaterial &material)
+{
     unsigned int textureCount = mat->GetTextureCount(type);
-    Logger::Log(LogLevel::DEBUG,
-                "Loading " + std::to_string(textureCount) + " textures of type: " + typeName);
+    LOG_DEBUG(RESOURCE, "Loading {} textures of type: {}", textureCount, typeName);
 
     for (unsigned int i = 0; i < textureCount; i++) {
         aiString str;
         mat->GetTexture(type, i, &str);
 
-        std::string texturePath = std::string(str.C_Str());
+        std::string fullPath = directory + "/" + std::string(str.C_Str());
 
-        bool skip = false;
-        unsigned int textureID = 0;
+        auto it = std::find_if(model.textures.begin(), model.textures.end(),
+                               [&](const ImportedTexture &texture) { return texture.path == fullPath; });
 
-        std::string fullPath = directory + "/" + texturePath;
+        size_t index = static_cast<size_t>(it - model.textures.begin());
+        if (it == model.textures.end()) {
+            // Only the header is read here; pixels are decoded after the import (or cache hit)
+            ImportedTexture texture;
+            texture.path = fullPath;
+            if (!stbi_info(fullPath.c_str(), &texture.width, &texture.height, &texture.channels))
+                LOG_ERROR(RESOURCE, "Failed to load texture: {}", fullPath);
 
-        if (loadedTexturesCache.find(fullPath) != loadedTexturesCache.end()) {
-            textureID = loadedTexturesCache[fullPath];
-            skip = true;
-            Logger::Log(LogLevel::DEBUG,
-                        "Using cached texture: " + texturePath);
+            model.textures.push_back(std::move(texture));
+        } else {
+            LOG_DEBUG(RESOURCE, "Using cached texture: {}", fullPath);
         }
 
-        if (!skip) {
-            textureID = TextureFromFile(str.C_Str(), directory);
-            if (textureID != 0) {
-                loadedTexturesCache[fullPath] = textureID;
-                Logger::Log(LogLevel::INFO,
-                            "Loaded texture: " + texturePath + " (ID: " + std::to_string(textureID) + ")");
-            }
-        }
+        // Unreadable images stay in the list so the lookup above skips them next time
+        if (model.textures[index].channels != 0)
+            material.textures.emplace_back(typeName, index);
+    }
+}
 
-        if (textureID != 0) {
-            Texture texture;
-            texture.id = textureID;
-            texture.type = typeName;
-            texture.path = fullPath;
+ImportedTexture DecodeTexture(const std::string &path) {
+    if (std::shared_ptr<CookedTexture> cooked = LoadOrCookTexture(path)) {
+        ImportedTexture texture;
+        texture.path = path;
+        texture.width = static_cast<int>(cooked->GetWidth());
+        texture.height = static_cast<int>(cooked->GetHeight());
+        texture.channels = static_cast<int>(cooked->GetChannels());
+        texture.cooked = std::move(cooked);
+        return texture;
+    }
 
-            textures.push_back(texture);
-        }
+    return DecodeImage(path);
+}
+
+ImportedTexture DecodeImage(const std::string &path) {
+    ImportedTexture texture;
+    texture.path = path;
+
+    // Per-thread flag: this runs on import workers next to TextureManager's flipped
+    // loads, and aiProcess_FlipUVs already accounts for image orientation here
+    stbi_set_flip_vertically_on_load_thread(false);
+
+    unsigned char *data = stbi_load(path.c_str(), &texture.width, &texture.height, &texture.channels, 0);
+    if (!data) {
+        LOG_ERROR(RESOURCE, "Failed to load texture: {}", path);
+        return texture;
     }
 
-    return textures;
+    texture.pixels.assign(data, data + static_cast<size_t>(texture.width) * texture.height * texture.channels);
+    stbi_image_free(data);
+
+    LOG_INFO(RESOURCE, "Texture loaded successfully: {} ({}x{}, {} channels)",
+             path, texture.width, texture.height, texture.channels);
+
+    return texture;
 }
 
-unsigned int TextureFromFile(const char *path, const std::string &directory) {
-    std::string filename = directory + '/' + std::string(path);
+unsigned int UploadTexture(const ImportedTexture &texture) {
+    if (texture.cooked) {
+        if (unsigned int textureID = UploadCookedTexture(*texture.cooked))
+            return textureID;
+
+        return UploadTexture(DecodeImage(texture.path));
+    }
+
+    if (texture.pixels.empty())
+        return 0;
+
+    GLenum format = GL_RGB;
+    if (texture.channels == 1)
+        format = GL_RED;
+    else if (texture.channels == 3)
+        format = GL_RGB;
+    else if (texture.channels == 4)
+        format = GL_RGBA;
 
     unsigned int textureID;
     glGenTextures(1, &textureID);
 
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
-
-    if (data) {
-        GLenum format = GL_RGB;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA;
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-
-        Logger::Log(LogLevel::INFO,
-                    "Texture loaded successfully: " + filename +
-                    " (" + std::to_string(width) + "x" + std::to_string(height) +
-                    ", " + std::to_string(nrComponents) + " channels)");
-    } else {
-        Logger::Log(LogLevel::ERROR, "Failed to load texture: " + filename);
-        stbi_image_free(data);
-        return 0;
-    }
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    // Rows of 1- and 3-channel images are not necessarily 4-byte aligned
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, texture.width, texture.height, 0, format, GL_UNSIGNED_BYTE,
+                 texture.pixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     return textureID;
 }
 
+ModelBuilder::ModelBuilder(std::unique_ptr<ImportedModel> model, MaterialManager &materialManager)
+    : imported(std::move(model)), materialManager(materialManager),
+      textureManager(*materialManager.GetTextureManager()) {
+    textureRefs.resize(imported->textures.size());
+    meshes.resize(imported->meshes.size());
+}
+
+size_t ModelBuilder::Upload(size_t byteBudget) {
+    size_t uploaded = 0;
+
+    while (nextTexture < imported->textures.size()) {
+        ImportedTexture &texture = imported->textures[nextTexture];
+        TextureRef &ref = textureRefs[nextTexture];
+
+        ref = textureManager.FindResident(texture.path, MODEL_TEXTURE_SETTINGS);
+        if (!ref.IsValid()) {
+            // Skipped at import because it was resident, but collected since
+            if (texture.channels != 0 && !texture.cooked && texture.pixels.empty())
+                texture = DecodeTexture(texture.path);
+
+            if (uploaded > 0 && uploaded + texture.GetByteSize() > byteBudget)
+                return uploaded;
+
+            ref = textureManager.Adopt(texture.path, MODEL_TEXTURE_SETTINGS, UploadTexture(texture),
+                                       texture.GetByteSize());
+            uploaded += texture.GetByteSize();
+        }
+
+        texture.pixels.clear();
+        texture.pixels.shrink_to_fit();
+        texture.cooked.reset();
+        nextTexture++;
+    }
+
+    while (nextMesh < imported->meshes.size()) {
+        ImportedMesh &mesh = imported->meshes[nextMesh];
+        if (uploaded > 0 && uploaded + mesh.GetByteSize() > byteBudget)
+            return uploaded;
+
+        const std::span<const Vertex> vertices = mesh.GetVertices();
+        const std::span<const unsigned int> indices = mesh.GetIndices();
+
+        uploaded += mesh.GetByteSize();
+        meshes[nextMesh] = std::make_shared<Mesh>(
+            new MeshRenderer(vertices.data(), vertices.size(), indices.data(), indices.size()), nullptr);
+
+        mesh.vertices = {};
+        mesh.indices = {};
+        mesh.mappedVertices = {};
+        mesh.mappedIndices = {};
+        nextMesh++;
+    }
+
+    return uploaded;
+}
+
+bool ModelBuilder::IsUploaded() const {
+    return nextTexture == imported->textures.size() && nextMesh == imported->meshes.size();
+}
+
+Model *ModelBuilder::Finish(ECSWorld *world, entt::entity rootEntity) {
+    if (!IsUploaded())
+        Upload(SIZE_MAX);
+
+    Model *model = new Model(imported->path);
+    const bool isBaseShape = imported->isBaseShape;
+
+    for (size_t i = 0; i < meshes.size(); i++) {
+        const ImportedMesh &source = imported->meshes[i];
+        const ImportedMaterial &sourceMaterial = source.material;
+
+        std::vector<Texture> textures;
+        for (const auto &[type, index]: sourceMaterial.textures) {
+            const TextureRef &ref = textureRefs[index];
+            if (!ref.IsValid())
+                continue;
+
+            Texture texture;
+            texture.id = ref.GetID();
+            texture.type = type;
+            texture.path = imported->textures[index].path;
+            texture.ref = ref;
+            textures.push_back(texture);
+        }
+
+        std::shared_ptr<Material> meshMaterial;
+        if (sourceMaterial.useDefault)
+            meshMaterial = materialManager.GetMaterial("default");
+        else if (!textures.empty())
+            meshMaterial = std::make_shared<Material>(textures, sourceMaterial.name);
+        else
+            meshMaterial = std::make_shared<Material>(sourceMaterial.color, sourceMaterial.name);
+
+        std::shared_ptr<Mesh> &mesh = meshes[i];
+        if (meshMaterial) {
+            mesh->SetMaterial(meshMaterial);
+            if (!materialManager.HasMaterial(meshMaterial->GetName()))
+                materialManager.AddMaterial(meshMaterial);
+        } else {
+            LOG_ERROR(RESOURCE, "MeshMaterial is NULL, cannot set material!");
+        }
+
+        model->AddMesh(mesh);
+
+        if (world && rootEntity != entt::null) {
+            std::string meshName = model->GetName() + (isBaseShape
+                                                           ? ""
+                                                           : "_" + source.nodeName + "_Mesh_" +
+                                                             std::to_string(i));
+
+            entt::entity meshEntity = world->CreateEntity(meshName);
+
+            glm::vec3 position, rotation, scale;
+            DecomposeTransform(source.transform, position, rotation, scale);
+
+            world->AddComponent<TransformComponent>(meshEntity, position, rotation, scale);
+            world->AddComponent<MeshComponent>(meshEntity, mesh);
+
+            if (meshMaterial)
+                world->AddComponent<MaterialComponent>(meshEntity, meshMaterial);
+
+            world->AddComponent<VisibilityComponent>(meshEntity, true);
+            world->SetParent(meshEntity, rootEntity);
+        }
+    }
+
+    auto buildNode = [](auto &self, const ImportedNode &node) -> std::shared_ptr<ModelNode> {
+        auto modelNode = std::make_shared<ModelNode>(node.name, node.transform);
+        modelNode->meshIndices = node.meshIndices;
+        for (const ImportedNode &child: node.children)
+            modelNode->AddChild(self(self, child));
+        return modelNode;
+    };
+    model->SetRootNode(buildNode(buildNode, imported->root));
+
+    imported->meshes.clear();
+    imported->textures.clear();
+    imported->storage.reset();
+    textureRefs.clear();
+
+    return model;
+}
+
 void DecomposeTransform(const glm::mat4 &transform,
                         glm::vec3 &position,
                         glm::vec3 &rotation,
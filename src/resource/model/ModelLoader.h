@@ -9,8 +9,10 @@
 #include <assimp/scene.h>
 #include <assimp/mesh.h>
 #include <assimp/matrix4x4.h>
+#include <assimp/postprocess.h>
 
 #include "resource/model/Model.h"
+#include "resource/model/ImportedModel.h"
 #include "resource/model/ModelNode.h"
 #include "scene/Mesh.h"
 #include "rendering/MeshData.h"
@@ -22,43 +24,109 @@
 /// @author SuperChabs
 /// @date 2026-01-28
 
-static std::unordered_map<std::string, unsigned int> loadedTexturesCache;
-static int globalMeshCounter = 0;
-
 std::pair<Model *, entt::entity> LoadModelFromFile(
     std::string & path,
     MaterialManager & materialManager,
     ECSWorld * world = nullptr,
     const bool isBaseShape = false);
 
-std::shared_ptr<ModelNode> ProcessNode(
+/// Assimp post-processing used for every import; part of the cooked model cache key
+constexpr unsigned int MODEL_IMPORT_FLAGS =
+        aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace | aiProcess_GenSmoothNormals;
+
+/// Model textures are not flipped (aiProcess_FlipUVs handles orientation), so they never share a GL texture
+/// with TextureManager's flipped material textures
+constexpr TextureSettings MODEL_TEXTURE_SETTINGS{.flipVertically = false};
+
+/// Root entity a model's mesh entities are parented to, named after the model file
+entt::entity CreateModelRoot(ECSWorld &world, const std::string &path, bool isBaseShape = false);
+
+/**
+ * @brief Load the cooked model (or run Assimp and cook it) and decode its textures
+ *
+ * Touches neither GL nor the ECS, so it is safe on a worker thread. Textures already in
+ * @p resident are left undecoded; ModelBuilder picks up the resident copy instead.
+ * Returns nullptr when Assimp rejects the file.
+ */
+std::unique_ptr<ImportedModel> ImportModel(const std::string &path, bool isBaseShape = false,
+                                           const TextureRegistry *resident = nullptr);
+
+/// Assimp import only: meshes, node tree and material references, texture pixels left empty
+std::unique_ptr<ImportedModel> ImportScene(const std::string &path, bool isBaseShape = false);
+
+void ImportNode(
     aiNode *node,
     const aiScene *scene,
-    Model *model,
-    const std::string &directory,
-    MaterialManager &materialManager,
-    ECSWorld *world = nullptr,
-    entt::entity parentEntity = entt::null,
-    bool isBaseShape = false
+    ImportedModel &model,
+    ImportedNode &importedNode,
+    const std::string &directory
 );
 
-std::shared_ptr<Mesh> ProcessMesh(
+ImportedMesh ImportMesh(
     aiMesh *mesh,
     const aiScene *scene,
+    ImportedModel &model,
     const std::string &directory,
-    MaterialManager &materialManager,
-    int meshIndex,
-    bool isBaseShape = false
+    int meshIndex
 );
 
-std::vector<Texture> LoadMaterialTextures(
+void ImportMaterialTextures(
     aiMaterial *mat,
     aiTextureType type,
     const std::string &typeName,
-    const std::string &directory
+    const std::string &directory,
+    ImportedModel &model,
+    ImportedMaterial &material
 );
 
-unsigned int TextureFromFile(const char *path, const std::string &directory);
+/// Map the cooked texture (cooking it on a miss), or decode @p path if the cache is unusable
+ImportedTexture DecodeTexture(const std::string &path);
+
+/// stb decode of the source image into ImportedTexture::pixels
+ImportedTexture DecodeImage(const std::string &path);
+
+/// Create the GL texture from the cooked mip chain or decoded pixels; returns 0 if there are none
+unsigned int UploadTexture(const ImportedTexture &texture);
+
+/**
+ * @class ModelBuilder
+ * @brief Turns an ImportedModel into GL objects, materials and entities on the main thread
+ *
+ * Upload() can be spread over several frames; Finish() creates the Model and,
+ * given a world, one entity per mesh parented to the root entity. Textures go
+ * through TextureManager's registry, so ones another model or material already
+ * uses are shared rather than uploaded again.
+ */
+class ModelBuilder {
+    std::unique_ptr<ImportedModel> imported;
+    MaterialManager &materialManager;
+    TextureManager &textureManager;
+
+    std::vector<TextureRef> textureRefs;
+    std::vector<std::shared_ptr<Mesh> > meshes;
+    size_t nextTexture = 0;
+    size_t nextMesh = 0;
+
+public:
+    ModelBuilder(std::unique_ptr<ImportedModel> model, MaterialManager &materialManager);
+
+    ModelBuilder(const ModelBuilder &) = delete;
+
+    ModelBuilder &operator=(const ModelBuilder &) = delete;
+
+    /**
+     * @brief Upload textures, then meshes, until @p byteBudget is used up
+     *
+     * At least one item is uploaded per call, so assets larger than the budget still progress.
+     * @return Bytes uploaded
+     */
+    size_t Upload(size_t byteBudget);
+
+    bool IsUploaded() const;
+
+    /// Upload whatever is left, then build materials, the Model and its entities
+    Model *Finish(ECSWorld *world, entt::entity rootEntity);
+};
 
 void DecomposeTransform(
     const glm::mat4 &transform,
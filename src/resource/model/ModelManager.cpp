@@ -1,13 +1,28 @@
 #include "ModelManager.h"
 
+#include <chrono>
+
 #include "core/logging/Logger.h"
 #include "core/CommandManager.h"
+#include "core/JobSystem.h"
+#include "ECS/components/Components.h"
+#include "resource/model/ModelCache.h"
+#include "rendering/primitive/PrimitivesFactory.h"
 
 ModelManager::ModelManager() {
     CommandManager::RegisterCommand("onModelManagerCacheCleaning",
                                     [this](const CommandArgs &) {
                                         UnloadAll();
                                     });
+
+    CommandManager::RegisterCommand("Models_Cook",
+                                    [this](const CommandArgs &args) {
+                                        // Same cwd-relative form the loaders end up passing to Assimp
+                                        std::string directory = "assets/objects";
+                                        if (!args.empty())
+                                            directory = std::get<std::string>(args[0]);
+                                        CookModelsInDirectory(directory);
+                                    });
 }
 
 ModelManager::~ModelManager() {
@@ -77,6 +92,134 @@ entt::entity ModelManager::LoadWithECS(const std::string &filepath, ECSWorld *wo
     return rootEntity;
 }
 
+std::shared_future<entt::entity> ModelManager::LoadWithECSAsync(const std::string &filepath, ECSWorld *world,
+                                                                bool isBaseShape) {
+    auto load = std::make_unique<PendingLoad>();
+    std::shared_future<entt::entity> future = load->result.get_future().share();
+
+    if (!materialManager || !world) {
+        Logger::Log(LogLevel::ERROR,
+                    "Async model load needs a MaterialManager and a world: " + filepath);
+        load->result.set_value(entt::null);
+        return future;
+    }
+
+    std::string path = assetsPath + filepath;
+    std::string removePath = "../assets/objects/";
+    size_t pos = path.find(removePath);
+    if (pos != std::string::npos)
+        path.erase(pos, removePath.length());
+
+    if (!placeholderMesh) {
+        placeholderMesh.reset(PrimitivesFactory::CreatePrimitive(PrimitiveType::CUBE));
+        placeholderMaterial = std::make_shared<Material>(glm::vec3(0.5f), "model_loading_placeholder");
+    }
+
+    load->filepath = filepath;
+    load->world = world;
+    load->rootEntity = CreateModelRoot(*world, path, isBaseShape);
+    world->AddComponent<MeshComponent>(load->rootEntity, placeholderMesh);
+    world->AddComponent<MaterialComponent>(load->rootEntity, placeholderMaterial);
+
+    auto task = std::make_shared<std::promise<std::unique_ptr<ImportedModel> > >();
+    load->import = task->get_future();
+
+    std::shared_ptr<TextureRegistry> residentTextures = materialManager->GetTextureManager()->GetRegistry();
+    // Imports take seconds; a worker-queue job could be run by the main thread helping in Wait()
+    GetJobSystem().ScheduleBackground([task, path, isBaseShape, residentTextures] {
+        std::unique_ptr<ImportedModel> imported;
+        try {
+            imported = ImportModel(path, isBaseShape, residentTextures.get());
+        } catch (const std::exception &e) {
+            Logger::Log(LogLevel::ERROR, "Exception importing " + path + ": " + std::string(e.what()));
+        }
+        task->set_value(std::move(imported));
+    });
+
+    Logger::Log(LogLevel::INFO, "Model load queued: " + path);
+
+    pendingLoads.push_back(std::move(load));
+    return future;
+}
+
+void ModelManager::Update() {
+    size_t budget = uploadBudget;
+
+    for (size_t i = 0; i < pendingLoads.size();) {
+        PendingLoad &load = *pendingLoads[i];
+
+        if (!load.builder) {
+            if (load.import.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                i++;
+                continue;
+            }
+
+            std::unique_ptr<ImportedModel> imported = load.import.get();
+            if (!imported) {
+                FailLoad(load, "import failed");
+                pendingLoads.erase(pendingLoads.begin() + i);
+                continue;
+            }
+
+            load.builder = std::make_unique<ModelBuilder>(std::move(imported), *materialManager);
+        }
+
+        if (!load.world->IsValid(load.rootEntity)) {
+            FailLoad(load, "root entity was destroyed");
+            pendingLoads.erase(pendingLoads.begin() + i);
+            continue;
+        }
+
+        if (budget > 0) {
+            const size_t uploaded = load.builder->Upload(budget);
+            budget = uploaded < budget ? budget - uploaded : 0;
+        }
+
+        if (!load.builder->IsUploaded()) {
+            i++;
+            continue;
+        }
+
+        FinishLoad(load);
+        pendingLoads.erase(pendingLoads.begin() + i);
+    }
+}
+
+void ModelManager::FinishLoad(PendingLoad &load) {
+    std::shared_ptr<Model> model(load.builder->Finish(load.world, load.rootEntity));
+
+    load.world->RemoveComponent<MeshComponent>(load.rootEntity);
+    load.world->RemoveComponent<MaterialComponent>(load.rootEntity);
+
+    loadedModels[load.filepath] = model;
+
+    Logger::Log(LogLevel::INFO,
+                "Model streamed in: " + load.filepath + " (" +
+                std::to_string(model->GetMeshCount()) + " meshes, total models: " +
+                std::to_string(loadedModels.size()) + ")");
+
+    load.result.set_value(load.rootEntity);
+}
+
+void ModelManager::FailLoad(PendingLoad &load, const std::string &reason) {
+    Logger::Log(LogLevel::ERROR, "Failed to load model: " + load.filepath + " (" + reason + ")");
+
+    load.world->DestroyEntity(load.rootEntity);
+    load.result.set_value(entt::null);
+}
+
+void ModelManager::SetUploadBudget(size_t bytes) {
+    uploadBudget = bytes;
+}
+
+size_t ModelManager::GetUploadBudget() const {
+    return uploadBudget;
+}
+
+size_t ModelManager::GetPendingLoadCount() const {
+    return pendingLoads.size();
+}
+
 std::shared_ptr<Model> ModelManager::Get(const std::string &filepath) {
     auto it = loadedModels.find(filepath);
     if (it != loadedModels.end()) {
@@ -3,6 +3,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <future>
 
 #include <entt/entt.hpp>
 
@@ -14,10 +15,31 @@
 
 class ModelManager {
 private:
+    /// A model imported on a worker and waiting for its GL upload on the main thread
+    struct PendingLoad {
+        std::string filepath;
+        ECSWorld *world = nullptr;
+        entt::entity rootEntity = entt::null;
+
+        std::future<std::unique_ptr<ImportedModel> > import;
+        std::unique_ptr<ModelBuilder> builder;
+        std::promise<entt::entity> result;
+    };
+
     std::unordered_map<std::string, std::shared_ptr<Model> > loadedModels;
     std::string assetsPath = "../assets/objects/";
     MaterialManager *materialManager = nullptr;
 
+    std::vector<std::unique_ptr<PendingLoad> > pendingLoads;
+    size_t uploadBudget = 8 * 1024 * 1024;
+
+    std::shared_ptr<Mesh> placeholderMesh;
+    std::shared_ptr<Material> placeholderMaterial;
+
+    void FinishLoad(PendingLoad &load);
+
+    void FailLoad(PendingLoad &load, const std::string &reason);
+
 public:
     ModelManager();
 
@@ -29,6 +51,26 @@ public:
 
     entt::entity LoadWithECS(const std::string &filepath, ECSWorld *world, bool isBaseShape = false);
 
+    /**
+     * @brief Import on the job system and build the entities over the next frames
+     *
+     * The root entity exists immediately and shows a placeholder cube until the
+     * meshes are uploaded. The future resolves to that root entity, or entt::null
+     * if the import failed or the root was destroyed meanwhile.
+     */
+    std::shared_future<entt::entity> LoadWithECSAsync(const std::string &filepath, ECSWorld *world,
+                                                      bool isBaseShape = false);
+
+    /// Upload finished imports within the per-frame budget; main thread only
+    void Update();
+
+    /// GPU bytes Update() may upload per call; at least one texture or mesh always goes through
+    void SetUploadBudget(size_t bytes);
+
+    size_t GetUploadBudget() const;
+
+    size_t GetPendingLoadCount() const;
+
     std::shared_ptr<Model> Get(const std::string &filepath);
 
     void Unload(const std::string &filepath);
@@ -1,6 +1,7 @@
 #include "ShaderManager.h"
 
 #include <vector>
+#include <algorithm>
 
 #include "core/logging/Logger.h"
 #include "ShaderCompiler.h"
@@ -35,6 +36,7 @@ void ShaderManager::Load() {
         auto shader = std::make_unique<ShaderObj>();
         shader->ID = glID;
         shader->name = config.name;
+        BuildUniformCache(*shader);
 
         ShaderObj *shaderPtr = shader.get();
         shaders[config.name] = std::move(shader);
@@ -85,6 +87,7 @@ bool ShaderManager::Reload(const std::string &name) {
     glDeleteProgram(oldID);
 
     oldShader->ID = newID;
+    BuildUniformCache(*oldShader);
 
     if (currentShader == oldID) {
         glUseProgram(newID);
@@ -132,6 +135,7 @@ void ShaderManager::ReloadAll() {
         glDeleteProgram(oldID);
 
         oldShader->ID = newID;
+        BuildUniformCache(*oldShader);
 
         if (currentShader == oldID) {
             glUseProgram(newID);
@@ -183,47 +187,179 @@ void ShaderManager::ClearAll() {
 void ShaderManager::SetBool(const std::string &shaderName, const std::string &variableName, bool v) const {
     ShaderObj *shader = GetShader(shaderName);
     if (shader && shader->IsValid())
-        glUniform1i(glGetUniformLocation(shader->ID, variableName.c_str()), (int) v);
+        glUniform1i(GetUniformLocation(*shader, variableName), (int) v);
 }
 
 void ShaderManager::SetInt(const std::string &shaderName, const std::string &variableName, int v) const {
     ShaderObj *shader = GetShader(shaderName);
     if (shader && shader->IsValid())
-        glUniform1i(glGetUniformLocation(shader->ID, variableName.c_str()), v);
+        glUniform1i(GetUniformLocation(*shader, variableName), v);
 }
 
 void ShaderManager::SetFloat(const std::string &shaderName, const std::string &variableName, float v) const {
     ShaderObj *shader = GetShader(shaderName);
     if (shader && shader->IsValid())
-        glUniform1f(glGetUniformLocation(shader->ID, variableName.c_str()), v);
+        glUniform1f(GetUniformLocation(*shader, variableName), v);
 }
 
 void ShaderManager::SetVec2(const std::string &shaderName, const std::string &variableName, const glm::vec2 &v) const {
     ShaderObj *shader = GetShader(shaderName);
     if (shader && shader->IsValid())
-        glUniform2fv(glGetUniformLocation(shader->ID, variableName.c_str()), 1, &v[0]);
+        glUniform2fv(GetUniformLocation(*shader, variableName), 1, &v[0]);
 }
 
 void ShaderManager::SetVec3(const std::string &shaderName, const std::string &variableName, const glm::vec3 &v) const {
     ShaderObj *shader = GetShader(shaderName);
     if (shader && shader->IsValid())
-        glUniform3fv(glGetUniformLocation(shader->ID, variableName.c_str()), 1, &v[0]);
+        glUniform3fv(GetUniformLocation(*shader, variableName), 1, &v[0]);
 }
 
 void ShaderManager::SetVec4(const std::string &shaderName, const std::string &variableName, const glm::vec4 &v) const {
     ShaderObj *shader = GetShader(shaderName);
     if (shader && shader->IsValid())
-        glUniform4fv(glGetUniformLocation(shader->ID, variableName.c_str()), 1, &v[0]);
+        glUniform4fv(GetUniformLocation(*shader, variableName), 1, &v[0]);
 }
 
 void ShaderManager::SetMat4(const std::string &shaderName, const std::string &variableName, const glm::mat4 &m) const {
     ShaderObj *shader = GetShader(shaderName);
     if (shader && shader->IsValid())
         glUniformMatrix4fv(
-            glGetUniformLocation(shader->ID, variableName.c_str()),
+            GetUniformLocation(*shader, variableName),
             1, GL_FALSE, &m[0][0]);
 }
 
+UniformHandle ShaderManager::GetUniformHandle(const std::string &shaderName, const std::string &variableName) {
+    ShaderObj *shader = GetShader(shaderName);
+    if (!shader || !shader->IsValid())
+        return {};
+
+    auto it = shader->handleSlots.find(variableName);
+    if (it != shader->handleSlots.end())
+        return {shader, it->second};
+
+    auto slot = static_cast<uint32_t>(shader->handleNames.size());
+    shader->handleNames.push_back(variableName);
+    shader->handleLocations.push_back(GetUniformLocation(*shader, variableName));
+    shader->handleSlots.emplace(variableName, slot);
+
+    return {shader, slot};
+}
+
+void ShaderManager::SetBool(UniformHandle handle, bool v) const {
+    if (!handle.IsValid()) return;
+    cacheStats.handleUploads++;
+    glUniform1i(handle.shader->handleLocations[handle.slot], (int) v);
+}
+
+void ShaderManager::SetInt(UniformHandle handle, int v) const {
+    if (!handle.IsValid()) return;
+    cacheStats.handleUploads++;
+    glUniform1i(handle.shader->handleLocations[handle.slot], v);
+}
+
+void ShaderManager::SetFloat(UniformHandle handle, float v) const {
+    if (!handle.IsValid()) return;
+    cacheStats.handleUploads++;
+    glUniform1f(handle.shader->handleLocations[handle.slot], v);
+}
+
+void ShaderManager::SetVec2(UniformHandle handle, const glm::vec2 &v) const {
+    if (!handle.IsValid()) return;
+    cacheStats.handleUploads++;
+    glUniform2fv(handle.shader->handleLocations[handle.slot], 1, &v[0]);
+}
+
+void ShaderManager::SetVec3(UniformHandle handle, const glm::vec3 &v) const {
+    if (!handle.IsValid()) return;
+    cacheStats.handleUploads++;
+    glUniform3fv(handle.shader->handleLocations[handle.slot], 1, &v[0]);
+}
+
+void ShaderManager::SetVec4(UniformHandle handle, const glm::vec4 &v) const {
+    if (!handle.IsValid()) return;
+    cacheStats.handleUploads++;
+    glUniform4fv(handle.shader->handleLocations[handle.slot], 1, &v[0]);
+}
+
+void ShaderManager::SetMat4(UniformHandle handle, const glm::mat4 &m) const {
+    if (!handle.IsValid()) return;
+    cacheStats.handleUploads++;
+    glUniformMatrix4fv(handle.shader->handleLocations[handle.slot], 1, GL_FALSE, &m[0][0]);
+}
+
+void ShaderManager::SetMat4Array(UniformHandle handle, const glm::mat4 *m, GLsizei count) const {
+    if (!handle.IsValid() || count <= 0) return;
+    cacheStats.handleUploads++;
+    glUniformMatrix4fv(handle.shader->handleLocations[handle.slot], count, GL_FALSE, &m[0][0][0]);
+}
+
+const UniformCacheStats &ShaderManager::GetUniformCacheStats() const {
+    return cacheStats;
+}
+
+void ShaderManager::ResetUniformCacheStats() {
+    cacheStats.Reset();
+}
+
+void ShaderManager::BuildUniformCache(ShaderObj &shader) const {
+    shader.uniformLocations.clear();
+
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(shader.ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(shader.ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<char> buffer(std::max(maxLength, 1));
+
+    for (GLint i = 0; i < count; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(shader.ID, static_cast<GLuint>(i), maxLength, &length, &size, &type, buffer.data());
+
+        std::string uniformName(buffer.data(), length);
+        GLint location = glGetUniformLocation(shader.ID, uniformName.c_str());
+        if (location < 0)
+            continue; // uniform block member
+
+        shader.uniformLocations[uniformName] = location;
+
+        if (size > 1 && uniformName.ends_with("[0]")) {
+            std::string base = uniformName.substr(0, uniformName.size() - 3);
+            shader.uniformLocations[base] = location;
+
+            for (GLint e = 1; e < size; e++) {
+                std::string element = base + "[" + std::to_string(e) + "]";
+                shader.uniformLocations[element] = glGetUniformLocation(shader.ID, element.c_str());
+            }
+        }
+    }
+
+    for (size_t slot = 0; slot < shader.handleNames.size(); slot++) {
+        const std::string &handleName = shader.handleNames[slot];
+        auto it = shader.uniformLocations.find(handleName);
+        shader.handleLocations[slot] = it != shader.uniformLocations.end()
+                                           ? it->second
+                                           : glGetUniformLocation(shader.ID, handleName.c_str());
+    }
+
+    Logger::Log(LogLevel::DEBUG, "Shader '" + shader.name + "': cached " +
+                                 std::to_string(shader.uniformLocations.size()) + " uniform locations");
+}
+
+GLint ShaderManager::GetUniformLocation(ShaderObj &shader, const std::string &variableName) const {
+    auto it = shader.uniformLocations.find(variableName);
+    if (it != shader.uniformLocations.end()) {
+        cacheStats.hits++;
+        return it->second;
+    }
+
+    cacheStats.misses++;
+    GLint location = glGetUniformLocation(shader.ID, variableName.c_str());
+    shader.uniformLocations.emplace(variableName, location);
+    return location;
+}
+
 ShaderObj *ShaderManager::GetShader(const std::string &name) const {
     auto it = shaders.find(name);
     if (it != shaders.end())
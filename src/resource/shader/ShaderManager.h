@@ -2,6 +2,8 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <cstdint>
 #include <unordered_map>
 
 #include <glad/glad.h>
@@ -14,6 +16,15 @@ struct ShaderObj {
     GLuint ID;
     std::string name;
 
+    /// Every active uniform of the linked program, filled from GL_ACTIVE_UNIFORMS.
+    /// Array uniforms are stored both as "name" and as each "name[i]" element.
+    std::unordered_map<std::string, GLint> uniformLocations;
+
+    /// Uniforms requested through UniformHandle; re-resolved after every relink
+    std::vector<std::string> handleNames;
+    std::vector<GLint> handleLocations;
+    std::unordered_map<std::string, uint32_t> handleSlots;
+
     bool IsValid() const { return ID != 0; }
 
     bool operator ==(const ShaderObj &other) const {
@@ -21,6 +32,31 @@ struct ShaderObj {
     }
 };
 
+/**
+ * @brief Pre-resolved uniform location
+ *
+ * Resolve once with ShaderManager::GetUniformHandle and reuse every frame.
+ * Stays valid across Reload/ReloadAll, invalidated by UnLoad/ClearAll.
+ */
+struct UniformHandle {
+    ShaderObj *shader = nullptr;
+    uint32_t slot = 0;
+
+    bool IsValid() const { return shader != nullptr; }
+};
+
+struct UniformCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t handleUploads = 0;
+
+    void Reset() {
+        hits = 0;
+        misses = 0;
+        handleUploads = 0;
+    }
+};
+
 class ShaderManager {
     ShaderConfigLoader scl;
     ShaderSource source;
@@ -34,6 +70,8 @@ class ShaderManager {
 
     GLuint currentShader = 0;
 
+    mutable UniformCacheStats cacheStats;
+
 public:
     ~ShaderManager();
 
@@ -65,6 +103,32 @@ public:
 
     void SetMat4(const std::string &shaderName, const std::string &variableName, const glm::mat4 &m) const;
 
+    /// @name Handle based uniform API (no string work on the hot path)
+    /// @{
+    UniformHandle GetUniformHandle(const std::string &shaderName, const std::string &variableName);
+
+    void SetBool(UniformHandle handle, bool v) const;
+
+    void SetInt(UniformHandle handle, int v) const;
+
+    void SetFloat(UniformHandle handle, float v) const;
+
+    void SetVec2(UniformHandle handle, const glm::vec2 &v) const;
+
+    void SetVec3(UniformHandle handle, const glm::vec3 &v) const;
+
+    void SetVec4(UniformHandle handle, const glm::vec4 &v) const;
+
+    void SetMat4(UniformHandle handle, const glm::mat4 &m) const;
+
+    void SetMat4Array(UniformHandle handle, const glm::mat4 *m, GLsizei count) const;
+
+    /// @}
+
+    const UniformCacheStats &GetUniformCacheStats() const;
+
+    void ResetUniformCacheStats();
+
     ShaderObj *GetShader(const std::string &name) const;
 
     GLuint GetCurrentShader();
@@ -76,4 +140,9 @@ public:
 
 
     bool IsShaderValid(const std::string &name) const;
+
+private:
+    void BuildUniformCache(ShaderObj &shader) const;
+
+    GLint GetUniformLocation(ShaderObj &shader, const std::string &variableName) const;
 };
\ No newline at end of file
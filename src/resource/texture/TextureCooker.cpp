@@ -0,0 +1,472 @@
+#include "TextureCooker.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#include <stb_image.h>
+
+#include "core/logging/Logger.h"
+#include "resource/CookedFile.h"
+
+namespace {
+    constexpr std::array<char, 4> COOKED_MAGIC = {'W', 'F', 'T', 'X'};
+    constexpr uint32_t COOKED_VERSION = 1;
+    constexpr uint32_t FLAG_FLIPPED = 1u << 0;
+    constexpr size_t LEVEL_ALIGNMENT = 16;
+    constexpr uint32_t MAX_LEVELS = 32;
+
+    std::string s_CacheDirectory = "cache/textures";
+
+    struct CookedTextureHeader {
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint32_t format;
+        uint32_t flags;
+        uint32_t width;
+        uint32_t height;
+        uint32_t channels;
+        uint32_t levelCount;
+        int64_t sourceTime;
+        uint64_t sourceSize;
+    };
+
+    struct CookedLevelEntry {
+        uint32_t width;
+        uint32_t height;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    struct Image {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t channels = 0;
+        std::vector<uint8_t> pixels;
+    };
+
+    bool IsBlockFormat(CookedTextureFormat format) {
+        return format == CookedTextureFormat::BC1 ||
+               format == CookedTextureFormat::BC3 ||
+               format == CookedTextureFormat::BC5;
+    }
+
+    /// 2x2 box filter; odd edges reuse the last row/column
+    Image Downsample(const Image &src) {
+        Image dst;
+        dst.width = std::max(1u, src.width / 2);
+        dst.height = std::max(1u, src.height / 2);
+        dst.channels = src.channels;
+        dst.pixels.resize(static_cast<size_t>(dst.width) * dst.height * dst.channels);
+
+        for (uint32_t y = 0; y < dst.height; y++) {
+            const uint32_t y0 = std::min(y * 2, src.height - 1);
+            const uint32_t y1 = std::min(y * 2 + 1, src.height - 1);
+
+            for (uint32_t x = 0; x < dst.width; x++) {
+                const uint32_t x0 = std::min(x * 2, src.width - 1);
+                const uint32_t x1 = std::min(x * 2 + 1, src.width - 1);
+
+                for (uint32_t c = 0; c < src.channels; c++) {
+                    auto at = [&](uint32_t px, uint32_t py) -> uint32_t {
+                        return src.pixels[(static_cast<size_t>(py) * src.width + px) * src.channels + c];
+                    };
+
+                    const uint32_t sum = at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1);
+                    dst.pixels[(static_cast<size_t>(y) * dst.width + x) * dst.channels + c] =
+                            static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+
+        return dst;
+    }
+
+    /// @name BC encoders: bounding-box endpoints, nearest palette entry per texel
+    /// @{
+    uint16_t PackRGB565(const uint8_t *rgb) {
+        return static_cast<uint16_t>(((rgb[0] * 31 + 127) / 255) << 11 |
+                                     ((rgb[1] * 63 + 127) / 255) << 5 |
+                                     ((rgb[2] * 31 + 127) / 255));
+    }
+
+    void UnpackRGB565(uint16_t packed, int *rgb) {
+        const int r = (packed >> 11) & 31;
+        const int g = (packed >> 5) & 63;
+        const int b = packed & 31;
+        rgb[0] = (r << 3) | (r >> 2);
+        rgb[1] = (g << 2) | (g >> 4);
+        rgb[2] = (b << 3) | (b >> 2);
+    }
+
+    /// @p block holds 16 RGBA texels; writes 8 bytes
+    void EncodeBC1(const uint8_t *block, uint8_t *out) {
+        uint8_t minColor[3] = {255, 255, 255};
+        uint8_t maxColor[3] = {0, 0, 0};
+        for (int i = 0; i < 16; i++) {
+            for (int c = 0; c < 3; c++) {
+                minColor[c] = std::min(minColor[c], block[i * 4 + c]);
+                maxColor[c] = std::max(maxColor[c], block[i * 4 + c]);
+            }
+        }
+
+        uint16_t color0 = PackRGB565(maxColor);
+        uint16_t color1 = PackRGB565(minColor);
+        // color0 > color1 selects the four-colour mode
+        if (color0 < color1)
+            std::swap(color0, color1);
+
+        int palette[4][3];
+        UnpackRGB565(color0, palette[0]);
+        UnpackRGB565(color1, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        uint32_t indices = 0;
+        if (color0 != color1) {
+            for (int i = 0; i < 16; i++) {
+                int best = 0;
+                int bestDistance = INT32_MAX;
+                for (int p = 0; p < 4; p++) {
+                    int distance = 0;
+                    for (int c = 0; c < 3; c++) {
+                        const int d = block[i * 4 + c] - palette[p][c];
+                        distance += d * d;
+                    }
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        best = p;
+                    }
+                }
+                indices |= static_cast<uint32_t>(best) << (i * 2);
+            }
+        }
+
+        out[0] = static_cast<uint8_t>(color0);
+        out[1] = static_cast<uint8_t>(color0 >> 8);
+        out[2] = static_cast<uint8_t>(color1);
+        out[3] = static_cast<uint8_t>(color1 >> 8);
+        for (int i = 0; i < 4; i++)
+            out[4 + i] = static_cast<uint8_t>(indices >> (i * 8));
+    }
+
+    /// Single-channel block (BC4 layout, also BC3 alpha and BC5 halves); writes 8 bytes
+    void EncodeBC4(const uint8_t *block, int channel, uint8_t *out) {
+        uint8_t minValue = 255;
+        uint8_t maxValue = 0;
+        for (int i = 0; i < 16; i++) {
+            minValue = std::min(minValue, block[i * 4 + channel]);
+            maxValue = std::max(maxValue, block[i * 4 + channel]);
+        }
+
+        // value0 > value1 selects the eight-value mode
+        int palette[8];
+        palette[0] = maxValue;
+        palette[1] = minValue;
+        for (int i = 1; i <= 6; i++)
+            palette[i + 1] = ((7 - i) * maxValue + i * minValue) / 7;
+
+        uint64_t indices = 0;
+        if (maxValue != minValue) {
+            for (int i = 0; i < 16; i++) {
+                int best = 0;
+                int bestDistance = INT32_MAX;
+                for (int p = 0; p < 8; p++) {
+                    const int distance = std::abs(block[i * 4 + channel] - palette[p]);
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        best = p;
+                    }
+                }
+                indices |= static_cast<uint64_t>(best) << (i * 3);
+            }
+        }
+
+        out[0] = maxValue;
+        out[1] = minValue;
+        for (int i = 0; i < 6; i++)
+            out[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+    }
+
+    /// @p image must be RGBA
+    std::vector<uint8_t> CompressLevel(const Image &image, CookedTextureFormat format) {
+        const uint32_t blocksX = (image.width + 3) / 4;
+        const uint32_t blocksY = (image.height + 3) / 4;
+        const size_t blockSize = format == CookedTextureFormat::BC1 ? 8 : 16;
+
+        std::vector<uint8_t> out(static_cast<size_t>(blocksX) * blocksY * blockSize);
+        uint8_t block[16 * 4];
+
+        for (uint32_t by = 0; by < blocksY; by++) {
+            for (uint32_t bx = 0; bx < blocksX; bx++) {
+                for (uint32_t y = 0; y < 4; y++) {
+                    const uint32_t py = std::min(by * 4 + y, image.height - 1);
+                    for (uint32_t x = 0; x < 4; x++) {
+                        const uint32_t px = std::min(bx * 4 + x, image.width - 1);
+                        std::copy_n(&image.pixels[(static_cast<size_t>(py) * image.width + px) * 4], 4,
+                                    &block[(y * 4 + x) * 4]);
+                    }
+                }
+
+                uint8_t *dst = &out[(static_cast<size_t>(by) * blocksX + bx) * blockSize];
+                switch (format) {
+                    case CookedTextureFormat::BC1:
+                        EncodeBC1(block, dst);
+                        break;
+                    case CookedTextureFormat::BC3:
+                        EncodeBC4(block, 3, dst);
+                        EncodeBC1(block, dst + 8);
+                        break;
+                    case CookedTextureFormat::BC5:
+                        EncodeBC4(block, 0, dst);
+                        EncodeBC4(block, 1, dst + 8);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        return out;
+    }
+    /// @}
+
+    CookedTextureFormat PickFormat(const Image &image, uint32_t sourceChannels, TextureCompression compression) {
+        switch (compression) {
+            case TextureCompression::BC5:
+                return CookedTextureFormat::BC5;
+            case TextureCompression::Auto: {
+                bool opaque = true;
+                for (size_t i = 3; i < image.pixels.size() && opaque; i += 4)
+                    opaque = image.pixels[i] == 255;
+                return opaque ? CookedTextureFormat::BC1 : CookedTextureFormat::BC3;
+            }
+            case TextureCompression::None:
+            default:
+                break;
+        }
+
+        switch (sourceChannels) {
+            case 1:
+                return CookedTextureFormat::R8;
+            case 2:
+                return CookedTextureFormat::RG8;
+            case 3:
+                return CookedTextureFormat::RGB8;
+            default:
+                return CookedTextureFormat::RGBA8;
+        }
+    }
+}
+
+bool CookedTexture::Open(const std::string &cookedPath, const std::string &source,
+                         const TextureCookOptions &options) {
+    levels.clear();
+
+    SourceStamp stamp;
+    if (!GetSourceStamp(source, stamp) || !file.Open(cookedPath))
+        return false;
+
+    CookReader reader(file.GetData(), file.GetSize());
+
+    CookedTextureHeader header{};
+    std::string cookedSource;
+    if (!reader.Read(header) || !reader.ReadString(cookedSource))
+        return false;
+
+    const bool valid = header.magic == COOKED_MAGIC &&
+                       header.version == COOKED_VERSION &&
+                       header.format <= static_cast<uint32_t>(CookedTextureFormat::BC5) &&
+                       ((header.flags & FLAG_FLIPPED) != 0) == options.flipVertically &&
+                       SourceStamp{header.sourceTime, header.sourceSize} == stamp &&
+                       header.levelCount > 0 && header.levelCount <= MAX_LEVELS &&
+                       cookedSource == source;
+    if (!valid) {
+        file.Close();
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header.levelCount; i++) {
+        CookedLevelEntry entry{};
+        if (!reader.Read(entry) || entry.offset > file.GetSize() || entry.size > file.GetSize() - entry.offset) {
+            Logger::Log(LogLevel::WARNING, "Cooked texture is truncated or corrupt: " + cookedPath);
+            levels.clear();
+            file.Close();
+            return false;
+        }
+
+        levels.push_back({entry.width, entry.height, file.GetData() + entry.offset, static_cast<size_t>(entry.size)});
+    }
+
+    sourcePath = source;
+    format = static_cast<CookedTextureFormat>(header.format);
+    channels = header.channels;
+    return true;
+}
+
+CookedTextureFormat CookedTexture::GetFormat() const {
+    return format;
+}
+
+bool CookedTexture::IsCompressed() const {
+    return IsBlockFormat(format);
+}
+
+uint32_t CookedTexture::GetChannels() const {
+    return channels;
+}
+
+uint32_t CookedTexture::GetWidth() const {
+    return levels.empty() ? 0 : levels.front().width;
+}
+
+uint32_t CookedTexture::GetHeight() const {
+    return levels.empty() ? 0 : levels.front().height;
+}
+
+const std::vector<CookedMipLevel> &CookedTexture::GetLevels() const {
+    return levels;
+}
+
+size_t CookedTexture::GetByteSize() const {
+    size_t total = 0;
+    for (const CookedMipLevel &level: levels)
+        total += level.size;
+    return total;
+}
+
+const std::string &CookedTexture::GetSourcePath() const {
+    return sourcePath;
+}
+
+void SetTextureCacheDirectory(const std::string &directory) {
+    s_CacheDirectory = directory;
+}
+
+const std::string &GetTextureCacheDirectory() {
+    return s_CacheDirectory;
+}
+
+std::string GetCookedTexturePath(const std::string &sourcePath, const TextureCookOptions &options) {
+    return GetCookedFilePath(s_CacheDirectory, sourcePath,
+                             sourcePath + (options.flipVertically ? "#flip" : ""), ".wftex");
+}
+
+bool CookTexture(const std::string &sourcePath, const std::string &cookedPath, const TextureCookOptions &options) {
+    SourceStamp stamp;
+    if (!GetSourceStamp(sourcePath, stamp))
+        return false;
+
+    const bool compress = options.compression != TextureCompression::None;
+
+    stbi_set_flip_vertically_on_load_thread(options.flipVertically);
+
+    int width = 0, height = 0, sourceChannels = 0;
+    // Block encoders work on RGBA; uncompressed levels keep the source layout
+    unsigned char *data = stbi_load(sourcePath.c_str(), &width, &height, &sourceChannels, compress ? 4 : 0);
+    if (!data) {
+        Logger::Log(LogLevel::ERROR, "Texture failed to load at path: " + sourcePath);
+        return false;
+    }
+
+    Image image;
+    image.width = static_cast<uint32_t>(width);
+    image.height = static_cast<uint32_t>(height);
+    image.channels = compress ? 4u : static_cast<uint32_t>(sourceChannels);
+    image.pixels.assign(data, data + static_cast<size_t>(width) * height * image.channels);
+    stbi_image_free(data);
+
+    const CookedTextureFormat format = PickFormat(image, static_cast<uint32_t>(sourceChannels), options.compression);
+
+    std::vector<Image> chain;
+    chain.push_back(std::move(image));
+    while (chain.back().width > 1 || chain.back().height > 1)
+        chain.push_back(Downsample(chain.back()));
+
+    std::vector<std::vector<uint8_t> > payloads;
+    for (Image &level: chain) {
+        if (IsBlockFormat(format))
+            payloads.push_back(CompressLevel(level, format));
+        else
+            payloads.push_back(std::move(level.pixels));
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(cookedPath).parent_path(), ec);
+
+    const std::string tempPath = GetCookTempPath(cookedPath);
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            Logger::Log(LogLevel::WARNING, "Cannot write cooked texture: " + tempPath);
+            return false;
+        }
+
+        CookWriter writer(out);
+
+        CookedTextureHeader header{};
+        header.magic = COOKED_MAGIC;
+        header.version = COOKED_VERSION;
+        header.format = static_cast<uint32_t>(format);
+        header.flags = options.flipVertically ? FLAG_FLIPPED : 0;
+        header.width = chain.front().width;
+        header.height = chain.front().height;
+        header.channels = static_cast<uint32_t>(sourceChannels);
+        header.levelCount = static_cast<uint32_t>(chain.size());
+        header.sourceTime = stamp.time;
+        header.sourceSize = stamp.size;
+
+        writer.Write(header);
+        writer.WriteString(sourcePath);
+
+        // Offsets are absolute; level data starts after the table, each level 16-byte aligned
+        uint64_t offset = writer.GetOffset() + chain.size() * sizeof(CookedLevelEntry);
+        for (size_t i = 0; i < chain.size(); i++) {
+            offset = (offset + LEVEL_ALIGNMENT - 1) / LEVEL_ALIGNMENT * LEVEL_ALIGNMENT;
+            writer.Write(CookedLevelEntry{chain[i].width, chain[i].height, offset, payloads[i].size()});
+            offset += payloads[i].size();
+        }
+
+        for (const std::vector<uint8_t> &payload: payloads) {
+            writer.Align(LEVEL_ALIGNMENT);
+            writer.Write(payload.data(), payload.size());
+        }
+
+        if (!out) {
+            Logger::Log(LogLevel::WARNING, "Failed writing cooked texture: " + tempPath);
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, cookedPath, ec);
+    if (ec) {
+        Logger::Log(LogLevel::WARNING, "Cannot replace cooked texture " + cookedPath + ": " + ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    Logger::Log(LogLevel::INFO,
+                "Cooked texture: " + sourcePath + " -> " + cookedPath + " (" +
+                std::to_string(chain.size()) + " levels" + (IsBlockFormat(format) ? ", block compressed)" : ")"));
+    return true;
+}
+
+std::shared_ptr<CookedTexture> LoadOrCookTexture(const std::string &sourcePath, const TextureCookOptions &options) {
+    const std::string cookedPath = GetCookedTexturePath(sourcePath, options);
+
+    auto texture = std::make_shared<CookedTexture>();
+    if (texture->Open(cookedPath, sourcePath, options))
+        return texture;
+
+    if (!CookTexture(sourcePath, cookedPath, options) || !texture->Open(cookedPath, sourcePath, options))
+        return nullptr;
+
+    return texture;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/MappedFile.h"
+
+/// @file TextureCooker.h
+/// @brief Cooked textures: every mip level pre-decoded (optionally BC-compressed) in one mappable file
+///
+/// Nothing here touches GL, so the converter tool links it on its own; TextureManager does the upload.
+
+enum class CookedTextureFormat : uint32_t {
+    R8,
+    RG8,
+    RGB8,
+    RGBA8,
+    BC1,
+    BC3,
+    BC5
+};
+
+enum class TextureCompression {
+    None,
+    /// BC1 for opaque images, BC3 when any pixel has alpha < 255
+    Auto,
+    /// Two-channel BC5 of R and G; only for normal maps whose shader rebuilds Z
+    BC5
+};
+
+struct TextureCookOptions {
+    bool flipVertically = false;
+    TextureCompression compression = TextureCompression::None;
+};
+
+struct CookedMipLevel {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+};
+
+/**
+ * @class CookedTexture
+ * @brief A mapped cooked texture; mip levels point straight into the mapping
+ */
+class CookedTexture {
+    MappedFile file;
+    std::string sourcePath;
+
+    CookedTextureFormat format = CookedTextureFormat::RGBA8;
+    uint32_t channels = 0;
+    std::vector<CookedMipLevel> levels;
+
+public:
+    /// Map @p cookedPath; fails if it is missing, corrupt or not cooked from the current @p sourcePath
+    bool Open(const std::string &cookedPath, const std::string &sourcePath, const TextureCookOptions &options);
+
+    CookedTextureFormat GetFormat() const;
+
+    bool IsCompressed() const;
+
+    /// Channel count of the source image
+    uint32_t GetChannels() const;
+
+    uint32_t GetWidth() const;
+
+    uint32_t GetHeight() const;
+
+    const std::vector<CookedMipLevel> &GetLevels() const;
+
+    size_t GetByteSize() const;
+
+    const std::string &GetSourcePath() const;
+};
+
+void SetTextureCacheDirectory(const std::string &directory);
+
+const std::string &GetTextureCacheDirectory();
+
+std::string GetCookedTexturePath(const std::string &sourcePath, const TextureCookOptions &options);
+
+/// Decode @p sourcePath, build the mip chain, compress if asked and write @p cookedPath
+bool CookTexture(const std::string &sourcePath, const std::string &cookedPath, const TextureCookOptions &options);
+
+/**
+ * @brief Map the cooked file for @p sourcePath, cooking it first when missing or stale
+ *
+ * On-demand cooks honour options.compression like offline ones. Returns nullptr if the
+ * source cannot be decoded or the cache is not writable; callers fall back to decoding.
+ */
+std::shared_ptr<CookedTexture> LoadOrCookTexture(const std::string &sourcePath,
+                                                 const TextureCookOptions &options = {});
\ No newline at end of file
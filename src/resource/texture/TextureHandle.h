@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+class TextureRegistry;
+
+/// Slot + generation into TextureRegistry; a handle goes stale once its texture is deleted
+struct TextureHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return generation != 0; }
+
+    bool operator==(const TextureHandle &) const = default;
+};
+
+/**
+ * @class TextureRef
+ * @brief Counted reference to a registry texture; the GL texture is scheduled for deletion when the last one goes
+ *
+ * Holds the registry itself alive, so a reference may safely outlive the TextureManager.
+ * GetID() reads the slot directly and never takes the registry lock.
+ */
+class TextureRef {
+    std::shared_ptr<TextureRegistry> registry;
+    TextureHandle handle;
+    /// Registry slot publishing generation << 32 | GL id; stable for the registry's lifetime
+    const std::atomic<uint64_t> *slot = nullptr;
+
+public:
+    TextureRef() = default;
+
+    /// Adopts one reference that the registry already counted for this handle
+    TextureRef(std::shared_ptr<TextureRegistry> owner, TextureHandle textureHandle,
+               const std::atomic<uint64_t> *publishedSlot);
+
+    TextureRef(const TextureRef &other);
+
+    TextureRef(TextureRef &&other) noexcept;
+
+    TextureRef &operator=(TextureRef other) noexcept;
+
+    ~TextureRef();
+
+    void Reset();
+
+    bool IsValid() const;
+
+    TextureHandle GetHandle() const;
+
+    /// 0 if empty or already deleted
+    unsigned int GetID() const;
+};
\ No newline at end of file
@@ -1,15 +1,62 @@
 #include "TextureManager.h"
 
+#include <chrono>
+#include <filesystem>
+
+// Not in our glad profile; values from EXT_texture_compression_s3tc
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 TextureManager::~TextureManager() {
     UnloadAll();
 }
 
+TextureRef TextureManager::Acquire(const std::string &path, const TextureSettings &settings) {
+    const std::string key = TextureRegistry::MakeKey(path, settings);
+
+    TextureRef ref = registry->Find(key);
+    if (ref.IsValid())
+        return ref;
+
+    size_t bytes = 0;
+    unsigned int textureID = LoadTextureFromFile(path, settings, bytes);
+    if (textureID == 0)
+        return {};
+
+    return registry->Insert(key, textureID, bytes);
+}
+
+TextureRef TextureManager::FindResident(const std::string &path, const TextureSettings &settings) {
+    return registry->Find(TextureRegistry::MakeKey(path, settings));
+}
+
+TextureRef TextureManager::Adopt(const std::string &path, const TextureSettings &settings, unsigned int id,
+                                 size_t bytes) {
+    if (id == 0)
+        return {};
+
+    return registry->Insert(TextureRegistry::MakeKey(path, settings), id, bytes);
+}
+
+unsigned int TextureManager::GetTextureID(TextureHandle handle) const {
+    return registry->GetID(handle);
+}
+
 unsigned int TextureManager::LoadTexture(const std::string &path, bool gamma) {
-    if (IsLoaded(path))
-        return loadedTextures[path];
-    unsigned int textureID = LoadTextureFromFile(path.c_str(), gamma);
+    (void) gamma;
+
+    auto it = pinned.find(path);
+    if (it != pinned.end() && it->second.IsValid())
+        return it->second.GetID();
+
+    TextureRef ref = Acquire(path);
+    const unsigned int textureID = ref.GetID();
     if (textureID != 0)
-        loadedTextures[path] = textureID;
+        pinned[path] = std::move(ref);
     return textureID;
 }
 
@@ -17,11 +64,15 @@ unsigned int TextureManager::LoadCubemap(const std::vector<std::string> &faces)
     std::string key = "cubemap_";
     for (const auto &face: faces)
         key += face;
-    if (IsLoaded(key))
-        return loadedTextures[key];
-    unsigned int textureID = LoadCubemapFromFiles(faces);
+
+    auto it = pinned.find(key);
+    if (it != pinned.end() && it->second.IsValid())
+        return it->second.GetID();
+
+    size_t bytes = 0;
+    unsigned int textureID = LoadCubemapFromFiles(faces, bytes);
     if (textureID != 0)
-        loadedTextures[key] = textureID;
+        pinned[key] = registry->Insert(key, textureID, bytes);
     return textureID;
 }
 
@@ -45,32 +96,59 @@ void TextureManager::BindTexture(unsigned int textureID, unsigned int slot) {
 }
 
 void TextureManager::UnloadTexture(const std::string &path) {
-    auto it = loadedTextures.find(path);
-    if (it != loadedTextures.end()) {
-        glDeleteTextures(1, &it->second);
-        loadedTextures.erase(it);
-    }
+    // Materials may still reference it; the registry deletes it once they are gone too
+    pinned.erase(path);
 }
 
 void TextureManager::UnloadAll() {
-    for (auto &pair: loadedTextures)
-        glDeleteTextures(1, &pair.second);
-    loadedTextures.clear();
+    pinned.clear();
+
+    for (unsigned int id: registry->TakeAll())
+        glDeleteTextures(1, &id);
 }
 
 bool TextureManager::IsLoaded(const std::string &path) const {
-    return loadedTextures.find(path) != loadedTextures.end();
+    return pinned.contains(path) || registry->Contains(TextureRegistry::MakeKey(path, {}));
 }
 
-unsigned int TextureManager::LoadTextureFromFile(const char *path, bool gamma) {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
+void TextureManager::CollectGarbage() {
+    const std::vector<unsigned int> unused = registry->CollectUnused(DELETE_DELAY_FRAMES);
+    if (unused.empty())
+        return;
+
+    glDeleteTextures(static_cast<GLsizei>(unused.size()), unused.data());
+    Logger::Log(LogLevel::DEBUG, "Deleted " + std::to_string(unused.size()) + " unreferenced textures");
+}
+
+size_t TextureManager::GetResidentCount() const {
+    return registry->GetResidentCount();
+}
+
+size_t TextureManager::GetResidentBytes() const {
+    return registry->GetResidentBytes();
+}
+
+std::shared_ptr<TextureRegistry> TextureManager::GetRegistry() const {
+    return registry;
+}
+
+unsigned int TextureManager::LoadTextureFromFile(const std::string &path, const TextureSettings &settings,
+                                                 size_t &bytes) {
+    TextureCookOptions options;
+    options.flipVertically = settings.flipVertically;
+
+    if (auto cooked = LoadOrCookTexture(path, options)) {
+        if (unsigned int cookedID = UploadCookedTexture(*cooked)) {
+            bytes = cooked->GetByteSize();
+            return cookedID;
+        }
+    }
 
     int width, height, nrComponents;
-    stbi_set_flip_vertically_on_load(true);
-    unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0);
+    stbi_set_flip_vertically_on_load_thread(settings.flipVertically);
+    unsigned char *data = stbi_load(path.c_str(), &width, &height, &nrComponents, 0);
     if (!data) {
-        Logger::Log(LogLevel::ERROR, "Texture failed to load at path: " + std::string(path));
+        Logger::Log(LogLevel::ERROR, "Texture failed to load at path: " + path);
         return 0;
     }
 
@@ -80,6 +158,9 @@ unsigned int TextureManager::LoadTextureFromFile(const char *path, bool gamma) {
     else if (nrComponents == 3) format = GL_RGB;
     else if (nrComponents == 4) format = GL_RGBA;
 
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+
     glBindTexture(GL_TEXTURE_2D, textureID);
     glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
     glGenerateMipmap(GL_TEXTURE_2D);
@@ -90,16 +171,19 @@ unsigned int TextureManager::LoadTextureFromFile(const char *path, bool gamma) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     stbi_image_free(data);
+
+    // Full mip chain adds a third on top of the base level
+    bytes = static_cast<size_t>(width) * height * nrComponents * 4 / 3;
     return textureID;
 }
 
-unsigned int TextureManager::LoadCubemapFromFiles(const std::vector<std::string> &faces) {
+unsigned int TextureManager::LoadCubemapFromFiles(const std::vector<std::string> &faces, size_t &bytes) {
     unsigned int textureID;
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
 
     int width, height, nrComponents;
-    stbi_set_flip_vertically_on_load(false);
+    stbi_set_flip_vertically_on_load_thread(false);
     for (unsigned int i = 0; i < faces.size(); i++) {
         unsigned char *data = stbi_load(faces[i].c_str(), &width, &height, &nrComponents, 0);
         if (data) {
@@ -107,8 +191,10 @@ unsigned int TextureManager::LoadCubemapFromFiles(const std::vector<std::string>
             glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
                          0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
             stbi_image_free(data);
+            bytes += static_cast<size_t>(width) * height * nrComponents;
         } else {
             Logger::Log(LogLevel::ERROR, "Cubemap texture failed to load at path: " + faces[i]);
+            glDeleteTextures(1, &textureID);
             return 0;
         }
     }
@@ -120,4 +206,176 @@ unsigned int TextureManager::LoadCubemapFromFiles(const std::vector<std::string>
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
     return textureID;
+}
+
+namespace {
+    bool IsInternalFormatSupported(GLenum internalFormat) {
+        GLint supported = GL_FALSE;
+        glGetInternalformativ(GL_TEXTURE_2D, internalFormat, GL_INTERNALFORMAT_SUPPORTED, 1, &supported);
+        return supported == GL_TRUE;
+    }
+}
+
+unsigned int UploadCookedTexture(const CookedTexture &texture, GLenum wrap) {
+    const auto &levels = texture.GetLevels();
+    if (levels.empty())
+        return 0;
+
+    GLenum internalFormat = GL_RGBA8;
+    GLenum format = GL_RGBA;
+    switch (texture.GetFormat()) {
+        case CookedTextureFormat::R8:
+            internalFormat = GL_R8;
+            format = GL_RED;
+            break;
+        case CookedTextureFormat::RG8:
+            internalFormat = GL_RG8;
+            format = GL_RG;
+            break;
+        case CookedTextureFormat::RGB8:
+            internalFormat = GL_RGB8;
+            format = GL_RGB;
+            break;
+        case CookedTextureFormat::RGBA8:
+            break;
+        case CookedTextureFormat::BC1:
+            internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            break;
+        case CookedTextureFormat::BC3:
+            internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            break;
+        case CookedTextureFormat::BC5:
+            internalFormat = GL_COMPRESSED_RG_RGTC2;
+            break;
+    }
+
+    if (texture.IsCompressed()) {
+        static const bool s3tc = IsInternalFormatSupported(GL_COMPRESSED_RGB_S3TC_DXT1_EXT) &&
+                                 IsInternalFormatSupported(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+        if (internalFormat != GL_COMPRESSED_RG_RGTC2 && !s3tc) {
+            Logger::Log(LogLevel::WARNING, "S3TC not supported, ignoring cooked " + texture.GetSourcePath());
+            return 0;
+        }
+    }
+
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+
+    glTexStorage2D(GL_TEXTURE_2D, static_cast<GLsizei>(levels.size()), internalFormat,
+                   static_cast<GLsizei>(levels[0].width), static_cast<GLsizei>(levels[0].height));
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (size_t i = 0; i < levels.size(); i++) {
+        const CookedMipLevel &level = levels[i];
+        if (texture.IsCompressed())
+            glCompressedTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), 0, 0,
+                                      static_cast<GLsizei>(level.width), static_cast<GLsizei>(level.height),
+                                      internalFormat, static_cast<GLsizei>(level.size), level.data);
+        else
+            glTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), 0, 0,
+                            static_cast<GLsizei>(level.width), static_cast<GLsizei>(level.height),
+                            format, GL_UNSIGNED_BYTE, level.data);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    return textureID;
+}
+
+void BenchmarkTextureLoading(const std::string &path) {
+    using Clock = std::chrono::high_resolution_clock;
+    constexpr int ITERATIONS = 5;
+
+    auto elapsedMs = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    TextureCookOptions options;
+    options.flipVertically = true;
+    const std::string cookedPath = GetCookedTexturePath(path, options);
+
+    // stb decode + glTexImage2D + glGenerateMipmap, the pre-cook path
+    double decodeMs = 0.0;
+    for (int i = 0; i < ITERATIONS; i++) {
+        auto start = Clock::now();
+
+        int width, height, channels;
+        stbi_set_flip_vertically_on_load_thread(true);
+        unsigned char *data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+        if (!data) {
+            Logger::Log(LogLevel::ERROR, "Texture benchmark: cannot load " + path);
+            return;
+        }
+
+        const GLenum format = channels == 1 ? GL_RED : channels == 2 ? GL_RG : channels == 3 ? GL_RGB : GL_RGBA;
+
+        unsigned int id;
+        glGenTextures(1, &id);
+        glBindTexture(GL_TEXTURE_2D, id);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glFinish();
+        stbi_image_free(data);
+
+        decodeMs += elapsedMs(start);
+        glDeleteTextures(1, &id);
+    }
+
+    auto timeCookedLoad = [&](const std::string &file, const TextureCookOptions &cookOptions) {
+        auto start = Clock::now();
+
+        CookedTexture cooked;
+        unsigned int id = cooked.Open(file, path, cookOptions) ? UploadCookedTexture(cooked) : 0;
+        glFinish();
+
+        const double ms = elapsedMs(start);
+        glDeleteTextures(1, &id);
+        return id != 0 ? ms : -1.0;
+    };
+
+    // First load with no cache entry: decode, build mips, write the file, then map and upload
+    std::error_code ec;
+    std::filesystem::remove(cookedPath, ec);
+
+    auto coldStart = Clock::now();
+    std::shared_ptr<CookedTexture> cold = LoadOrCookTexture(path, options);
+    unsigned int coldID = cold ? UploadCookedTexture(*cold) : 0;
+    glFinish();
+    const double coldMs = elapsedMs(coldStart);
+    glDeleteTextures(1, &coldID);
+    cold.reset();
+
+    double warmMs = 0.0;
+    for (int i = 0; i < ITERATIONS; i++)
+        warmMs += timeCookedLoad(cookedPath, options);
+
+    // BC variant goes to a scratch file so the real cache entry stays uncompressed
+    TextureCookOptions bcOptions = options;
+    bcOptions.compression = TextureCompression::Auto;
+    const std::string bcPath = cookedPath + ".bench";
+
+    auto encodeStart = Clock::now();
+    const bool encoded = CookTexture(path, bcPath, bcOptions);
+    const double encodeMs = elapsedMs(encodeStart);
+
+    double warmBcMs = 0.0;
+    for (int i = 0; encoded && i < ITERATIONS; i++)
+        warmBcMs += timeCookedLoad(bcPath, bcOptions);
+    std::filesystem::remove(bcPath, ec);
+
+    Logger::Log(LogLevel::INFO, "Texture load benchmark: " + path);
+    Logger::Log(LogLevel::INFO, "  stb decode + glGenerateMipmap: " + std::to_string(decodeMs / ITERATIONS) + " ms");
+    Logger::Log(LogLevel::INFO, "  cold (cook + upload):          " + std::to_string(coldMs) + " ms");
+    Logger::Log(LogLevel::INFO, "  warm cooked:                   " + std::to_string(warmMs / ITERATIONS) + " ms");
+    if (encoded)
+        Logger::Log(LogLevel::INFO, "  BC encode (offline):           " + std::to_string(encodeMs) + " ms");
+    Logger::Log(LogLevel::INFO, "  warm cooked BC:                " +
+                                (encoded ? std::to_string(warmBcMs / ITERATIONS) + " ms" : std::string("n/a")));
 }
\ No newline at end of file
@@ -9,15 +9,42 @@
 #include <unordered_map>
 
 #include "core/logging/Logger.h"
+#include "resource/texture/TextureCooker.h"
+#include "resource/texture/TextureRegistry.h"
 
+/**
+ * @class TextureManager
+ * @brief Loads textures into the shared TextureRegistry and deletes the ones nobody references
+ *
+ * Model textures and material textures go through the same registry, so an image
+ * used by both (with the same settings) is decoded and uploaded once.
+ */
 class TextureManager {
-    std::unordered_map<std::string, unsigned int> loadedTextures;
+    std::shared_ptr<TextureRegistry> registry = std::make_shared<TextureRegistry>();
+
+    /// References held on behalf of LoadTexture()/LoadCubemap() callers, which only keep the raw id
+    std::unordered_map<std::string, TextureRef> pinned;
 
 public:
+    /// Unreferenced textures survive this many frames, so a quick re-acquire finds them resident
+    static constexpr uint64_t DELETE_DELAY_FRAMES = 3;
+
     TextureManager() = default;
 
     ~TextureManager();
 
+    /// Counted reference to @p path, loading it on first use
+    TextureRef Acquire(const std::string &path, const TextureSettings &settings = {});
+
+    /// Reference only if the texture is already resident
+    TextureRef FindResident(const std::string &path, const TextureSettings &settings = {});
+
+    /// Register a GL texture uploaded elsewhere (streamed model textures); the registry takes ownership
+    TextureRef Adopt(const std::string &path, const TextureSettings &settings, unsigned int id, size_t bytes);
+
+    unsigned int GetTextureID(TextureHandle handle) const;
+
+    /// Raw id that stays valid until UnloadTexture(@p path) or UnloadAll()
     unsigned int LoadTexture(const std::string &path, bool gamma = false);
 
     unsigned int LoadCubemap(const std::vector<std::string> &faces);
@@ -32,8 +59,33 @@ public:
 
     bool IsLoaded(const std::string &path) const;
 
+    /// Delete textures whose last reference went away DELETE_DELAY_FRAMES ago; once per frame
+    void CollectGarbage();
+
+    size_t GetResidentCount() const;
+
+    /// Estimated GPU memory of resident textures, mip chains included
+    size_t GetResidentBytes() const;
+
+    /// Shared with import workers so they can skip decoding textures that are already resident
+    std::shared_ptr<TextureRegistry> GetRegistry() const;
+
 private:
-    unsigned int LoadTextureFromFile(const char *path, bool gamma = false);
+    unsigned int LoadTextureFromFile(const std::string &path, const TextureSettings &settings, size_t &bytes);
+
+    unsigned int LoadCubemapFromFiles(const std::vector<std::string> &faces, size_t &bytes);
+};
+
+/**
+ * @brief Allocate immutable storage for the whole mip chain and upload each level straight from the mapping
+ * @return 0 if the driver lacks the cooked block format; callers then decode the source instead
+ */
+unsigned int UploadCookedTexture(const CookedTexture &texture, GLenum wrap = GL_REPEAT);
 
-    unsigned int LoadCubemapFromFiles(const std::vector<std::string> &faces);
-};
\ No newline at end of file
+/**
+ * @brief Log load times of @p path: stb decode + glGenerateMipmap, first (cooking) load,
+ *        warm cooked load, and warm load of a BC-compressed cook
+ *
+ * Registered as the "Textures_Benchmark" command.
+ */
+void BenchmarkTextureLoading(const std::string &path);
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "TextureRegistry.h"
+
+#include <filesystem>
+#include <utility>
+
+TextureRef::TextureRef(std::shared_ptr<TextureRegistry> owner, TextureHandle textureHandle,
+                       const std::atomic<uint64_t> *publishedSlot)
+    : registry(std::move(owner)), handle(textureHandle), slot(publishedSlot) {
+}
+
+TextureRef::TextureRef(const TextureRef &other)
+    : registry(other.registry), handle(other.handle), slot(other.slot) {
+    if (registry)
+        registry->AddRef(handle);
+}
+
+TextureRef::TextureRef(TextureRef &&other) noexcept
+    : registry(std::move(other.registry)), handle(std::exchange(other.handle, {})),
+      slot(std::exchange(other.slot, nullptr)) {
+}
+
+TextureRef &TextureRef::operator=(TextureRef other) noexcept {
+    std::swap(registry, other.registry);
+    std::swap(handle, other.handle);
+    std::swap(slot, other.slot);
+    return *this;
+}
+
+TextureRef::~TextureRef() {
+    Reset();
+}
+
+void TextureRef::Reset() {
+    if (registry)
+        registry->Release(handle);
+
+    registry.reset();
+    handle = {};
+    slot = nullptr;
+}
+
+bool TextureRef::IsValid() const {
+    return registry && GetID() != 0;
+}
+
+TextureHandle TextureRef::GetHandle() const {
+    return handle;
+}
+
+unsigned int TextureRef::GetID() const {
+    if (!slot)
+        return 0;
+
+    // A reused slot carries a newer generation, so a stale ref reads 0 rather than someone else's texture
+    const uint64_t published = slot->load(std::memory_order_acquire);
+    return static_cast<uint32_t>(published >> 32) == handle.generation ? static_cast<unsigned int>(published) : 0;
+}
+
+std::string TextureRegistry::MakeKey(const std::string &path, const TextureSettings &settings) {
+    // "a/../b.png", "./b.png" and "b.png" must share one texture
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    std::string key = ec ? std::filesystem::path(path).lexically_normal().generic_string()
+                         : canonical.generic_string();
+
+    if (settings.flipVertically)
+        key += "#flip";
+    return key;
+}
+
+TextureRegistry::Entry *TextureRegistry::Resolve(TextureHandle handle) {
+    if (handle.index >= entries.size())
+        return nullptr;
+
+    Entry &entry = *entries[handle.index];
+    return entry.live && entry.generation == handle.generation ? &entry : nullptr;
+}
+
+const TextureRegistry::Entry *TextureRegistry::Resolve(TextureHandle handle) const {
+    return const_cast<TextureRegistry *>(this)->Resolve(handle);
+}
+
+void TextureRegistry::Remove(uint32_t index) {
+    Entry &entry = *entries[index];
+
+    lookup.erase(entry.key);
+    residentCount--;
+    residentBytes -= entry.bytes;
+
+    entry.key.clear();
+    entry.id = 0;
+    entry.live = false;
+    entry.generation++;
+    entry.published.store(0, std::memory_order_release);
+    freeSlots.push_back(index);
+}
+
+TextureRef TextureRegistry::MakeRef(uint32_t index, Entry &entry) {
+    return TextureRef(shared_from_this(), {index, entry.generation}, &entry.published);
+}
+
+TextureRef TextureRegistry::Find(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = lookup.find(key);
+    if (it == lookup.end())
+        return {};
+
+    Entry &entry = *entries[it->second];
+    entry.refCount++;
+    return MakeRef(it->second, entry);
+}
+
+bool TextureRegistry::Contains(const std::string &key) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lookup.contains(key);
+}
+
+TextureRef TextureRegistry::Insert(const std::string &key, unsigned int id, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = lookup.find(key);
+    if (it != lookup.end()) {
+        orphanIds.push_back(id);
+
+        Entry &existing = *entries[it->second];
+        existing.refCount++;
+        return MakeRef(it->second, existing);
+    }
+
+    uint32_t index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        index = static_cast<uint32_t>(entries.size());
+        entries.push_back(std::make_unique<Entry>());
+    }
+
+    Entry &entry = *entries[index];
+    entry.key = key;
+    entry.id = id;
+    entry.bytes = bytes;
+    entry.refCount = 1;
+    entry.live = true;
+    entry.published.store(static_cast<uint64_t>(entry.generation) << 32 | id, std::memory_order_release);
+
+    lookup[key] = index;
+    residentCount++;
+    residentBytes += bytes;
+
+    return MakeRef(index, entry);
+}
+
+void TextureRegistry::AddRef(TextureHandle handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (Entry *entry = Resolve(handle))
+        entry->refCount++;
+}
+
+void TextureRegistry::Release(TextureHandle handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Entry *entry = Resolve(handle);
+    if (!entry || entry->refCount == 0)
+        return;
+
+    if (--entry->refCount == 0)
+        entry->releasedFrame = frame;
+}
+
+unsigned int TextureRegistry::GetID(TextureHandle handle) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const Entry *entry = Resolve(handle);
+    return entry ? entry->id : 0;
+}
+
+std::vector<unsigned int> TextureRegistry::CollectUnused(uint64_t delay) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    frame++;
+
+    std::vector<unsigned int> ids = std::move(orphanIds);
+    orphanIds.clear();
+
+    for (uint32_t i = 0; i < entries.size(); i++) {
+        Entry &entry = *entries[i];
+        if (entry.live && entry.refCount == 0 && frame - entry.releasedFrame >= delay) {
+            ids.push_back(entry.id);
+            Remove(i);
+        }
+    }
+
+    return ids;
+}
+
+std::vector<unsigned int> TextureRegistry::TakeAll() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<unsigned int> ids = std::move(orphanIds);
+    orphanIds.clear();
+
+    for (uint32_t i = 0; i < entries.size(); i++) {
+        if (entries[i]->live) {
+            ids.push_back(entries[i]->id);
+            Remove(i);
+        }
+    }
+
+    return ids;
+}
+
+size_t TextureRegistry::GetResidentCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return residentCount;
+}
+
+size_t TextureRegistry::GetResidentBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return residentBytes;
+}
\ No newline at end of file
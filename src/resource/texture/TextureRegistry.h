@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "resource/texture/TextureHandle.h"
+
+/// Import settings that produce a different GL texture from the same file
+struct TextureSettings {
+    bool flipVertically = true;
+};
+
+/**
+ * @class TextureRegistry
+ * @brief Reference-counted table of GL textures keyed by canonical path + settings
+ *
+ * Bookkeeping only: it never calls GL. Textures whose count drops to zero stay
+ * resident (and can be picked up again) until TextureManager collects them a few
+ * frames later. Thread-safe, so import workers can ask what is already resident.
+ */
+class TextureRegistry : public std::enable_shared_from_this<TextureRegistry> {
+    struct Entry {
+        std::string key;
+        unsigned int id = 0;
+        size_t bytes = 0;
+        uint32_t refCount = 0;
+        uint32_t generation = 1;
+        uint64_t releasedFrame = 0;
+        bool live = false;
+        /// generation << 32 | id, or 0 once removed; the only field read without the mutex
+        std::atomic<uint64_t> published{0};
+    };
+
+    mutable std::mutex mutex;
+    /// Boxed so TextureRefs can keep pointing at a slot while the table grows
+    std::vector<std::unique_ptr<Entry> > entries;
+    std::vector<uint32_t> freeSlots;
+    std::unordered_map<std::string, uint32_t> lookup;
+    /// Duplicates from racing Insert() calls, deleted on the next collection
+    std::vector<unsigned int> orphanIds;
+
+    uint64_t frame = 0;
+    size_t residentCount = 0;
+    size_t residentBytes = 0;
+
+    Entry *Resolve(TextureHandle handle);
+
+    const Entry *Resolve(TextureHandle handle) const;
+
+    void Remove(uint32_t index);
+
+    TextureRef MakeRef(uint32_t index, Entry &entry);
+
+public:
+    static std::string MakeKey(const std::string &path, const TextureSettings &settings);
+
+    /// Reference to the resident texture for @p key, or an empty ref
+    TextureRef Find(const std::string &key);
+
+    bool Contains(const std::string &key) const;
+
+    /**
+     * @brief Take ownership of GL texture @p id under @p key
+     *
+     * If another texture was registered under the key meanwhile, that one is returned
+     * and @p id is queued for deletion.
+     */
+    TextureRef Insert(const std::string &key, unsigned int id, size_t bytes);
+
+    void AddRef(TextureHandle handle);
+
+    void Release(TextureHandle handle);
+
+    unsigned int GetID(TextureHandle handle) const;
+
+    /// Advance the frame counter and remove unreferenced textures released at least @p delay frames ago
+    std::vector<unsigned int> CollectUnused(uint64_t delay);
+
+    /// Remove everything regardless of references; existing handles go stale
+    std::vector<unsigned int> TakeAll();
+
+    size_t GetResidentCount() const;
+
+    size_t GetResidentBytes() const;
+};
\ No newline at end of file
@@ -3,18 +3,21 @@
 Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices,
            std::vector<Texture> textures) {
     meshRenderer = std::make_unique<MeshRenderer>(vertices, indices);
+    bounds = meshRenderer->GetBounds();
 }
 
 Mesh::Mesh(MeshRenderer *rendererPtr, Material *materialPtr) {
     meshRenderer = std::unique_ptr<MeshRenderer>(rendererPtr);
+    if (meshRenderer)
+        bounds = meshRenderer->GetBounds();
     (void) materialPtr;
 }
 
-void Mesh::Draw(ShaderManager &shaderManager, const std::string &name) {
+void Mesh::Draw(ShaderManager &shaderManager, const std::string &name, MaterialBuffer &materialBuffer) {
     if (!meshRenderer) return;
 
     if (material) {
-        material->Bind(shaderManager, name);
+        material->Bind(shaderManager, name, materialBuffer);
         meshRenderer->Draw();
         material->Unbind();
     } else {
@@ -22,16 +25,16 @@ void Mesh::Draw(ShaderManager &shaderManager, const std::string &name) {
     }
 }
 
-void Mesh::Draw(ShaderManager &shaderManager, const std::string &name,
+void Mesh::Draw(ShaderManager &shaderManager, const std::string &name, MaterialBuffer &materialBuffer,
                 std::shared_ptr<Material> externalMaterial) {
     if (!meshRenderer) return;
 
     if (externalMaterial) {
-        externalMaterial->Bind(shaderManager, name);
+        externalMaterial->Bind(shaderManager, name, materialBuffer);
         meshRenderer->Draw();
         externalMaterial->Unbind();
     } else if (material) {
-        material->Bind(shaderManager, name);
+        material->Bind(shaderManager, name, materialBuffer);
         meshRenderer->Draw();
         material->Unbind();
     } else {
@@ -44,6 +47,13 @@ void Mesh::DrawDepthOnly() {
         meshRenderer->Draw();
 }
 
+void Mesh::DrawDepthOnlyInstanced(GLContext &context, GLsizei instanceCount) {
+    if (!meshRenderer)
+        return;
+    meshRenderer->Bind(context);
+    meshRenderer->DrawInstanced(context, instanceCount, 0);
+}
+
 // --- split_headers: auto-generated ---
 
 void Mesh::SetColor(const glm::vec3 &color) {
@@ -74,4 +84,12 @@ MeshRenderer *Mesh::GetMeshRenderer() {
 
 std::shared_ptr<Material> Mesh::GetMaterial() {
     return material;
+}
+
+uint32_t Mesh::GetID() const {
+    return id;
+}
+
+const MeshBounds &Mesh::GetBounds() const {
+    return bounds;
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <cstdint>
 
 #include "resource/shader/ShaderManager.h"
 #include "resource/material/Material.h"
@@ -16,6 +17,15 @@ private:
     std::unique_ptr<MeshRenderer> meshRenderer;
     std::shared_ptr<Material> material;
 
+    uint32_t id = NextID();
+
+    MeshBounds bounds;
+
+    static uint32_t NextID() {
+        static uint32_t counter = 1;
+        return counter++;
+    }
+
 public:
     Mesh(std::vector<Vertex> vertices,
          std::vector<unsigned int> indices,
@@ -23,14 +33,18 @@ public:
 
     Mesh(MeshRenderer *rendererPtr, Material *materialPtr);
 
-    void Draw(ShaderManager &shaderManager, const std::string &name);
+    void Draw(ShaderManager &shaderManager, const std::string &name, MaterialBuffer &materialBuffer);
 
     void Draw(ShaderManager &shaderManager,
               const std::string &name,
+              MaterialBuffer &materialBuffer,
               std::shared_ptr<Material> externalMaterial);
 
     void DrawDepthOnly();
 
+    /// Leaves the mesh's VAO bound through the context; the caller unbinds when done
+    void DrawDepthOnlyInstanced(GLContext &context, GLsizei instanceCount);
+
     void SetColor(const glm::vec3 &color);
 
 
@@ -45,4 +59,9 @@ public:
     MeshRenderer *GetMeshRenderer();
 
     std::shared_ptr<Material> GetMaterial();
+
+    uint32_t GetID() const;
+
+    /// Local-space bounds, captured when the mesh was built
+    const MeshBounds &GetBounds() const;
 };
\ No newline at end of file
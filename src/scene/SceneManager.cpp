@@ -1,6 +1,5 @@
 #include "SceneManager.h"
 #include <entt/entt.hpp>
-#include <any>
 #include "core/logging/Logger.h"
 #include "core/CommandManager.h"
 #include "core/EventBus.h"
@@ -42,7 +41,7 @@ void SceneManager::StartPlayMode() {
 
     m_IsPlayMode = true;
 
-    GetEventBus().Publish("play_mode_started");
+    GetEventBus().Publish(PlayModeStartedEvent{});
 
     Logger::Log(LogLevel::INFO, "SceneManager: Entered Play Mode");
     */
@@ -66,6 +65,7 @@ void SceneManager::StopPlayMode() {
         auto& orientation = m_ecs->GetComponent<CameraOrientationComponent>(editorCam);
 
         transform.position = m_SavedEditorCameraPos;
+        m_ecs->MarkTransformDirty(editorCam);
         orientation.yaw = m_SavedEditorCameraYaw;
         orientation.pitch = m_SavedEditorCameraPitch;
     }
@@ -93,7 +93,7 @@ void SceneManager::StopPlayMode() {
 
     m_IsPlayMode = false;
 
-    GetEventBus().Publish("play_mode_stopped");
+    GetEventBus().Publish(PlayModeStoppedEvent{});
 
     Logger::Log(LogLevel::INFO, "SceneManager: Exited Play Mode");
     */
@@ -122,7 +122,7 @@ void SceneManager::PauseScripts() {
     });
 
     m_IsDebugPaused = true;
-    GetEventBus().Publish("debug_paused");
+    GetEventBus().Publish(DebugPausedEvent{});
     Logger::Log(LogLevel::INFO, "SceneManager: Scripts PAUSED (debug)");
 }
 
@@ -138,6 +138,7 @@ void SceneManager::ResumeScripts() {
             auto &orientation = m_ecs->GetComponent<CameraOrientationComponent>(gameCam);
 
             transform.position = m_SavedDebugCameraPos;
+            m_ecs->MarkTransformDirty(gameCam);
             orientation.yaw = m_SavedDebugCameraYaw;
             orientation.pitch = m_SavedDebugCameraPitch;
 
@@ -152,7 +153,7 @@ void SceneManager::ResumeScripts() {
     });
 
     m_IsDebugPaused = false;
-    GetEventBus().Publish("debug_resumed");
+    GetEventBus().Publish(DebugResumedEvent{});
     Logger::Log(LogLevel::INFO, "SceneManager: Scripts RESUMED");
 }
 
@@ -189,11 +190,9 @@ void SceneManager::RegisterSceneCommands() {
 }
 
 void SceneManager::RegisterDebugEvents() {
-    GetEventBus().Subscribe("debug_pause",
-                            [this](const std::any &) { PauseScripts(); });
+    GetEventBus().Subscribe<DebugPauseRequest>([this](const DebugPauseRequest &) { PauseScripts(); });
 
-    GetEventBus().Subscribe("debug_resume",
-                            [this](const std::any &) { ResumeScripts(); });
+    GetEventBus().Subscribe<DebugResumeRequest>([this](const DebugResumeRequest &) { ResumeScripts(); });
 
     CommandManager::RegisterCommand("onDebugPauseToggle",
                                     [this](const CommandArgs &) {
@@ -8,6 +8,19 @@
 #include "ECS/World.h"
 #include "ECS/components/Components.h"
 
+/// Scene events on GetEventBus(); the *Request ones ask the SceneManager to act
+struct PlayModeStartedEvent {};
+
+struct PlayModeStoppedEvent {};
+
+struct DebugPausedEvent {};
+
+struct DebugResumedEvent {};
+
+struct DebugPauseRequest {};
+
+struct DebugResumeRequest {};
+
 class SceneManager {
     ECSWorld *m_ecs;
     bool m_IsPlayMode = false;
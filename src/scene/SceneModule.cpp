@@ -45,6 +45,11 @@ bool SceneModule::IsRequired() const {
     return true;
 }
 
+ModuleAccess SceneModule::GetAccess() const {
+    // Scene load/save/play are command-driven
+    return {};
+}
+
 SceneSerializer *SceneModule::GetSceneSerializer() {
     return m_Serializer.get();
 }
@@ -29,6 +29,8 @@ public:
 
     bool IsRequired() const override;
 
+    ModuleAccess GetAccess() const override;
+
     /// @}
 
     SceneSerializer *GetSceneSerializer();
@@ -56,7 +56,7 @@ void ModelSerializer::ApplyTransform(ECSWorld *world, entt::entity entity, const
     glm::vec3 eulerDeg(t["rotation"][0], t["rotation"][1], t["rotation"][2]);
     glm::quat rot = glm::quat(glm::radians(eulerDeg));
     glm::vec3 scl = {t["scale"][0], t["scale"][1], t["scale"][2]};
-    world->GetComponent<TransformComponent>(entity) = {pos, rot, scl};
+    world->GetRegistry().replace<TransformComponent>(entity, pos, rot, scl);
 }
 
 void ModelSerializer::ApplyScript(ECSWorld *world, entt::entity entity, const json &entityData) {
@@ -7,7 +7,7 @@ void ASRegisterAPI::RegisterAll(ECSWorld *ecs, Input *input, AudioSystem *audioS
     RegisterStdString(engine);
 
     RegisterTypes(engine);
-    RegisterCommands(ecs);
+    RegisterTriggerEvents(ecs);
     RegisterECS(engine, ecs);
     RegisterInput(engine, input);
     RegisterMath(engine);
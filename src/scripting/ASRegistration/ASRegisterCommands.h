@@ -8,14 +8,16 @@
 
 #define AS_CHECK(r, msg) if ((r) < 0) { Logger::Log(LogLevel::ERROR, std::string("AS Register failed: ") + msg + " code: " + std::to_string(r)); return; }
 
-#include "core/CommandManager.h"
+#include "core/EventBus.h"
 #include "ECS/World.h"
 #include "ECS/components/Components.h"
+#include "ECS/systems/PhysicsSystem.h"
 
 inline void DispatchTrigger(ECSWorld *ecs, const std::string &fnDecl,
                      entt::entity a, entt::entity b) {
     auto tryCall = [&](entt::entity self, entt::entity other) {
-        if (!ecs->HasComponent<ScriptComponent>(self)) return;
+        // Delivered a frame after the overlap, so either side may be gone by now
+        if (!ecs->IsValid(self) || !ecs->HasComponent<ScriptComponent>(self)) return;
         auto &script = ecs->GetComponent<ScriptComponent>(self);
         if (!script.loaded || !script.ctx || !script.module) return;
 
@@ -31,18 +33,11 @@ inline void DispatchTrigger(ECSWorld *ecs, const std::string &fnDecl,
     tryCall(b, a);
 }
 
-inline void RegisterCommands(ECSWorld *ecs) {
-    CommandManager::RegisterCommand("OnTriggerEnter",
-                                    [ecs](const CommandArgs &args) {
-                                        entt::entity a = std::get<entt::entity>(args[0]);
-                                        entt::entity b = std::get<entt::entity>(args[1]);
-                                        DispatchTrigger(ecs, "void OnTriggerEnter(uint64)", a, b);
-                                    });
-
-    CommandManager::RegisterCommand("OnTriggerExit",
-                                    [ecs](const CommandArgs &args) {
-                                        entt::entity a = std::get<entt::entity>(args[0]);
-                                        entt::entity b = std::get<entt::entity>(args[1]);
-                                        DispatchTrigger(ecs, "void OnTriggerExit(uint64)", a, b);
-                                    });
+inline void RegisterTriggerEvents(ECSWorld *ecs) {
+    GetEventBus().Subscribe<TriggerEnterEvent>([ecs](const TriggerEnterEvent &event) {
+        DispatchTrigger(ecs, "void OnTriggerEnter(uint64)", event.a, event.b);
+    });
+    GetEventBus().Subscribe<TriggerExitEvent>([ecs](const TriggerExitEvent &event) {
+        DispatchTrigger(ecs, "void OnTriggerExit(uint64)", event.a, event.b);
+    });
 }
\ No newline at end of file
@@ -14,6 +14,8 @@
 inline TransformComponent *GetTransform(ECSWorld *ecs, entt::entity e) {
     if (!ecs->HasComponent<TransformComponent>(e))
         return nullptr;
+    // Scripts write the handle's properties directly, so fetching it counts as an edit
+    ecs->MarkTransformDirty(e);
     return &ecs->GetComponent<TransformComponent>(e);
 }
 
@@ -0,0 +1,218 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "core/JobSystem.h"
+#include "ECS/ParallelGroup.h"
+
+namespace {
+    int g_Failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_Failures++; \
+        } \
+    } while (0)
+
+    void TestDependencyContinuation() {
+        JobSystem jobs;
+        jobs.Initialize(3);
+
+        std::atomic<int> firstDone{0};
+        std::atomic<bool> orderKept{true};
+        std::atomic<int> secondDone{0};
+
+        JobCounter first;
+        JobCounter second;
+        for (int i = 0; i < 64; i++)
+            jobs.Schedule([&firstDone] {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                firstDone.fetch_add(1);
+            }, &first);
+
+        for (int i = 0; i < 16; i++)
+            jobs.Schedule([&] {
+                if (firstDone.load() != 64)
+                    orderKept = false;
+                secondDone.fetch_add(1);
+            }, &second, &first);
+
+        // Scheduled after its dependency already finished: must still run
+        jobs.Wait(first);
+        JobCounter late;
+        std::atomic<bool> lateRan{false};
+        jobs.Schedule([&lateRan] { lateRan = true; }, &late, &first);
+
+        jobs.Wait(second);
+        jobs.Wait(late);
+
+        CHECK(firstDone.load() == 64);
+        CHECK(secondDone.load() == 16);
+        CHECK(orderKept.load());
+        CHECK(lateRan.load());
+        CHECK(first.IsDone() && second.IsDone() && late.IsDone());
+    }
+
+    void TestWaitHelpsWithoutDeadlock() {
+        // One worker: every job below waits on children, which only finish if waiters help
+        JobSystem jobs;
+        jobs.Initialize(1);
+
+        std::atomic<int> leaves{0};
+        JobCounter parents;
+        for (int p = 0; p < 8; p++)
+            jobs.Schedule([&jobs, &leaves] {
+                JobCounter children;
+                for (int c = 0; c < 8; c++)
+                    jobs.Schedule([&leaves] { leaves.fetch_add(1); }, &children);
+                jobs.Wait(children);
+            }, &parents);
+
+        jobs.Wait(parents);
+        CHECK(leaves.load() == 64);
+    }
+
+    void TestNestedParallelFor() {
+        JobSystem jobs;
+        jobs.Initialize(3);
+
+        constexpr size_t OUTER = 8;
+        constexpr size_t INNER = 10000;
+        std::vector<std::vector<int> > data(OUTER, std::vector<int>(INNER, 0));
+
+        JobCounter counter;
+        for (size_t o = 0; o < OUTER; o++)
+            jobs.Schedule([&jobs, &data, o] {
+                jobs.ParallelFor(INNER, 64, [&data, o](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++)
+                        data[o][i] += static_cast<int>(i);
+                });
+            }, &counter);
+        jobs.Wait(counter);
+
+        const long long expected = static_cast<long long>(INNER) * (INNER - 1) / 2;
+        for (const auto &row: data)
+            CHECK(std::accumulate(row.begin(), row.end(), 0LL) == expected);
+    }
+
+    void TestStealingUnderImbalance() {
+        JobSystem jobs;
+        jobs.Initialize(3);
+
+        std::mutex threadsMutex;
+        std::set<std::thread::id> threads;
+        std::atomic<int> ran{0};
+
+        // Every job is pushed onto the single deque of whichever thread runs the producer
+        JobCounter producer;
+        JobCounter work;
+        jobs.Schedule([&] {
+            for (int i = 0; i < 64; i++)
+                jobs.Schedule([&] {
+                    {
+                        std::lock_guard<std::mutex> lock(threadsMutex);
+                        threads.insert(std::this_thread::get_id());
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    ran.fetch_add(1);
+                }, &work);
+        }, &producer);
+
+        jobs.Wait(producer);
+        jobs.Wait(work);
+
+        CHECK(ran.load() == 64);
+        CHECK(threads.size() > 1);
+    }
+
+    void TestShutdownDrainsPendingJobs() {
+        JobSystem jobs;
+        jobs.Initialize(2);
+
+        std::atomic<int> ran{0};
+        std::atomic<int> backgroundRan{0};
+        JobCounter first;
+
+        for (int i = 0; i < 256; i++)
+            jobs.Schedule([&ran] { ran.fetch_add(1); }, &first);
+        for (int i = 0; i < 32; i++)
+            jobs.Schedule([&ran] { ran.fetch_add(1); }, nullptr, &first);
+        for (int i = 0; i < 4; i++)
+            jobs.ScheduleBackground([&backgroundRan] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                backgroundRan.fetch_add(1);
+            });
+
+        jobs.Shutdown();
+
+        CHECK(ran.load() == 288);
+        CHECK(backgroundRan.load() == 4);
+        CHECK(!jobs.IsRunning());
+
+        // After shutdown jobs run inline
+        bool inlineRan = false;
+        jobs.Schedule([&inlineRan] { inlineRan = true; });
+        CHECK(inlineRan);
+    }
+
+    struct Position {
+        int value = 0;
+    };
+
+    struct Body {
+        int id = 0;
+    };
+
+    void TestParallelGroupUnevenPools() {
+        JobSystem jobs;
+        jobs.Initialize(3);
+
+        // Like the physics group: far more positions than bodies, and positions emplaced first
+        entt::registry registry;
+        auto group = registry.group<Position, Body>();
+
+        std::vector<entt::entity> withBody;
+        for (int i = 0; i < 1000; i++) {
+            const entt::entity entity = registry.create();
+            registry.emplace<Position>(entity, -1);
+            if (i % 7 == 3) {
+                registry.emplace<Body>(entity, static_cast<int>(entity));
+                withBody.push_back(entity);
+            }
+        }
+        CHECK(group.size() == withBody.size());
+
+        std::atomic<int> mismatched{0};
+        ParallelOwnedEach<Position, Body>(jobs, group, [&mismatched](entt::entity entity, Position &p, Body &b) {
+            if (b.id != static_cast<int>(entity))
+                mismatched.fetch_add(1);
+            p.value = b.id;
+        }, 8);
+
+        CHECK(mismatched.load() == 0);
+        for (auto [entity, position]: registry.view<Position>().each()) {
+            const bool owned = registry.all_of<Body>(entity);
+            CHECK(position.value == (owned ? static_cast<int>(entity) : -1));
+        }
+    }
+}
+
+int main() {
+    TestDependencyContinuation();
+    TestWaitHelpsWithoutDeadlock();
+    TestNestedParallelFor();
+    TestStealingUnderImbalance();
+    TestShutdownDrainsPendingJobs();
+    TestParallelGroupUnevenPools();
+
+    if (g_Failures == 0)
+        std::printf("JobSystem tests passed\n");
+    return g_Failures == 0 ? 0 : 1;
+}
\ No newline at end of file
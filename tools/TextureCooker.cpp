@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <print>
+#include <string>
+#include <vector>
+
+#include "core/logging/Logger.h"
+#include "core/logging/ConsoleLogger.h"
+#include "resource/texture/TextureCooker.h"
+
+/// @file TextureCooker.cpp
+/// @brief Offline converter: cooks images (or every image under a directory) into the engine's texture cache
+///
+/// Cooked files are keyed by the path as given, so run it from the engine's working directory
+/// (the build directory, where assets/ is copied) with paths like assets/objects/backpack.
+
+namespace fs = std::filesystem;
+
+namespace {
+    void PrintUsage() {
+        std::println("Usage: TextureCooker [--bc | --bc5] [--flip] [--out <cache dir>] <image or directory>...");
+        std::println("  --bc    BC1 for opaque images, BC3 for images with alpha");
+        std::println("  --bc5   BC5 (red/green only, for normal maps with Z rebuilt in the shader)");
+        std::println("  --flip  cook flipped, as TextureManager loads; model textures are not flipped");
+        std::println("  --out   cache directory (default: cache/textures)");
+    }
+
+    bool IsImage(const fs::path &path) {
+        static const std::vector<std::string> extensions = {".png", ".jpg", ".jpeg", ".tga", ".bmp", ".psd", ".hdr"};
+
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        return std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+    }
+}
+
+int main(int argc, char **argv) {
+    ConsoleLogger console;
+    Logger::AddSink(&console);
+
+    TextureCookOptions options;
+    std::vector<fs::path> inputs;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+
+        if (arg == "--bc")
+            options.compression = TextureCompression::Auto;
+        else if (arg == "--bc5")
+            options.compression = TextureCompression::BC5;
+        else if (arg == "--flip")
+            options.flipVertically = true;
+        else if (arg == "--out" && i + 1 < argc)
+            SetTextureCacheDirectory(argv[++i]);
+        else if (arg == "-h" || arg == "--help") {
+            PrintUsage();
+            return 0;
+        } else
+            inputs.emplace_back(arg);
+    }
+
+    if (inputs.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<std::string> images;
+    for (const fs::path &input: inputs) {
+        std::error_code ec;
+        if (fs::is_directory(input, ec)) {
+            for (const auto &entry: fs::recursive_directory_iterator(input, ec))
+                if (entry.is_regular_file() && IsImage(entry.path()))
+                    images.push_back(entry.path().generic_string());
+        } else {
+            images.push_back(input.generic_string());
+        }
+    }
+
+    size_t failed = 0;
+    for (const std::string &image: images)
+        if (!CookTexture(image, GetCookedTexturePath(image, options), options))
+            failed++;
+
+    std::println("{} cooked, {} failed", images.size() - failed, failed);
+
+    Logger::RemoveSink(&console);
+    return failed == 0 ? 0 : 1;
+}
\ No newline at end of file